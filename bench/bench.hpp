@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define BENCH_NOINLINE __declspec(noinline)
+#else
+#define BENCH_NOINLINE __attribute__((noinline))
+#endif
+
+///Minimal benchmark harness.
+///
+///Each benchmark is reported as single line of JSON:
+///
+///`{"group":"chain","name":"result/map","args":{"len":4},"iterations":1048576,"ns_per_op":1.25,"allocs_per_op":0}`
+namespace bench {
+    ///Number of calls to global operator new, maintained by main.cpp
+    std::uint64_t allocations() noexcept;
+
+    ///Prevents compiler from optimizing out value.
+    template<class T>
+    inline void do_not_optimize(T&& value) noexcept {
+#if defined(_MSC_VER)
+        static volatile const void* sink;
+        sink = &value;
+#else
+        asm volatile("" : : "r,m"(value) : "memory");
+#endif
+    }
+
+    ///Forces compiler to assume that memory is modified.
+    inline void clobber() noexcept {
+#if defined(_MSC_VER)
+        static volatile int sink;
+        sink = 0;
+#else
+        asm volatile("" : : : "memory");
+#endif
+    }
+
+    ///Named integer argument of benchmark case.
+    using Arg = std::pair<const char*, long long>;
+    using Args = std::vector<Arg>;
+
+    ///Benchmark body, which must perform `iterations` operations.
+    using Fn = std::function<void(std::size_t iterations)>;
+
+    struct Case {
+        std::string group;
+        std::string name;
+        Args args;
+        Fn fn;
+    };
+
+    ///Case that is not timed, but reports its own metrics, e.g. memory footprint.
+    struct Report {
+        std::string group;
+        std::function<void()> fn;
+    };
+
+    std::vector<Case>& registry();
+    std::vector<Report>& reports();
+
+    ///Adds benchmark case.
+    inline void add(std::string group, std::string name, Args args, Fn fn) {
+        registry().push_back(Case{std::move(group), std::move(name), std::move(args), std::move(fn)});
+    }
+
+    ///Registers benchmarks on static initialization.
+    struct Register {
+        explicit Register(void (*init)()) {
+            init();
+        }
+
+        Register(std::string group, std::string name, Args args, Fn fn) {
+            add(std::move(group), std::move(name), std::move(args), std::move(fn));
+        }
+    };
+
+    ///Registers untimed report on static initialization.
+    struct RegisterReport {
+        RegisterReport(std::string group, std::function<void()> fn) {
+            reports().push_back(Report{std::move(group), std::move(fn)});
+        }
+    };
+
+    ///Prints metrics of untimed case.
+    void report(const std::string& group, const std::string& name, const Args& args, const Args& metrics);
+
+    ///Mask to index sequence returned by failures().
+    constexpr std::size_t failures_mask = 1023;
+
+    ///Deterministic pseudo-random sequence of outcomes with given percent of failures.
+    inline std::vector<unsigned char> failures(unsigned percent, std::size_t len = failures_mask + 1) {
+        std::vector<unsigned char> result(len);
+        std::uint32_t state = 2463534242u;
+
+        for (std::size_t idx = 0; idx < len; idx++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            result[idx] = (state % 100) < percent ? 1 : 0;
+        }
+
+        return result;
+    }
+}
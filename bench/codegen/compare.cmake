@@ -0,0 +1,116 @@
+# Compares machine code of each `result_<case>` function against `baseline_<case>`.
+#
+# Usage: cmake -DOBJDUMP=<objdump> -DOBJECT=<functions.o> -P compare.cmake
+#
+# Object must be compiled with -fstack-usage, which writes its stack usage next to it.
+# Fails when Result version has more instructions, uses more stack or makes more calls than baseline.
+cmake_minimum_required(VERSION 3.5)
+
+foreach(required OBJDUMP OBJECT)
+    if (NOT DEFINED ${required})
+        message(FATAL_ERROR "${required} is not set")
+    endif()
+endforeach()
+
+execute_process(
+    COMMAND ${OBJDUMP} -d -r -C --no-show-raw-insn ${OBJECT}
+    OUTPUT_VARIABLE disassembly
+    RESULT_VARIABLE objdump_status
+)
+if (NOT objdump_status EQUAL 0)
+    message(FATAL_ERROR "${OBJDUMP} failed on ${OBJECT}")
+endif()
+
+string(REGEX REPLACE "\\.(o|obj)$" ".su" stack_file "${OBJECT}")
+if (NOT EXISTS "${stack_file}")
+    message(FATAL_ERROR "Stack usage ${stack_file} is not found, is object compiled with -fstack-usage?")
+endif()
+file(STRINGS "${stack_file}" stack_lines)
+
+# Walks disassembly once, counting instructions and calls of each function.
+# Alignment padding is not counted, tail jump to other function is counted as call.
+# Brackets are replaced, as unbalanced ones would join list items.
+string(REPLACE ";" "\\;" disassembly "${disassembly}")
+string(REPLACE "[" "(" disassembly "${disassembly}")
+string(REPLACE "]" ")" disassembly "${disassembly}")
+string(REPLACE "\n" ";" disassembly "${disassembly}")
+set(cases "")
+set(function "")
+set(last_mnemonic "")
+foreach(line IN LISTS disassembly)
+    if (line MATCHES "^[0-9a-fA-F]+ <([A-Za-z0-9_]+)(\\(.*\\))?>:$")
+        set(function "${CMAKE_MATCH_1}")
+        set(${function}_instructions 0)
+        set(${function}_calls 0)
+        if (function MATCHES "^result_(.+)$")
+            list(APPEND cases "${CMAKE_MATCH_1}")
+        endif()
+    elseif (function STREQUAL "")
+    elseif (line MATCHES "^[ \t]*[0-9a-fA-F]+:[ \t]+R_")
+        if (last_mnemonic MATCHES "^(jmp|jmpq|b)$")
+            math(EXPR ${function}_calls "${${function}_calls} + 1")
+        endif()
+    elseif (line MATCHES "^[ \t]*[0-9a-fA-F]+:[ \t]+(.+)$")
+        string(STRIP "${CMAKE_MATCH_1}" instruction)
+        string(REGEX REPLACE "^((data16|cs|rex|rex\\.W)[ \t]+)+" "" instruction "${instruction}")
+        string(REGEX MATCH "^[a-z0-9.]+" last_mnemonic "${instruction}")
+        if (NOT instruction MATCHES "^(nop|xchg[ \t]+%ax,[ \t]*%ax|int3|\\(bad\\))")
+            math(EXPR ${function}_instructions "${${function}_instructions} + 1")
+        endif()
+        if (last_mnemonic MATCHES "^(call|callq|bl|blr)$")
+            math(EXPR ${function}_calls "${${function}_calls} + 1")
+        endif()
+    endif()
+endforeach()
+
+# GCC names function by its signature and Clang by mangled name.
+function(stack_usage name out)
+    foreach(line IN LISTS stack_lines)
+        if (line MATCHES "[^A-Za-z0-9_]${name}(\\(.*\\))?\t([0-9]+)\t")
+            set(${out} "${CMAKE_MATCH_2}" PARENT_SCOPE)
+            return()
+        elseif (line MATCHES "_Z[0-9]+${name}[^A-Za-z0-9_\t][^\t]*\t([0-9]+)\t")
+            set(${out} "${CMAKE_MATCH_1}" PARENT_SCOPE)
+            return()
+        endif()
+    endforeach()
+    message(FATAL_ERROR "No stack usage of ${name} in ${stack_file}")
+endfunction()
+
+if (cases STREQUAL "")
+    message(FATAL_ERROR "No result_<case> functions in ${OBJECT}")
+endif()
+
+set(failed "")
+message(STATUS "case: instructions, stack bytes, calls of Result / baseline")
+foreach(case IN LISTS cases)
+    if (NOT DEFINED baseline_${case}_instructions)
+        message(FATAL_ERROR "result_${case} has no baseline_${case}")
+    endif()
+
+    stack_usage(result_${case} result_stack)
+    stack_usage(baseline_${case} baseline_stack)
+
+    set(verdict "")
+    if (result_${case}_instructions GREATER baseline_${case}_instructions)
+        string(APPEND verdict " more instructions")
+    endif()
+    if (result_stack GREATER baseline_stack)
+        string(APPEND verdict " more stack")
+    endif()
+    if (result_${case}_calls GREATER baseline_${case}_calls)
+        string(APPEND verdict " more calls")
+    endif()
+
+    set(summary "${case}: ${result_${case}_instructions} / ${baseline_${case}_instructions}, ${result_stack} / ${baseline_stack}, ${result_${case}_calls} / ${baseline_${case}_calls}")
+    if (verdict STREQUAL "")
+        message(STATUS "${summary}")
+    else()
+        message(STATUS "${summary} - WORSE:${verdict}")
+        list(APPEND failed "${case}")
+    endif()
+endforeach()
+
+if (NOT failed STREQUAL "")
+    message(FATAL_ERROR "Result compiles to worse code than baseline in: ${failed}")
+endif()
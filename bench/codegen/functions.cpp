@@ -0,0 +1,132 @@
+//Reference functions, each `result_<case>` written with Result next to `baseline_<case>` written by hand
+//with tagged struct or std::pair, which compare.cmake checks to compile to no worse code.
+#include <cstddef>
+#include <utility>
+
+#include <result.hpp>
+
+namespace codegen {
+    struct Node {
+        int key;
+        int value;
+    };
+
+    enum class Err {
+        not_found = 1,
+        bad_input
+    };
+
+    typedef result::Result<int, int> Res;
+    typedef result::Result<const Node*, Err> Lookup;
+
+    struct Tagged {
+        bool is_ok;
+        union {
+            int value;
+            int error;
+        };
+    };
+}
+
+using namespace codegen;
+
+//Opaque steps, so that propagation through calls is compared rather than folded.
+Res step_parse(int input);
+Res step_check(int value);
+Res step_scale(int value);
+Tagged tagged_parse(int input);
+Tagged tagged_check(int value);
+Tagged tagged_scale(int value);
+
+//Creation of Result<int, int>
+Res result_make(int input) {
+    if (input < 0) {
+        return Res::error(input);
+    }
+    return Res::ok(input * 2);
+}
+
+Tagged baseline_make(int input) {
+    Tagged out;
+    if (input < 0) {
+        out.is_ok = false;
+        out.error = input;
+    } else {
+        out.is_ok = true;
+        out.value = input * 2;
+    }
+    return out;
+}
+
+//Result of pointer and enum error
+Lookup result_find(const Node* nodes, std::size_t len, int key) {
+    for (std::size_t idx = 0; idx < len; idx++) {
+        if (nodes[idx].key == key) {
+            return Lookup::ok(&nodes[idx]);
+        }
+    }
+    return Lookup::error(Err::not_found);
+}
+
+std::pair<const Node*, Err> baseline_find(const Node* nodes, std::size_t len, int key) {
+    for (std::size_t idx = 0; idx < len; idx++) {
+        if (nodes[idx].key == key) {
+            return {&nodes[idx], Err()};
+        }
+    }
+    return {nullptr, Err::not_found};
+}
+
+//unwrap_or of Result passed by value
+int result_unwrap_or(Res input) {
+    return std::move(input).unwrap_or(-1);
+}
+
+int baseline_unwrap_or(Tagged input) {
+    return input.is_ok ? input.value : -1;
+}
+
+//map chain over result of call
+int result_map_chain(int input) {
+    return step_parse(input).map([](int value) {
+        return value + 1;
+    }).map([](int value) {
+        return value * 3;
+    }).map_err([](int error) {
+        return error - 1;
+    }).unwrap_or(0);
+}
+
+int baseline_map_chain(int input) {
+    const Tagged parsed = tagged_parse(input);
+    return parsed.is_ok ? (parsed.value + 1) * 3 : 0;
+}
+
+//and_then propagating error of the first failed call
+Res result_and_then(int input) {
+    return step_parse(input).and_then(step_check).and_then(step_scale);
+}
+
+Tagged baseline_and_then(int input) {
+    const Tagged parsed = tagged_parse(input);
+    if (!parsed.is_ok) {
+        return parsed;
+    }
+    const Tagged checked = tagged_check(parsed.value);
+    if (!checked.is_ok) {
+        return checked;
+    }
+    return tagged_scale(checked.value);
+}
+
+//Lookup of pointer, that is dereferenced only if found
+int result_find_value(const Node* nodes, std::size_t len, int key) {
+    return result_find(nodes, len, key).map([](const Node* node) {
+        return node->value;
+    }).unwrap_or(0);
+}
+
+int baseline_find_value(const Node* nodes, std::size_t len, int key) {
+    const std::pair<const Node*, Err> found = baseline_find(nodes, len, key);
+    return found.second == Err() ? found.first->value : 0;
+}
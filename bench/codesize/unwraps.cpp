@@ -0,0 +1,10 @@
+//Function doing several unwraps, which is compiled in each unwrap mode to compare code size.
+#include <string>
+
+#include <result.hpp>
+
+typedef result::Result<int, std::string> Res;
+
+int sum_unwraps(const Res& first, const Res& second, const Res& third, const Res& fourth) {
+    return first.unwrap() + second.unwrap() + third.unwrap() + fourth.unwrap();
+}
@@ -0,0 +1,57 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <variant>
+
+#include <result.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Node;
+    struct NotFound {};
+
+    enum class ErrorCode: std::uint32_t {
+        ok = 0,
+        not_found,
+        timeout
+    };
+}
+
+template<>
+struct result::niche_traits<Node*>: result::niche_value<Node*, nullptr> {};
+template<>
+struct result::niche_traits<ErrorCode>: result::niche_value<ErrorCode, ErrorCode::ok> {};
+
+namespace {
+    constexpr long long elements = 1000000;
+
+    template<class T>
+    void footprint(const char* name, std::size_t payload) {
+        bench::report("footprint", name, {}, {
+            {"sizeof", static_cast<long long>(sizeof(T))},
+            {"payload", static_cast<long long>(payload)},
+            {"vector_1m_bytes", static_cast<long long>(sizeof(T)) * elements}
+        });
+    }
+
+    void report_all() {
+        footprint<result::Result<int, int>>("Result<int,int>", sizeof(int));
+        footprint<result::Result<std::uint32_t, std::uint32_t>>("Result<uint32_t,uint32_t>", sizeof(std::uint32_t));
+        footprint<result::Result<std::uint64_t, ErrorCode>>("Result<uint64_t,ErrorCode>", sizeof(std::uint64_t));
+        footprint<result::Result<int*, NotFound>>("Result<int*,NotFound>", sizeof(int*));
+        footprint<result::Result<Node*, NotFound>>("Result<Node*,NotFound>/niche", sizeof(Node*));
+        footprint<result::Result<Node*, void>>("Result<Node*,void>/niche", sizeof(Node*));
+        footprint<result::Result<NotFound, ErrorCode>>("Result<NotFound,ErrorCode>/niche", sizeof(ErrorCode));
+        footprint<result::Result<void, ErrorCode>>("Result<void,ErrorCode>/niche", sizeof(ErrorCode));
+        footprint<result::Result<void, std::error_code>>("Result<void,std::error_code>", sizeof(std::error_code));
+        footprint<result::Result<std::string, int>>("Result<std::string,int>", sizeof(std::string));
+
+        footprint<std::optional<int*>>("optional<int*>", sizeof(int*));
+        footprint<std::variant<std::uint32_t, std::uint32_t>>("variant<uint32_t,uint32_t>", sizeof(std::uint32_t));
+        footprint<std::variant<Node*, NotFound>>("variant<Node*,NotFound>", sizeof(Node*));
+    }
+
+    const bench::RegisterReport registered("footprint", report_all);
+}
@@ -0,0 +1,152 @@
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "bench.hpp"
+
+static std::atomic<std::uint64_t> allocation_count(0);
+
+void* operator new(std::size_t size) {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace bench {
+    std::uint64_t allocations() noexcept {
+        return allocation_count.load(std::memory_order_relaxed);
+    }
+
+    std::vector<Case>& registry() {
+        static std::vector<Case> cases;
+        return cases;
+    }
+
+    std::vector<Report>& reports() {
+        static std::vector<Report> reports;
+        return reports;
+    }
+
+    static void print_args(const Args& args) {
+        std::printf("{");
+        for (std::size_t idx = 0; idx < args.size(); idx++) {
+            std::printf("%s\"%s\":%lld", idx == 0 ? "" : ",", args[idx].first, args[idx].second);
+        }
+        std::printf("}");
+    }
+
+    void report(const std::string& group, const std::string& name, const Args& args, const Args& metrics) {
+        std::printf("{\"group\":\"%s\",\"name\":\"%s\",\"args\":", group.c_str(), name.c_str());
+        print_args(args);
+        for (const auto& metric : metrics) {
+            std::printf(",\"%s\":%lld", metric.first, metric.second);
+        }
+        std::printf("}\n");
+        std::fflush(stdout);
+    }
+
+    ///Runs case for at least min_time, reporting best of repetitions.
+    static void run(const Case& bench_case, std::chrono::nanoseconds min_time, unsigned repetitions) {
+        using clock = std::chrono::steady_clock;
+
+        std::size_t iterations = 1;
+
+        //Calibrate number of iterations
+        while (iterations < (std::size_t(1) << 40)) {
+            const auto start = clock::now();
+            bench_case.fn(iterations);
+            if (clock::now() - start >= min_time) {
+                break;
+            }
+
+            iterations *= 2;
+        }
+
+        clock::duration best = clock::duration::max();
+        std::uint64_t allocs = 0;
+        for (unsigned rep = 0; rep < repetitions; rep++) {
+            const auto allocs_before = allocations();
+            const auto start = clock::now();
+            bench_case.fn(iterations);
+            const auto elapsed = clock::now() - start;
+            allocs = allocations() - allocs_before;
+
+            if (elapsed < best) {
+                best = elapsed;
+            }
+        }
+
+        const double ns = std::chrono::duration<double, std::nano>(best).count();
+
+        std::printf("{\"group\":\"%s\",\"name\":\"%s\",\"args\":", bench_case.group.c_str(), bench_case.name.c_str());
+        print_args(bench_case.args);
+        std::printf(",\"iterations\":%zu,\"ns_per_op\":%.4f,\"allocs_per_op\":%.4f}\n",
+                    iterations, ns / static_cast<double>(iterations),
+                    static_cast<double>(allocs) / static_cast<double>(iterations));
+        std::fflush(stdout);
+    }
+}
+
+static bool is_selected(const std::string& name, const std::vector<const char*>& filters) {
+    for (const char* filter : filters) {
+        if (name.find(filter) != std::string::npos) {
+            return true;
+        }
+    }
+
+    return filters.empty();
+}
+
+static void usage(const char* name) {
+    std::fprintf(stderr, "Usage: %s [--min-time <ms>] [--repetitions <n>] [filter...]\n", name);
+    std::fprintf(stderr, "\nRuns benchmarks whose `group/name` contains any of filters, printing JSON line per case.\n");
+}
+
+int main(int argc, char** argv) {
+    long min_time_ms = 20;
+    unsigned repetitions = 3;
+    std::vector<const char*> filters;
+
+    for (int idx = 1; idx < argc; idx++) {
+        if (std::strcmp(argv[idx], "--min-time") == 0 && idx + 1 < argc) {
+            min_time_ms = std::atol(argv[++idx]);
+        } else if (std::strcmp(argv[idx], "--repetitions") == 0 && idx + 1 < argc) {
+            repetitions = static_cast<unsigned>(std::atoi(argv[++idx]));
+        } else if (std::strcmp(argv[idx], "--help") == 0 || std::strcmp(argv[idx], "-h") == 0) {
+            usage(argv[0]);
+            return 0;
+        } else {
+            filters.push_back(argv[idx]);
+        }
+    }
+
+    if (repetitions == 0) {
+        repetitions = 1;
+    }
+
+    for (const auto& report : bench::reports()) {
+        if (is_selected(report.group, filters)) {
+            report.fn();
+        }
+    }
+
+    for (const auto& bench_case : bench::registry()) {
+        if (is_selected(bench_case.group + "/" + bench_case.name, filters)) {
+            bench::run(bench_case, std::chrono::milliseconds(min_time_ms), repetitions);
+        }
+    }
+
+    return 0;
+}
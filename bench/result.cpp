@@ -0,0 +1,605 @@
+#include <optional>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<expected>)
+#include <expected>
+#endif
+#endif
+
+#include <result.hpp>
+#include <result_pipe.hpp>
+
+#include "bench.hpp"
+
+#if defined(__cpp_lib_expected) && __cpp_lib_expected >= 202211L
+#define BENCH_HAS_EXPECTED 1
+#endif
+
+#if defined(__cpp_lib_optional) && __cpp_lib_optional >= 202110L
+#define BENCH_HAS_OPTIONAL_MONADIC 1
+#endif
+
+namespace {
+    struct Error {
+        int code;
+    };
+
+    typedef result::Result<int, Error> Res;
+    typedef result::Result<std::string, Error> StrRes;
+
+    BENCH_NOINLINE Res result_parse(int input, bool fail) {
+        if (fail) {
+            return Res::error(Error{input});
+        }
+        return Res::ok(input);
+    }
+
+    BENCH_NOINLINE int exception_parse(int input, bool fail) {
+        if (fail) {
+            throw Error{input};
+        }
+        return input;
+    }
+
+    BENCH_NOINLINE std::optional<int> optional_parse(int input, bool fail) {
+        if (fail) {
+            return std::nullopt;
+        }
+        return input;
+    }
+
+    BENCH_NOINLINE std::variant<int, Error> variant_parse(int input, bool fail) {
+        if (fail) {
+            return Error{input};
+        }
+        return input;
+    }
+
+#ifdef BENCH_HAS_EXPECTED
+    BENCH_NOINLINE std::expected<int, Error> expected_parse(int input, bool fail) {
+        if (fail) {
+            return std::unexpected(Error{input});
+        }
+        return input;
+    }
+#endif
+
+    //Runs `op(input, fail)` over sequence with given failure rate.
+    template<class Op>
+    bench::Fn over_failures(unsigned percent, Op op) {
+        return [fails = bench::failures(percent), op](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                op(static_cast<int>(idx), fails[idx & bench::failures_mask] != 0);
+            }
+        };
+    }
+
+    ////////////////////
+    //Construction
+    ////////////////////
+    void register_construct() {
+        for (unsigned percent : {0u, 100u}) {
+            const bench::Args args = {{"fail_pct", percent}};
+
+            bench::add("construct", "result", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(result_parse(input, fail));
+            }));
+            bench::add("construct", "exception", args, over_failures(percent, [](int input, bool fail) {
+                try {
+                    bench::do_not_optimize(exception_parse(input, fail));
+                } catch (const Error& error) {
+                    bench::do_not_optimize(error);
+                }
+            }));
+            bench::add("construct", "optional", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(optional_parse(input, fail));
+            }));
+            bench::add("construct", "variant", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(variant_parse(input, fail));
+            }));
+#ifdef BENCH_HAS_EXPECTED
+            bench::add("construct", "expected", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(expected_parse(input, fail));
+            }));
+#endif
+        }
+    }
+
+    ////////////////////
+    //Move
+    ////////////////////
+    template<class Make>
+    bench::Fn move_loop(Make make) {
+        return [make](std::size_t iterations) {
+            auto value = make();
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                decltype(value) moved(std::move(value));
+                bench::clobber();
+                value = std::move(moved);
+                bench::do_not_optimize(value);
+            }
+        };
+    }
+
+    void register_move() {
+        static const std::string text("short text");
+
+        bench::add("move", "result/int", {}, move_loop([]() {
+            return Res::ok(1);
+        }));
+        bench::add("move", "result/string", {}, move_loop([]() {
+            return StrRes::ok(text);
+        }));
+        bench::add("move", "plain/string", {}, move_loop([]() {
+            return text;
+        }));
+        bench::add("move", "optional/string", {}, move_loop([]() {
+            return std::optional<std::string>(text);
+        }));
+        bench::add("move", "variant/string", {}, move_loop([]() {
+            return std::variant<std::string, Error>(text);
+        }));
+#ifdef BENCH_HAS_EXPECTED
+        bench::add("move", "expected/string", {}, move_loop([]() {
+            return std::expected<std::string, Error>(text);
+        }));
+#endif
+    }
+
+    ////////////////////
+    //Overwrite
+    ////////////////////
+    //Messages longer than small string buffer, so every fresh string allocates.
+    std::vector<StrRes> overwrite_messages(unsigned err_pct) {
+        const std::vector<unsigned char> fails = bench::failures(err_pct, 64);
+        std::vector<StrRes> messages;
+        for (std::size_t idx = 0; idx < fails.size(); idx++) {
+            if (fails[idx] != 0) {
+                messages.push_back(StrRes::error(Error{static_cast<int>(idx)}));
+            } else {
+                messages.push_back(StrRes::ok(std::string(48 + idx % 16, static_cast<char>('a' + idx % 26))));
+            }
+        }
+        return messages;
+    }
+
+    //Long-lived slot, e.g. last message of connection, overwritten by `op(slot, message)`.
+    template<class Op>
+    bench::Fn overwrite_loop(unsigned err_pct, Op op) {
+        return [messages = overwrite_messages(err_pct), op](std::size_t iterations) {
+            StrRes slot = StrRes::ok(std::string(64, 'x'));
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                op(slot, messages[idx % messages.size()]);
+                bench::do_not_optimize(slot);
+            }
+        };
+    }
+
+    void register_overwrite() {
+        for (unsigned percent : {0u, 10u}) {
+            const bench::Args args = {{"fail_pct", percent}};
+
+            bench::add("overwrite", "result/copy", args, overwrite_loop(percent, [](StrRes& slot, const StrRes& message) {
+                slot = message;
+            }));
+            bench::add("overwrite", "result/emplace", args, overwrite_loop(percent, [](StrRes& slot, const StrRes& message) {
+                if (message.is_ok()) {
+                    slot.emplace_ok(*message.value());
+                } else {
+                    slot.emplace_err(*message.error());
+                }
+            }));
+            bench::add("overwrite", "result/fresh", args, overwrite_loop(percent, [](StrRes& slot, const StrRes& message) {
+                slot = StrRes(message);
+            }));
+        }
+
+        //Exact count of allocations, once slot has grown to the longest message.
+        bench::RegisterReport("overwrite_steady", [] {
+            constexpr std::size_t overwrites = 10000000;
+            const std::vector<StrRes> messages = overwrite_messages(0);
+
+            StrRes slot = StrRes::ok(std::string());
+            for (const StrRes& message : messages) {
+                slot = message;
+            }
+
+            const std::uint64_t before = bench::allocations();
+            for (std::size_t idx = 0; idx < overwrites; idx++) {
+                slot = messages[idx % messages.size()];
+                bench::do_not_optimize(slot);
+            }
+            const std::uint64_t allocs = bench::allocations() - before;
+
+            bench::report("overwrite_steady", "result/copy", {{"overwrites", static_cast<long long>(overwrites)}}, {{"allocs", static_cast<long long>(allocs)}});
+        });
+    }
+
+    ////////////////////
+    //Lookup
+    ////////////////////
+    struct NotFound {};
+
+    struct Entry {
+        std::string name;
+        long long size;
+    };
+
+    const std::vector<Entry>& lookup_table() {
+        static const std::vector<Entry> table = [] {
+            std::vector<Entry> entries;
+            for (long long idx = 0; idx < 1024; idx++) {
+                entries.push_back(Entry{std::string(32, static_cast<char>('a' + idx % 26)), idx});
+            }
+            return entries;
+        }();
+        return table;
+    }
+
+    BENCH_NOINLINE result::Result<Entry, NotFound> lookup_copy(std::size_t idx, bool fail) {
+        if (fail) {
+            return result::Result<Entry, NotFound>::error(NotFound());
+        }
+        return result::Result<Entry, NotFound>::ok(lookup_table()[idx]);
+    }
+
+    BENCH_NOINLINE result::Result<const Entry&, NotFound> lookup_ref(std::size_t idx, bool fail) {
+        if (fail) {
+            return result::Result<const Entry&, NotFound>::error(NotFound());
+        }
+        return result::Result<const Entry&, NotFound>::ok(lookup_table()[idx]);
+    }
+
+    BENCH_NOINLINE const Entry* lookup_pointer(std::size_t idx, bool fail) {
+        if (fail) {
+            return nullptr;
+        }
+        return &lookup_table()[idx];
+    }
+
+    void register_lookup() {
+        for (unsigned percent : {0u, 10u}) {
+            const bench::Args args = {{"fail_pct", percent}};
+            const auto size = [](const Entry& entry) {
+                return entry.size;
+            };
+
+            bench::add("lookup", "result/copy", args, over_failures(percent, [size](int input, bool fail) {
+                bench::do_not_optimize(lookup_copy(static_cast<std::size_t>(input) & 1023, fail).map(size).unwrap_or(-1));
+            }));
+            bench::add("lookup", "result/ref", args, over_failures(percent, [size](int input, bool fail) {
+                bench::do_not_optimize(lookup_ref(static_cast<std::size_t>(input) & 1023, fail).map(size).unwrap_or(-1));
+            }));
+            bench::add("lookup", "pointer", args, over_failures(percent, [](int input, bool fail) {
+                const Entry* entry = lookup_pointer(static_cast<std::size_t>(input) & 1023, fail);
+                bench::do_not_optimize(entry != nullptr ? entry->size : -1);
+            }));
+        }
+    }
+
+    ////////////////////
+    //Unwrap
+    ////////////////////
+    void register_unwrap() {
+        bench::add("unwrap", "result", {}, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(result_parse(input, fail).unwrap());
+        }));
+        bench::add("unwrap", "exception", {}, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(exception_parse(input, fail));
+        }));
+        bench::add("unwrap", "optional", {}, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(optional_parse(input, fail).value());
+        }));
+        bench::add("unwrap", "variant", {}, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(std::get<int>(variant_parse(input, fail)));
+        }));
+#ifdef BENCH_HAS_EXPECTED
+        bench::add("unwrap", "expected", {}, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(expected_parse(input, fail).value());
+        }));
+#endif
+
+        for (unsigned percent : {0u, 50u}) {
+            const bench::Args args = {{"fail_pct", percent}};
+
+            bench::add("unwrap_or", "result", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(result_parse(input, fail).unwrap_or(0));
+            }));
+            bench::add("unwrap_or", "exception", args, over_failures(percent, [](int input, bool fail) {
+                int value;
+                try {
+                    value = exception_parse(input, fail);
+                } catch (const Error&) {
+                    value = 0;
+                }
+                bench::do_not_optimize(value);
+            }));
+            bench::add("unwrap_or", "optional", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(optional_parse(input, fail).value_or(0));
+            }));
+            bench::add("unwrap_or", "variant", args, over_failures(percent, [](int input, bool fail) {
+                const auto value = variant_parse(input, fail);
+                bench::do_not_optimize(std::holds_alternative<int>(value) ? std::get<int>(value) : 0);
+            }));
+#ifdef BENCH_HAS_EXPECTED
+            bench::add("unwrap_or", "expected", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(expected_parse(input, fail).value_or(0));
+            }));
+#endif
+        }
+    }
+
+    ////////////////////
+    //Chains
+    ////////////////////
+    constexpr auto inc = [](int value) {
+        return value + 1;
+    };
+
+    template<std::size_t N, class R>
+    auto chain_map(R&& value) {
+        if constexpr (N == 0) {
+            return std::forward<R>(value);
+        } else {
+            return chain_map<N - 1>(std::forward<R>(value).map(inc));
+        }
+    }
+
+    template<std::size_t N, class R>
+    auto chain_and_then(R&& value) {
+        if constexpr (N == 0) {
+            return std::forward<R>(value);
+        } else {
+            return chain_and_then<N - 1>(std::forward<R>(value).and_then([](int value) {
+                return Res::ok(value + 1);
+            }));
+        }
+    }
+
+    //Same chains as pipeline, fused into single pass.
+    template<std::size_t>
+    auto map_stage() {
+        return result::pipe::map(inc);
+    }
+
+    template<std::size_t>
+    auto and_then_stage() {
+        return result::pipe::and_then([](int value) {
+            return Res::ok(value + 1);
+        });
+    }
+
+    template<std::size_t... I>
+    auto pipe_maps(std::index_sequence<I...>) {
+        return (map_stage<I>() | ...);
+    }
+
+    template<std::size_t... I>
+    auto pipe_and_thens(std::index_sequence<I...>) {
+        return (and_then_stage<I>() | ...);
+    }
+
+    template<std::size_t N>
+    int chain_plain(int value) {
+        for (std::size_t idx = 0; idx < N; idx++) {
+            value = inc(value);
+            bench::clobber();
+        }
+        return value;
+    }
+
+#ifdef BENCH_HAS_OPTIONAL_MONADIC
+    template<std::size_t N, class O>
+    auto chain_transform(O&& value) {
+        if constexpr (N == 0) {
+            return std::forward<O>(value);
+        } else {
+            return chain_transform<N - 1>(std::forward<O>(value).transform(inc));
+        }
+    }
+
+    template<std::size_t N>
+    std::optional<int> chain_optional_and_then(std::optional<int>&& value) {
+        if constexpr (N == 0) {
+            return std::move(value);
+        } else {
+            return chain_optional_and_then<N - 1>(std::move(value).and_then([](int value) {
+                return std::optional<int>(value + 1);
+            }));
+        }
+    }
+#endif
+
+#ifdef BENCH_HAS_EXPECTED
+    template<std::size_t N>
+    std::expected<int, Error> chain_expected_and_then(std::expected<int, Error>&& value) {
+        if constexpr (N == 0) {
+            return std::move(value);
+        } else {
+            return chain_expected_and_then<N - 1>(std::move(value).and_then([](int value) {
+                return std::expected<int, Error>(value + 1);
+            }));
+        }
+    }
+#endif
+
+    template<std::size_t N>
+    void register_chain() {
+        const bench::Args args = {{"len", static_cast<long long>(N)}};
+
+        bench::add("chain", "result/map", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_map<N>(result_parse(input, fail)));
+        }));
+        bench::add("chain", "result/and_then", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_and_then<N>(result_parse(input, fail)));
+        }));
+        bench::add("chain", "result/pipe_map", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize((result_parse(input, fail) | pipe_maps(std::make_index_sequence<N>())).eval());
+        }));
+        bench::add("chain", "result/pipe_and_then", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize((result_parse(input, fail) | pipe_and_thens(std::make_index_sequence<N>())).eval());
+        }));
+        bench::add("chain", "exception", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_plain<N>(exception_parse(input, fail)));
+        }));
+#ifdef BENCH_HAS_OPTIONAL_MONADIC
+        bench::add("chain", "optional/transform", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_transform<N>(optional_parse(input, fail)));
+        }));
+        bench::add("chain", "optional/and_then", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_optional_and_then<N>(optional_parse(input, fail)));
+        }));
+#endif
+#ifdef BENCH_HAS_EXPECTED
+        bench::add("chain", "expected/transform", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_transform<N>(expected_parse(input, fail)));
+        }));
+        bench::add("chain", "expected/and_then", args, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(chain_expected_and_then<N>(expected_parse(input, fail)));
+        }));
+#endif
+    }
+
+    ////////////////////
+    //Error propagation
+    ////////////////////
+    template<int D>
+    BENCH_NOINLINE Res result_propagate(int input, bool fail) {
+        if constexpr (D == 0) {
+            return result_parse(input, fail);
+        } else {
+            auto res = result_propagate<D - 1>(input, fail);
+            if (res.is_err()) {
+                return Res::error(*res.error());
+            }
+            return Res::ok(*res.value() + 1);
+        }
+    }
+
+    template<int D>
+    BENCH_NOINLINE int exception_propagate(int input, bool fail) {
+        if constexpr (D == 0) {
+            return exception_parse(input, fail);
+        } else {
+            return exception_propagate<D - 1>(input, fail) + 1;
+        }
+    }
+
+    template<int D>
+    BENCH_NOINLINE std::optional<int> optional_propagate(int input, bool fail) {
+        if constexpr (D == 0) {
+            return optional_parse(input, fail);
+        } else {
+            auto res = optional_propagate<D - 1>(input, fail);
+            if (!res) {
+                return std::nullopt;
+            }
+            return *res + 1;
+        }
+    }
+
+    template<int D>
+    BENCH_NOINLINE std::variant<int, Error> variant_propagate(int input, bool fail) {
+        if constexpr (D == 0) {
+            return variant_parse(input, fail);
+        } else {
+            auto res = variant_propagate<D - 1>(input, fail);
+            if (auto error = std::get_if<Error>(&res)) {
+                return *error;
+            }
+            return std::get<int>(res) + 1;
+        }
+    }
+
+#ifdef BENCH_HAS_EXPECTED
+    template<int D>
+    BENCH_NOINLINE std::expected<int, Error> expected_propagate(int input, bool fail) {
+        if constexpr (D == 0) {
+            return expected_parse(input, fail);
+        } else {
+            auto res = expected_propagate<D - 1>(input, fail);
+            if (!res) {
+                return std::unexpected(res.error());
+            }
+            return *res + 1;
+        }
+    }
+#endif
+
+#ifdef RESULT_HAS_COROUTINE
+    template<int D>
+    BENCH_NOINLINE Res coroutine_propagate(int input, bool fail) {
+        co_return co_await coroutine_propagate<D - 1>(input, fail) + 1;
+    }
+
+    template<>
+    BENCH_NOINLINE Res coroutine_propagate<0>(int input, bool fail) {
+        return result_parse(input, fail);
+    }
+#endif
+
+    template<int D>
+    void register_propagate(unsigned percent, const char* group) {
+        const bench::Args args = {{"depth", D}, {"fail_pct", percent}};
+
+        bench::add(group, "result", args, over_failures(percent, [](int input, bool fail) {
+            bench::do_not_optimize(result_propagate<D>(input, fail));
+        }));
+#ifdef RESULT_HAS_COROUTINE
+        bench::add(group, "result/coroutine", args, over_failures(percent, [](int input, bool fail) {
+            bench::do_not_optimize(coroutine_propagate<D>(input, fail));
+        }));
+#endif
+        bench::add(group, "exception", args, over_failures(percent, [](int input, bool fail) {
+            try {
+                bench::do_not_optimize(exception_propagate<D>(input, fail));
+            } catch (const Error& error) {
+                bench::do_not_optimize(error);
+            }
+        }));
+        bench::add(group, "optional", args, over_failures(percent, [](int input, bool fail) {
+            bench::do_not_optimize(optional_propagate<D>(input, fail));
+        }));
+        bench::add(group, "variant", args, over_failures(percent, [](int input, bool fail) {
+            bench::do_not_optimize(variant_propagate<D>(input, fail));
+        }));
+#ifdef BENCH_HAS_EXPECTED
+        bench::add(group, "expected", args, over_failures(percent, [](int input, bool fail) {
+            bench::do_not_optimize(expected_propagate<D>(input, fail));
+        }));
+#endif
+    }
+
+    template<int... D>
+    void register_depths(unsigned percent, std::integer_sequence<int, D...>) {
+        (register_propagate<D>(percent, "propagate"), ...);
+    }
+
+    void register_all() {
+        register_construct();
+        register_move();
+        register_overwrite();
+        register_lookup();
+        register_unwrap();
+
+        register_chain<1>();
+        register_chain<2>();
+        register_chain<4>();
+        register_chain<8>();
+        register_chain<16>();
+
+        for (unsigned percent : {0u, 50u}) {
+            register_depths(percent, std::integer_sequence<int, 1, 2, 4, 8, 16, 32, 64>());
+        }
+
+        for (unsigned percent : {0u, 1u, 5u, 10u, 25u, 50u}) {
+            register_propagate<4>(percent, "failure_rate");
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
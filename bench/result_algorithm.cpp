@@ -0,0 +1,105 @@
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <result_algorithm.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Error {
+        int code;
+    };
+
+    typedef result::Result<int, Error> Res;
+
+    BENCH_NOINLINE Res check(int input) {
+        if (input < 0) {
+            return Res::error(Error{input});
+        }
+        return Res::ok(input);
+    }
+
+    //Results with given failure rate, or all Ok if percent is 0.
+    std::shared_ptr<const std::vector<Res>> make_results(std::size_t len, unsigned percent) {
+        const auto fails = bench::failures(percent, len);
+
+        auto results = std::make_shared<std::vector<Res>>();
+        results->reserve(len);
+        for (std::size_t idx = 0; idx < len; idx++) {
+            if (fails[idx] != 0) {
+                results->push_back(Res::error(Error{static_cast<int>(idx)}));
+            } else {
+                results->push_back(Res::ok(static_cast<int>(idx)));
+            }
+        }
+
+        return results;
+    }
+
+    //Each operation processes whole input.
+    template<class Input, class Op>
+    bench::Fn over_input(std::shared_ptr<const Input> input, Op op) {
+        return [input, op](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                bench::do_not_optimize(op(*input));
+            }
+        };
+    }
+
+    void register_all() {
+        for (std::size_t len : {std::size_t(1000), std::size_t(1000000)}) {
+            const bench::Args args = {{"len", static_cast<long long>(len)}};
+            const auto results = make_results(len, 0);
+
+            bench::add("collect", "loop", args, over_input(results, [](const std::vector<Res>& input) {
+                std::vector<int> values;
+                for (const Res& elem : input) {
+                    if (elem.is_err()) {
+                        return Res::error(*elem.error()).map([](int) {
+                            return std::vector<int>();
+                        });
+                    }
+                    values.push_back(*elem.value());
+                }
+                return result::Result<std::vector<int>, Error>::ok(std::move(values));
+            }));
+            bench::add("collect", "collect", args, over_input(results, [](const std::vector<Res>& input) {
+                return result::collect(input);
+            }));
+
+            const auto numbers = std::make_shared<const std::vector<int>>(len, 1);
+            bench::add("collect", "try_transform", args, over_input(numbers, [](const std::vector<int>& input) {
+                return result::try_transform(input, check);
+            }));
+            bench::add("collect", "try_fold", args, over_input(numbers, [](const std::vector<int>& input) {
+                return result::try_fold(input, 0L, [](long sum, int num) {
+                    return check(num).map([sum](int value) {
+                        return sum + value;
+                    });
+                });
+            }));
+
+            const bench::Args partition_args = {{"len", static_cast<long long>(len)}, {"fail_pct", 25}};
+            const auto mixed = make_results(len, 25);
+
+            bench::add("partition", "loop", partition_args, over_input(mixed, [](const std::vector<Res>& input) {
+                std::pair<std::vector<int>, std::vector<Error>> parts;
+                for (const Res& elem : input) {
+                    if (elem.is_ok()) {
+                        parts.first.push_back(*elem.value());
+                    } else {
+                        parts.second.push_back(*elem.error());
+                    }
+                }
+                return parts;
+            }));
+            bench::add("partition", "partition", partition_args, over_input(mixed, [](const std::vector<Res>& input) {
+                return result::partition(input);
+            }));
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <result_any_error.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    //Error storm: backend fails every request and error is passed through two layers to the handler.
+    constexpr const char* backend_down = "backend unavailable: connection refused";
+
+    struct BackendDown {
+        int code;
+        const char* reason;
+
+        std::string_view message() const noexcept {
+            return reason;
+        }
+    };
+
+    struct BaseError {
+        virtual ~BaseError() = default;
+        virtual std::string_view message() const noexcept = 0;
+    };
+
+    struct BackendError: BaseError {
+        int code;
+
+        explicit BackendError(int code) noexcept : code(code) {}
+
+        std::string_view message() const noexcept override {
+            return backend_down;
+        }
+    };
+
+    template<class Error>
+    using Res = result::Result<int, Error>;
+
+    BENCH_NOINLINE Res<std::string> string_backend(int request) {
+        bench::do_not_optimize(request);
+        return Res<std::string>::error(backend_down);
+    }
+
+    BENCH_NOINLINE Res<std::unique_ptr<BaseError>> ptr_backend(int request) {
+        return Res<std::unique_ptr<BaseError>>::error(std::make_unique<BackendError>(request));
+    }
+
+    BENCH_NOINLINE Res<result::AnyError> any_backend(int request) {
+        return Res<result::AnyError>::error(BackendDown{request, backend_down});
+    }
+
+    template<class Backend>
+    BENCH_NOINLINE auto service(Backend backend, int request) {
+        return backend(request).map([](int value) {
+            return value + 1;
+        });
+    }
+
+    template<class Backend, class Message>
+    bench::Fn storm(Backend backend, Message message) {
+        return [backend, message](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                auto response = service(backend, static_cast<int>(idx));
+                bench::do_not_optimize(message(response).size());
+            }
+        };
+    }
+
+    void register_all() {
+        bench::add("error_storm", "string", {}, storm(string_backend, [](const Res<std::string>& response) {
+            return std::string_view(*response.error());
+        }));
+        bench::add("error_storm", "unique_ptr", {}, storm(ptr_backend, [](const Res<std::unique_ptr<BaseError>>& response) {
+            return (*response.error())->message();
+        }));
+        bench::add("error_storm", "any_error", {}, storm(any_backend, [](const Res<result::AnyError>& response) {
+            return response.error()->message();
+        }));
+        bench::add("error_storm", "any_error/erased", {}, storm([](int request) {
+            return result::erase_error(string_backend(request));
+        }, [](const Res<result::AnyError>& response) {
+            return response.error()->message();
+        }));
+    }
+
+    const bench::Register registered(register_all);
+}
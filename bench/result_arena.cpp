@@ -0,0 +1,85 @@
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <result_arena.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    //Every request fails: backend formats error with context, service adds its own and handler reads the message.
+    struct HeapError {
+        int code;
+        std::string message;
+        std::vector<std::pair<std::string, std::string>> context;
+
+        HeapError with(std::string key, std::string value) && {
+            context.emplace_back(std::move(key), std::move(value));
+            return std::move(*this);
+        }
+    };
+
+    template<class Error>
+    using Res = result::Result<int, Error>;
+
+    BENCH_NOINLINE Res<HeapError> heap_backend(int request) {
+        return Res<HeapError>::error(HeapError{404, "user " + std::to_string(request) + " not found", {}}.with("table", "users"));
+    }
+
+    BENCH_NOINLINE Res<result::ArenaError> arena_backend(int request) {
+        return Res<result::ArenaError>::error(result::ArenaError::make(404, "user ", request, " not found").with("table", "users"));
+    }
+
+    HeapError heap_context(HeapError&& error, int request) {
+        return std::move(error).with("request", std::to_string(request));
+    }
+
+    result::ArenaError arena_context(const result::ArenaError& error, int request) {
+        return error.with("request", request);
+    }
+
+    //Service either passes backend's Result through, or keeps it, e.g. to log, so chain copies error.
+    template<bool Copy, class Backend, class Context>
+    BENCH_NOINLINE auto service(Backend backend, Context context, int request) {
+        auto response = backend(request);
+        const auto add_context = [context, request](auto error) {
+            return context(std::move(error), request);
+        };
+        const auto next = [](int value) {
+            return value + 1;
+        };
+        if constexpr (Copy) {
+            const auto& kept = response;
+            return kept.map(next).map_err(add_context);
+        } else {
+            return std::move(response).map(next).map_err(add_context);
+        }
+    }
+
+    template<bool Copy>
+    void heap_requests(std::size_t iterations) {
+        for (std::size_t idx = 0; idx < iterations; idx++) {
+            const auto response = service<Copy>(heap_backend, heap_context, static_cast<int>(idx));
+            bench::do_not_optimize(response.error()->message.size());
+        }
+    }
+
+    template<bool Copy>
+    void arena_requests(std::size_t iterations) {
+        for (std::size_t idx = 0; idx < iterations; idx++) {
+            result::ErrorArena::Scope request_scope;
+            const auto response = service<Copy>(arena_backend, arena_context, static_cast<int>(idx));
+            bench::do_not_optimize(response.error()->message().size());
+        }
+    }
+
+    void register_all() {
+        bench::add("error_arena", "heap_string", {{"copies", 0}}, heap_requests<false>);
+        bench::add("error_arena", "arena", {{"copies", 0}}, arena_requests<false>);
+        bench::add("error_arena", "heap_string", {{"copies", 1}}, heap_requests<true>);
+        bench::add("error_arena", "arena", {{"copies", 1}}, arena_requests<true>);
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -0,0 +1,113 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <result_cache.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct NotFound {
+        std::uint32_t key;
+    };
+
+    typedef result::Result<std::uint64_t, NotFound> Resolved;
+
+    constexpr std::uint32_t keys_len = 4096;
+
+    //Resolution against local table, costly enough to be worth caching, which fails for keys divisible by 10.
+    BENCH_NOINLINE Resolved resolve(const std::uint32_t& key) {
+        std::uint64_t hash = key;
+        for (int round = 0; round < 512; round++) {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+        }
+
+        if (key % 10 == 0) {
+            return Resolved::error(NotFound{key});
+        }
+        return Resolved::ok(hash);
+    }
+
+    //Ad-hoc cache under single mutex, that stores only successes, so failing keys always reach backend.
+    class SuccessCache {
+        private:
+            std::mutex mutex;
+            std::unordered_map<std::uint32_t, std::uint64_t> values;
+
+        public:
+            Resolved get(std::uint32_t key) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    const auto found = values.find(key);
+                    if (found != values.end()) {
+                        return Resolved::ok(found->second);
+                    }
+                }
+
+                Resolved resolved = resolve(key);
+                if (resolved.is_ok()) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    values.emplace(key, *resolved.value());
+                }
+                return resolved;
+            }
+    };
+
+    typedef result::ResultCache<std::uint32_t, std::uint64_t, NotFound> Cache;
+
+    //Splits iterations over threads, each looking up its own pseudo-random sequence of keys.
+    template<class Lookup>
+    void lookups(unsigned threads, std::size_t iterations, const Lookup& lookup) {
+        const auto run = [&lookup](std::uint32_t seed, std::size_t count) {
+            std::uint32_t state = 2463534242u + seed;
+            for (std::size_t idx = 0; idx < count; idx++) {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                bench::do_not_optimize(lookup(state % keys_len));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned idx = 1; idx < threads; idx++) {
+            workers.emplace_back(run, idx, iterations / threads);
+        }
+        run(0, iterations - iterations / threads * (threads - 1));
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void register_all() {
+        std::vector<unsigned> thread_counts = {1, 2, 4, 8};
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores > 8) {
+            thread_counts.push_back(cores);
+        }
+
+        for (unsigned threads : thread_counts) {
+            const auto success_cache = std::make_shared<SuccessCache>();
+            bench::add("result_cache", "success_only/mutex", {{"threads", threads}, {"failed_pct", 10}}, [success_cache, threads](std::size_t iterations) {
+                lookups(threads, iterations, [&](std::uint32_t key) {
+                    return success_cache->get(key);
+                });
+            });
+
+            for (std::size_t shards : {1, 16}) {
+                const auto cache = std::make_shared<Cache>(result::cache_defaults.with_shards(shards).with_ok(keys_len, std::chrono::minutes(5)).with_error(keys_len, std::chrono::minutes(5)));
+                bench::add("result_cache", "result_cache", {{"threads", threads}, {"failed_pct", 10}, {"shards", static_cast<long long>(shards)}}, [cache, threads](std::size_t iterations) {
+                    lookups(threads, iterations, [&](std::uint32_t key) {
+                        return cache->get_or_load(key, resolve);
+                    });
+                });
+            }
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
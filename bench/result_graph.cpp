@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include <result_graph.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Error {
+        std::uint64_t node;
+    };
+
+    typedef result::Result<std::uint64_t, Error> Res;
+
+    constexpr std::size_t width = 256;
+    constexpr std::size_t depth = 256;
+
+    //Work of moderate cost, that fails roughly `fail_per_mille` times out of thousand.
+    Res step(std::uint64_t value, unsigned fail_per_mille) {
+        std::uint64_t hash = value;
+        for (int round = 0; round < 64; round++) {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+        }
+
+        if (hash % 1000 < fail_per_mille) {
+            return Res::error(Error{value});
+        }
+        return Res::ok(hash);
+    }
+
+    //Independent chains of length 2 joined by single sink, so most of work is parallel.
+    void wide(unsigned fail_per_mille, result::parallel_policy policy) {
+        result::TaskGraph<Error> graph;
+        std::vector<result::TaskNode<std::uint64_t, Error>> leaves;
+        leaves.reserve(width);
+        for (std::uint64_t idx = 0; idx < width; idx++) {
+            auto root = graph.add("root", [idx, fail_per_mille] {
+                return step(idx, fail_per_mille);
+            });
+            leaves.push_back(graph.add("leaf", [fail_per_mille](std::uint64_t value) {
+                return step(value, fail_per_mille);
+            }, root));
+        }
+
+        auto sink = graph.add("sink", [] {
+            return Res::ok(0);
+        });
+        for (auto leaf : leaves) {
+            sink = graph.add("fold", [](std::uint64_t left, std::uint64_t right) {
+                return Res::ok(left ^ right);
+            }, sink, leaf);
+        }
+
+        graph.run(policy);
+        bench::do_not_optimize(graph.result(sink).is_ok());
+    }
+
+    //Single chain, so there is nothing to steal and overhead of scheduling dominates.
+    void deep(unsigned fail_per_mille, result::parallel_policy policy) {
+        result::TaskGraph<Error> graph;
+        auto last = graph.add("root", [fail_per_mille] {
+            return step(1, fail_per_mille);
+        });
+        for (std::size_t idx = 1; idx < depth; idx++) {
+            last = graph.add("step", [fail_per_mille](std::uint64_t value) {
+                return step(value, fail_per_mille);
+            }, last);
+        }
+
+        graph.run(policy);
+        bench::do_not_optimize(graph.result(last).is_ok());
+    }
+
+    //Builds and runs whole graph per iteration, with failure rate in per mille of nodes.
+    void register_all() {
+        std::vector<unsigned> thread_counts = {1, 2, 4};
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores > 4) {
+            thread_counts.push_back(cores);
+        }
+
+        for (unsigned fail_per_mille : {0u, 1u, 10u}) {
+            for (unsigned threads : thread_counts) {
+                const auto policy = result::par.with_threads(threads);
+                bench::add("task_graph", "wide", {{"nodes", 3 * width + 1}, {"fail_per_mille", fail_per_mille}, {"threads", threads}}, [fail_per_mille, policy](std::size_t iterations) {
+                    for (std::size_t idx = 0; idx < iterations; idx++) {
+                        wide(fail_per_mille, policy);
+                    }
+                });
+                bench::add("task_graph", "deep", {{"nodes", depth}, {"fail_per_mille", fail_per_mille}, {"threads", threads}}, [fail_per_mille, policy](std::size_t iterations) {
+                    for (std::size_t idx = 0; idx < iterations; idx++) {
+                        deep(fail_per_mille, policy);
+                    }
+                });
+            }
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <result_mapped.hpp>
+
+#include "bench.hpp"
+
+#ifdef RESULT_HAS_MAPPED_FILE
+namespace {
+    struct Error {
+        std::uint32_t code;
+    };
+
+    typedef result::Result<std::uint64_t, Error> Res;
+    typedef result::ResultRecord<std::uint64_t, Error> Record;
+
+    constexpr std::size_t file_mb = 1024;
+    constexpr std::size_t records_len = file_mb * 1024 * 1024 / sizeof(Record);
+    constexpr std::size_t stdio_chunk = 4096;
+
+    //File of `file_mb` in temporary directory, that is removed on exit.
+    struct BenchFile {
+        std::string path;
+
+        explicit BenchFile(const char* name) : path(std::string(P_tmpdir) + "/result_bench_" + name + ".bin") {}
+
+        ~BenchFile() {
+            std::remove(path.c_str());
+        }
+    };
+
+    const BenchFile mapped_file("mapped");
+    const BenchFile stdio_file("stdio");
+
+    Res make(std::size_t idx) {
+        if (idx % 64 == 63) {
+            return Res::error(Error{static_cast<std::uint32_t>(idx)});
+        }
+        return Res::ok(idx);
+    }
+
+    void write_mapped() {
+        auto writer = result::MappedResultWriter<std::uint64_t, Error>::create(mapped_file.path.c_str(), records_len).unwrap();
+        for (std::size_t idx = 0; idx < records_len; idx++) {
+            writer.push(make(idx)).unwrap();
+        }
+        writer.finish().unwrap();
+    }
+
+    std::uint64_t read_mapped() {
+        const auto array = result::MappedResultArray<std::uint64_t, Error>::open(mapped_file.path.c_str()).unwrap();
+        std::uint64_t sum = 0;
+        for (const Record& record : array) {
+            if (const std::uint64_t* value = record.value()) {
+                sum += *value;
+            } else {
+                sum ^= record.error()->code;
+            }
+        }
+        return sum;
+    }
+
+    //What is done without mapping: Result is converted into record, which is written and read back by chunks.
+    void write_stdio() {
+        std::FILE* file = std::fopen(stdio_file.path.c_str(), "wb");
+        std::vector<Record> chunk(stdio_chunk);
+        for (std::size_t idx = 0; idx < records_len; idx += stdio_chunk) {
+            for (std::size_t offset = 0; offset < stdio_chunk; offset++) {
+                chunk[offset].assign(make(idx + offset));
+            }
+            std::fwrite(chunk.data(), sizeof(Record), stdio_chunk, file);
+        }
+        std::fclose(file);
+    }
+
+    std::uint64_t read_stdio() {
+        std::FILE* file = std::fopen(stdio_file.path.c_str(), "rb");
+        std::vector<Record> chunk(stdio_chunk);
+        std::uint64_t sum = 0;
+        for (std::size_t read = std::fread(chunk.data(), sizeof(Record), stdio_chunk, file); read > 0; read = std::fread(chunk.data(), sizeof(Record), stdio_chunk, file)) {
+            for (std::size_t offset = 0; offset < read; offset++) {
+                const Res res = chunk[offset].to_result();
+                if (const std::uint64_t* value = res.value()) {
+                    sum += *value;
+                } else {
+                    sum ^= res.error()->code;
+                }
+            }
+        }
+        std::fclose(file);
+        return sum;
+    }
+
+    //Single operation is whole pass over 1 GiB file of Results, so throughput is `mb` divided by time of operation.
+    void register_all() {
+        const bench::Args args = {{"mb", file_mb}, {"records", records_len}};
+
+        bench::add("mapped_file", "write/mapped", args, [](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                write_mapped();
+            }
+        });
+        bench::add("mapped_file", "read/mapped", args, [](std::size_t iterations) {
+            //Written once, during calibration.
+            static const bool written = (write_mapped(), true);
+            static_cast<void>(written);
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                bench::do_not_optimize(read_mapped());
+            }
+        });
+        bench::add("mapped_file", "write/stdio", args, [](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                write_stdio();
+            }
+        });
+        bench::add("mapped_file", "read/stdio", args, [](std::size_t iterations) {
+            //Written once, during calibration.
+            static const bool written = (write_stdio(), true);
+            static_cast<void>(written);
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                bench::do_not_optimize(read_stdio());
+            }
+        });
+    }
+
+    const bench::Register registered(register_all);
+}
+#endif
@@ -0,0 +1,74 @@
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <result_parallel.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Invalid {
+        std::size_t row;
+    };
+
+    typedef result::Result<std::uint64_t, Invalid> Validated;
+
+    constexpr std::size_t records_len = 1 << 20;
+
+    //Validation of moderate cost, that fails on zero record.
+    Validated validate(const std::uint64_t& record) {
+        std::uint64_t hash = record;
+        for (int round = 0; round < 16; round++) {
+            hash ^= hash >> 33;
+            hash *= 0xff51afd7ed558ccdull;
+        }
+
+        if (record == 0) {
+            return Validated::error(Invalid{hash});
+        }
+        return Validated::ok(hash);
+    }
+
+    //Records with single invalid one at given position in percent of length, or none if it is 100.
+    std::shared_ptr<const std::vector<std::uint64_t>> make_records(unsigned fail_at) {
+        auto records = std::make_shared<std::vector<std::uint64_t>>(records_len);
+        for (std::size_t idx = 0; idx < records_len; idx++) {
+            (*records)[idx] = idx + 1;
+        }
+        if (fail_at < 100) {
+            (*records)[records_len / 100 * fail_at] = 0;
+        }
+        return records;
+    }
+
+    void register_all() {
+        std::vector<unsigned> thread_counts = {1, 2, 4, 8};
+        const unsigned cores = std::thread::hardware_concurrency();
+        if (cores > 8) {
+            thread_counts.push_back(cores);
+        }
+
+        for (unsigned fail_at : {100u, 10u, 50u, 90u}) {
+            const auto records = make_records(fail_at);
+
+            bench::add("par_try_transform", "try_transform", {{"fail_at_pct", fail_at}, {"threads", 0}}, [records](std::size_t iterations) {
+                for (std::size_t idx = 0; idx < iterations; idx++) {
+                    bench::do_not_optimize(result::try_transform(*records, validate));
+                }
+            });
+
+            for (unsigned threads : thread_counts) {
+                const auto policy = result::par.with_threads(threads);
+                bench::add("par_try_transform", "par_try_transform", {{"fail_at_pct", fail_at}, {"threads", threads}}, [records, policy](std::size_t iterations) {
+                    for (std::size_t idx = 0; idx < iterations; idx++) {
+                        bench::do_not_optimize(result::par_try_transform(policy, *records, validate));
+                    }
+                });
+            }
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
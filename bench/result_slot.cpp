@@ -0,0 +1,113 @@
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <thread>
+#include <utility>
+
+#include <result_slot.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Error {
+        int code;
+    };
+
+    typedef result::Result<std::uint64_t, Error> Res;
+
+    //Thread, that runs handler for every request posted by single client.
+    class worker {
+        std::atomic<std::uint64_t> posted;
+        std::function<void(std::uint64_t)> handler;
+        std::thread thread;
+
+        void run() {
+            std::uint64_t seen = 0;
+            while (true) {
+                std::uint64_t current = posted.load(std::memory_order_acquire);
+                while (current == seen) {
+#ifdef RESULT_HAS_ATOMIC_WAIT
+                    posted.wait(current, std::memory_order_acquire);
+#else
+                    std::this_thread::yield();
+#endif
+                    current = posted.load(std::memory_order_acquire);
+                }
+                if (current == UINT64_MAX) {
+                    return;
+                }
+                seen = current;
+                handler(seen);
+            }
+        }
+
+        void post_raw(std::uint64_t value) noexcept {
+            posted.store(value, std::memory_order_release);
+#ifdef RESULT_HAS_ATOMIC_WAIT
+            posted.notify_one();
+#endif
+        }
+
+    public:
+        explicit worker(std::function<void(std::uint64_t)> handler) : posted(0), handler(std::move(handler)), thread([this] { run(); }) {}
+
+        ~worker() {
+            post_raw(UINT64_MAX);
+            thread.join();
+        }
+
+        ///Posts request with sequence number, that must be increasing and non-zero.
+        void post(std::uint64_t seq) noexcept {
+            post_raw(seq);
+        }
+    };
+
+    //Round trip to worker and back, where reply is Result, handed over by slot or by future.
+    void register_all() {
+        bench::add("handoff", "result_slot", {}, [](std::size_t iterations) {
+            result::ResultSlotPool<std::uint64_t, Error> pool(1);
+            result::ResultSlot<std::uint64_t, Error>* current = nullptr;
+            worker server([&current](std::uint64_t seq) {
+                if (seq % 16 == 0) {
+                    current->emplace_err(Error{static_cast<int>(seq)});
+                } else {
+                    current->emplace_ok(seq);
+                }
+            });
+
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                auto& slot = pool.acquire();
+                current = &slot;
+                server.post(idx + 1);
+                bench::do_not_optimize(slot.take().unwrap_or(0));
+                pool.release(slot);
+            }
+        });
+
+        bench::add("handoff", "future", {}, [](std::size_t iterations) {
+            std::promise<Res>* current = nullptr;
+            worker server([&current](std::uint64_t seq) {
+                if (seq % 16 == 0) {
+                    current->set_value(Res::error(Error{static_cast<int>(seq)}));
+                } else {
+                    current->set_value(Res::ok(seq));
+                }
+            });
+
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                std::promise<Res> promise;
+                std::future<Res> future = promise.get_future();
+                current = &promise;
+                server.post(idx + 1);
+                bench::do_not_optimize(future.get().unwrap_or(0));
+            }
+        });
+
+        bench::RegisterReport("handoff_size", [] {
+            bench::report("handoff_size", "result_slot", {}, {{"bytes", static_cast<long long>(sizeof(result::ResultSlot<std::uint64_t, Error>))}});
+        });
+    }
+
+    const bench::Register registered(register_all);
+}
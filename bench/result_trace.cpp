@@ -0,0 +1,80 @@
+#include <cstddef>
+#include <cstdint>
+
+#include <result_trace.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Error {
+        int code;
+    };
+
+    typedef result::Result<int, Error> Plain;
+    typedef result::Result<int, result::Traced<Error>> Traced;
+
+    template<class Res>
+    BENCH_NOINLINE Res parse(int input, bool fail) {
+        if (fail) {
+            return result::Err(Error{input});
+        }
+        return result::Ok(input);
+    }
+
+    //Error passes through two layers before it is handled.
+    template<class Res>
+    BENCH_NOINLINE Res handler(int input, bool fail) {
+        return parse<Res>(input, fail).and_then([fail](int value) {
+            return parse<Res>(value + 1, fail);
+        }).map([](int value) {
+            return value * 2;
+        });
+    }
+
+    //Runs `op(input, fail)` over sequence with given failure rate.
+    template<class Op>
+    bench::Fn over_failures(unsigned percent, Op op) {
+        return [fails = bench::failures(percent), op](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                op(static_cast<int>(idx), fails[idx & bench::failures_mask] != 0);
+            }
+        };
+    }
+
+    //Runs benchmark with given sampling period, restoring disabled sampling afterwards.
+    bench::Fn with_sampling(std::uint32_t period, bench::Fn fn) {
+        return [period, fn](std::size_t iterations) {
+            result::set_trace_sampling(period);
+            fn(iterations);
+            result::set_trace_sampling(0);
+        };
+    }
+
+    void register_all() {
+        for (unsigned percent : {0u, 10u, 100u}) {
+            const bench::Args args = {{"fail_pct", percent}};
+
+            bench::add("trace", "plain", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(handler<Plain>(input, fail));
+            }));
+            bench::add("trace", "traced", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(handler<Traced>(input, fail));
+            }));
+        }
+
+        for (std::uint32_t period : {1000u, 100u, 1u}) {
+            const bench::Args args = {{"fail_pct", 100}, {"sample_period", period}};
+
+            bench::add("trace", "traced/sampled", args, with_sampling(period, over_failures(100, [](int input, bool fail) {
+                bench::do_not_optimize(handler<Traced>(input, fail));
+            })));
+        }
+
+        bench::RegisterReport("trace_size", [] {
+            bench::report("trace_size", "plain", {}, {{"bytes", static_cast<long long>(sizeof(Plain))}});
+            bench::report("trace_size", "traced", {}, {{"bytes", static_cast<long long>(sizeof(Traced))}});
+        });
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -0,0 +1,94 @@
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <result_validation.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    //Request of 200 fields, each of which is checked independently and every failure is reported.
+    constexpr std::size_t field_count = 200;
+    constexpr std::size_t request_count = 64;
+    constexpr std::size_t inline_errors = 16;
+
+    struct FieldError {
+        std::uint32_t field;
+        int value;
+    };
+
+    typedef result::Result<int, FieldError> Field;
+
+    BENCH_NOINLINE Field check_field(std::uint32_t field, int value) {
+        if (value < 0) {
+            return Field::error(FieldError{field, value});
+        }
+        return Field::ok(value);
+    }
+
+    //Requests, in which `percent` out of each 100 fields fail, shifted between requests.
+    std::vector<std::vector<int>> make_requests(long long percent) {
+        std::vector<std::vector<int>> requests(request_count);
+        for (std::size_t request = 0; request < request_count; request++) {
+            for (std::size_t field = 0; field < field_count; field++) {
+                const bool fails = static_cast<long long>((field + request) % 100) < percent;
+                requests[request].push_back(fails ? -1 : static_cast<int>(field));
+            }
+        }
+        return requests;
+    }
+
+    BENCH_NOINLINE result::Result<long, std::vector<FieldError>> validate_vector(const std::vector<int>& fields) {
+        std::vector<FieldError> errors;
+        long sum = 0;
+        for (std::size_t field = 0; field < fields.size(); field++) {
+            const Field checked = check_field(static_cast<std::uint32_t>(field), fields[field]);
+            if (checked.is_err()) {
+                errors.push_back(*checked.error());
+            } else {
+                sum += *checked.value();
+            }
+        }
+
+        if (!errors.empty()) {
+            return result::Result<long, std::vector<FieldError>>::error(std::move(errors));
+        }
+        return result::Result<long, std::vector<FieldError>>::ok(sum);
+    }
+
+    BENCH_NOINLINE result::Result<long, result::SmallVec<FieldError, inline_errors>> validate_inline(const std::vector<int>& fields) {
+        result::Validator<FieldError, inline_errors> validator;
+        long sum = 0;
+        for (std::size_t field = 0; field < fields.size(); field++) {
+            const Field checked = check_field(static_cast<std::uint32_t>(field), fields[field]);
+            if (validator.check(checked)) {
+                sum += *checked.value();
+            }
+        }
+
+        return std::move(validator).finish([sum]() {
+            return sum;
+        }).into_result();
+    }
+
+    template<class Validate>
+    bench::Fn validations(long long percent, Validate validate) {
+        return [requests = make_requests(percent), validate](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                const auto validated = validate(requests[idx % request_count]);
+                bench::do_not_optimize(validated.is_ok() ? *validated.value() : static_cast<long>(validated.error()->size()));
+            }
+        };
+    }
+
+    void register_all() {
+        for (long long percent : {0, 5, 100}) {
+            const bench::Args args = {{"fields", static_cast<long long>(field_count)}, {"failed_percent", percent}};
+            bench::add("validation", "std_vector", args, validations(percent, validate_vector));
+            bench::add("validation", "small_vec/16", args, validations(percent, validate_inline));
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -0,0 +1,113 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <result_vector.hpp>
+
+#include "bench.hpp"
+
+namespace {
+    struct Error {
+        int code;
+    };
+
+    typedef result::Result<std::uint64_t, Error> Row;
+
+    constexpr std::size_t rows_len = 1 << 16;
+
+    //Rows with given failure rate, or with single failure in the last row if percent is 0.
+    std::vector<Row> make_rows(unsigned percent) {
+        const auto fails = bench::failures(percent, rows_len);
+
+        std::vector<Row> rows;
+        rows.reserve(rows_len);
+        for (std::size_t idx = 0; idx < rows_len; idx++) {
+            if (fails[idx] != 0 || (percent == 0 && idx + 1 == rows_len)) {
+                rows.push_back(Row::error(Error{static_cast<int>(idx)}));
+            } else {
+                rows.push_back(Row::ok(idx));
+            }
+        }
+
+        return rows;
+    }
+
+    //Each operation is a scan over all rows.
+    template<class Rows, class Op>
+    bench::Fn over_rows(unsigned percent, Op op) {
+        auto source = make_rows(percent);
+        const auto rows = std::make_shared<const Rows>(std::make_move_iterator(source.begin()), std::make_move_iterator(source.end()));
+
+        return [rows, op](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                bench::do_not_optimize(op(*rows));
+                bench::clobber();
+            }
+        };
+    }
+
+    typedef std::vector<Row> RowVec;
+    typedef result::ResultVector<std::uint64_t, Error> RowSoa;
+
+    void register_all() {
+        for (unsigned percent : {0u, 10u}) {
+            const bench::Args args = {{"rows", static_cast<long long>(rows_len)}, {"fail_pct", percent}};
+
+            bench::add("result_vector", "vector/first_err", args, over_rows<RowVec>(percent, [](const RowVec& rows) {
+                return std::find_if(rows.begin(), rows.end(), [](const Row& row) {
+                    return row.is_err();
+                }) - rows.begin();
+            }));
+            bench::add("result_vector", "soa/first_err", args, over_rows<RowSoa>(percent, [](const RowSoa& rows) {
+                return rows.first_err();
+            }));
+
+            bench::add("result_vector", "vector/count_ok", args, over_rows<RowVec>(percent, [](const RowVec& rows) {
+                return std::count_if(rows.begin(), rows.end(), [](const Row& row) {
+                    return row.is_ok();
+                });
+            }));
+            bench::add("result_vector", "soa/count_ok", args, over_rows<RowSoa>(percent, [](const RowSoa& rows) {
+                return rows.count_ok();
+            }));
+
+            bench::add("result_vector", "vector/sum_ok", args, over_rows<RowVec>(percent, [](const RowVec& rows) {
+                std::uint64_t sum = 0;
+                for (const Row& row : rows) {
+                    if (row.is_ok()) {
+                        sum += *row.value();
+                    }
+                }
+                return sum;
+            }));
+            bench::add("result_vector", "soa/sum_ok", args, over_rows<RowSoa>(percent, [](const RowSoa& rows) {
+                std::uint64_t sum = 0;
+                for (const auto& row : rows.oks()) {
+                    sum += row.value;
+                }
+                return sum;
+            }));
+            bench::add("result_vector", "soa/sum_ok/values", args, over_rows<RowSoa>(percent, [](const RowSoa& rows) {
+                std::uint64_t sum = 0;
+                for (std::uint64_t value : rows.ok_values()) {
+                    sum += value;
+                }
+                return sum;
+            }));
+            bench::add("result_vector", "soa/sum_ok/view", args, over_rows<RowSoa>(percent, [](const RowSoa& rows) {
+                std::uint64_t sum = 0;
+                for (const auto row : rows) {
+                    if (row.is_ok()) {
+                        sum += row.unwrap();
+                    }
+                }
+                return sum;
+            }));
+        }
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -0,0 +1,65 @@
+#include <cstddef>
+#include <string>
+
+#include <result.hpp>
+
+#include "bench.hpp"
+
+//Built into `bench` as is and into `bench_telemetry` with RESULT_TELEMETRY defined,
+//so the same cases report cost of telemetry under different names.
+namespace {
+#ifdef RESULT_TELEMETRY
+    constexpr const char* mode = "on";
+#else
+    constexpr const char* mode = "off";
+#endif
+
+    struct Error {
+        int code;
+    };
+
+    typedef result::Result<int, Error> Res;
+
+    BENCH_NOINLINE Res parse(int input, bool fail) {
+        if (fail) {
+            return Res::error(Error{input});
+        }
+        return Res::ok(input);
+    }
+
+    BENCH_NOINLINE Res handler(int input, bool fail) {
+        return parse(input, fail).map([](int value) {
+            return value + 1;
+        });
+    }
+
+    //Runs `op(input, fail)` over sequence with given failure rate.
+    template<class Op>
+    bench::Fn over_failures(unsigned percent, Op op) {
+        return [fails = bench::failures(percent), op](std::size_t iterations) {
+            for (std::size_t idx = 0; idx < iterations; idx++) {
+                op(static_cast<int>(idx), fails[idx & bench::failures_mask] != 0);
+            }
+        };
+    }
+
+    void register_all() {
+        for (unsigned percent : {0u, 10u, 100u}) {
+            const bench::Args args = {{"fail_pct", percent}};
+            const std::string prefix = std::string(mode) + "/";
+
+            bench::add("telemetry", prefix + "create", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(parse(input, fail));
+            }));
+            bench::add("telemetry", prefix + "propagate", args, over_failures(percent, [](int input, bool fail) {
+                bench::do_not_optimize(handler(input, fail));
+            }));
+        }
+
+        bench::add("telemetry", std::string(mode) + "/unwrap", {}, over_failures(0, [](int input, bool fail) {
+            bench::do_not_optimize(parse(input, fail).unwrap());
+        }));
+    }
+
+    const bench::Register registered(register_all);
+}
@@ -1,8 +1,89 @@
 #pragma once
 
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
+#include "result_location.hpp"
+
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+///Defined when exceptions are enabled.
+#define RESULT_HAS_EXCEPTIONS 1
+#endif
+
+#if !defined(RESULT_PANIC) && !defined(RESULT_HAS_EXCEPTIONS)
+///When defined, failed unwrap calls panic handler instead of throwing.
+///
+///Defined automatically if exceptions are disabled, and can be defined by user otherwise.
+#define RESULT_PANIC 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define RESULT_LIKELY(cond) __builtin_expect(!!(cond), 1)
+#define RESULT_UNLIKELY(cond) __builtin_expect(!!(cond), 0)
+///Moves function out of hot path.
+#define RESULT_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define RESULT_LIKELY(cond) (cond)
+#define RESULT_UNLIKELY(cond) (cond)
+#define RESULT_COLD __declspec(noinline)
+#else
+#define RESULT_LIKELY(cond) (cond)
+#define RESULT_UNLIKELY(cond) (cond)
+#define RESULT_COLD
+#endif
+
+#if defined(__cpp_lib_is_constant_evaluated)
+#define RESULT_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define RESULT_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#ifdef RESULT_IS_CONSTANT_EVALUATED
+///Defined when code can tell constant evaluation apart, so it may do what is not allowed in one at runtime.
+#define RESULT_HAS_IS_CONSTANT_EVALUATED 1
+#else
+#define RESULT_IS_CONSTANT_EVALUATED() false
+#endif
+
+///Trailing parameter, that captures location of caller.
+#define RESULT_CALLER_LOCATION ::result::source_location location = ::result::source_location::current()
+#define RESULT_CALLER_LOCATION_NEXT , RESULT_CALLER_LOCATION
+
+#ifdef RESULT_TELEMETRY
+#include "result_telemetry.hpp"
+///Records telemetry event of error type at location of caller.
+#define RESULT_RECORD_ERROR(E, event) (RESULT_IS_CONSTANT_EVALUATED() ? static_cast<void>(location) : ::result::internal::record_error<E>(::result::error_event::event, location))
+#else
+#define RESULT_RECORD_ERROR(E, event) static_cast<void>(location)
+#endif
+
+#if defined(__cpp_constexpr_dynamic_alloc) && defined(__cpp_lib_is_constant_evaluated)
+///Defined when Result of non-trivial types can be used in constant evaluation.
+#define RESULT_HAS_CONSTEXPR 1
+///Marks function as `constexpr`, when it needs constexpr destructor or `std::construct_at`.
+#define RESULT_CONSTEXPR20 constexpr
+#else
+#define RESULT_CONSTEXPR20
+#endif
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#include <exception>
+#include <new>
+///Defined when Result can be used as coroutine return type.
+#define RESULT_HAS_COROUTINE 1
+#endif
+#endif
+
 namespace result {
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
@@ -10,10 +91,145 @@ namespace internal {
     struct storage_ok_t { constexpr storage_ok_t() noexcept {} };
     struct storage_error_t { constexpr storage_error_t() noexcept {} };
     struct storage_empty_t { constexpr storage_empty_t() noexcept {} };
+    ///Payload is constructed from result of invoking function, allowing copy elision.
+    struct storage_invoke_t { constexpr storage_invoke_t() noexcept {} };
 
     constexpr storage_ok_t storage_ok;
     constexpr storage_error_t storage_error;
     constexpr storage_empty_t storage_empty;
+    constexpr storage_invoke_t storage_invoke;
+
+    ///Empty payload that is stored in place of void.
+    struct unit {};
+
+    ///Size of cache line, which data written by different threads is aligned to, so it never shares one.
+    constexpr std::size_t cache_line = 64;
+
+    ///Payload that is stored in place of reference, pointing to referent.
+    ///
+    ///It is never null once constructed, so null is its niche.
+    template<class T>
+    class ref {
+        T* ptr;
+
+        public:
+            ///Referent type.
+            using type = T;
+
+            constexpr ref(T& value) noexcept : ptr(std::addressof(value)) {}
+            ///Reference to temporary is not allowed, as it would dangle.
+            ref(T&&) = delete;
+            ///Creates niche.
+            constexpr explicit ref(std::nullptr_t) noexcept : ptr(nullptr) {}
+
+            constexpr T& get() const noexcept {
+                return *ptr;
+            }
+
+            constexpr operator T&() const noexcept {
+                return *ptr;
+            }
+
+            constexpr bool is_null() const noexcept {
+                return ptr == nullptr;
+            }
+    };
+
+    ///Maps Result's type to type stored within.
+    template<class T>
+    struct payload {
+        using type = T;
+    };
+
+    template<>
+    struct payload<void> {
+        using type = unit;
+    };
+
+    template<class T>
+    struct payload<T&> {
+        using type = ref<T>;
+    };
+
+    template<class T>
+    using payload_t = typename payload<T>::type;
+
+    template<class T>
+    constexpr bool is_unit = std::is_same<std::remove_cv_t<std::remove_reference_t<T>>, unit>::value;
+
+    template<class T>
+    struct is_ref: std::false_type {};
+
+    template<class T>
+    struct is_ref<ref<T>>: std::true_type {};
+
+    ///Payload reference as it is passed to callbacks, which receive referent of reference payload.
+    template<class Arg, bool = is_ref<std::remove_cv_t<std::remove_reference_t<Arg>>>::value>
+    struct payload_arg {
+        using type = Arg;
+    };
+
+    template<class Arg>
+    struct payload_arg<Arg, true> {
+        using type = typename std::remove_cv_t<std::remove_reference_t<Arg>>::type&;
+    };
+
+    template<class Arg>
+    using payload_arg_t = typename payload_arg<Arg>::type;
+
+    ///Result of invoking Fn with payload, where unit payload is omitted.
+    template<class Fn, class Arg, bool = is_unit<Arg>>
+    struct invoke_payload_result: std::invoke_result<Fn, payload_arg_t<Arg>> {};
+
+    template<class Fn, class Arg>
+    struct invoke_payload_result<Fn, Arg, true>: std::invoke_result<Fn> {};
+
+    template<class Fn, class Arg>
+    using invoke_payload_result_t = typename invoke_payload_result<Fn, Arg>::type;
+
+    template<class Fn, class Arg>
+    constexpr bool is_payload_invocable = is_unit<Arg> ? std::is_invocable<Fn>::value : std::is_invocable<Fn, payload_arg_t<Arg>>::value;
+
+    ///`std::invoke`, that is constexpr before C++20 for anything but member pointers.
+    template<class Fn, class... A>
+    constexpr std::invoke_result_t<Fn, A...> invoke(Fn&& fn, A&&... args) {
+        if constexpr (std::is_member_pointer<std::decay_t<Fn>>::value) {
+            return std::invoke(std::forward<Fn>(fn), std::forward<A>(args)...);
+        } else {
+            return std::forward<Fn>(fn)(std::forward<A>(args)...);
+        }
+    }
+
+    ///Invokes fn with payload, omitting unit payload.
+    template<class Fn, class Arg>
+    constexpr invoke_payload_result_t<Fn, Arg> invoke_payload(Fn&& fn, Arg&& arg) {
+        if constexpr (is_unit<Arg>) {
+            return internal::invoke(std::forward<Fn>(fn));
+        } else {
+            return internal::invoke(std::forward<Fn>(fn), static_cast<payload_arg_t<Arg&&>>(std::forward<Arg>(arg)));
+        }
+    }
+
+    ///Creates payload T from return of fn, that must be void if T is unit.
+    template<class T, class Fn, class Arg>
+    constexpr T make_payload(Fn&& fn, Arg&& arg) {
+        if constexpr (is_unit<T>) {
+            invoke_payload(std::forward<Fn>(fn), std::forward<Arg>(arg));
+            return T();
+        } else {
+            return invoke_payload(std::forward<Fn>(fn), std::forward<Arg>(arg));
+        }
+    }
+
+    ///Constructs T in uninitialized storage, which is allowed in constant evaluation since C++20.
+    template<class T, class... A>
+    RESULT_CONSTEXPR20 void construct_at(T* ptr, A&&... args) noexcept(std::is_nothrow_constructible<T, A...>::value) {
+#ifdef RESULT_HAS_CONSTEXPR
+        std::construct_at(ptr, std::forward<A>(args)...);
+#else
+        ::new(static_cast<void*>(ptr)) T(std::forward<A>(args)...);
+#endif
+    }
 }
 
 //Forward declare itself for Result.
@@ -21,6 +237,97 @@ template<typename T>
 struct is_result;
 #endif
 
+///Handler of failed unwrap, that is used when `RESULT_PANIC` is defined.
+///
+///Handler must not return, otherwise program is aborted right after it.
+using panic_handler = void (*)(const char* message) noexcept;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    inline void default_panic(const char* message) noexcept {
+        std::fputs("Result panicked: ", stderr);
+        std::fputs(message, stderr);
+        std::fputc('\n', stderr);
+    }
+
+    inline std::atomic<panic_handler> panic_hook(&default_panic);
+}
+#endif
+
+///Installs handler of failed unwrap, replacing default one, that prints message and aborts.
+///
+///@param handler New handler or nullptr to restore default one.
+///
+///@returns Previous handler.
+inline panic_handler set_panic_handler(panic_handler handler) noexcept {
+    return internal::panic_hook.exchange(handler != nullptr ? handler : &internal::default_panic, std::memory_order_acq_rel);
+}
+
+///Invokes panic handler and aborts if it returns.
+[[noreturn]] RESULT_COLD inline void panic(const char* message) noexcept {
+    internal::panic_hook.load(std::memory_order_acquire)(message);
+    std::abort();
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Whether error type T captures location of its creation, when constructed from E and location.
+    template<class T, class E>
+    constexpr bool is_located_error = !is_unit<T> && std::is_constructible<T, E, const source_location&>::value;
+
+    ///Whether error is notified when it is propagated by `and_then`.
+    template<class E, class = void>
+    struct has_propagate_hook: std::false_type {};
+
+    template<class E>
+    struct has_propagate_hook<E, std::void_t<decltype(std::declval<E&>().on_propagate(std::declval<const source_location&>()))>>: std::true_type {};
+
+    ///Whether error is notified when `unwrap` fails on it.
+    template<class E, class = void>
+    struct has_unwrap_hook: std::false_type {};
+
+    template<class E>
+    struct has_unwrap_hook<E, std::void_t<decltype(std::declval<const E&>().on_unwrap_failed(std::declval<const source_location&>()))>>: std::true_type {};
+
+    ///Reports unwrap of Err, by throwing copy of its error or panic.
+    ///
+    ///Error that cannot be copied is reported as string.
+    template<class E>
+    [[noreturn]] RESULT_COLD void unwrap_failed(const E& error, const source_location& location) {
+        if constexpr (has_unwrap_hook<E>::value) {
+            error.on_unwrap_failed(location);
+        } else {
+            static_cast<void>(location);
+        }
+#ifdef RESULT_PANIC
+        static_cast<void>(error);
+        panic("Surprisingly no value...");
+#else
+        if constexpr (is_unit<E> || !std::is_copy_constructible<E>::value) {
+            static_cast<void>(error);
+            throw "Surprisingly no value...";
+        } else {
+            throw error;
+        }
+#endif
+    }
+
+    ///Reports unwrap_err of Ok, by throwing or panic.
+    [[noreturn]] RESULT_COLD inline void unwrap_err_failed() {
+#ifdef RESULT_PANIC
+        panic("Surprisingly no error...");
+#else
+        throw "Surprisingly no error...";
+#endif
+    }
+
+    template<class Value, class Error>
+    class promise_base;
+
+    struct result_access;
+}
+#endif
+
 /**
  * Ok variant shortcut.
  *
@@ -47,9 +354,9 @@ class Ok {
         Ok() = delete;
 
         ///Copy constructor that takes value.
-        Ok(const Value& right) noexcept(std::is_nothrow_copy_constructible<Value>::value) : inner(right) {}
+        constexpr Ok(const Value& right) noexcept(std::is_nothrow_copy_constructible<Value>::value) : inner(right) {}
         ///Move constructor that takes value.
-        Ok(Value&& right) noexcept(std::is_nothrow_move_constructible<Value>::value) : inner(std::move(right)) {}
+        constexpr Ok(Value&& right) noexcept(std::is_nothrow_move_constructible<Value>::value) : inner(std::move(right)) {}
 };
 
 /**
@@ -78,11 +385,623 @@ class Err {
         Err() = delete;
 
         ///Copy constructor that takes value.
-        Err(const Value& right) noexcept(std::is_nothrow_copy_constructible<Value>::value) : inner(right) {}
+        constexpr Err(const Value& right) noexcept(std::is_nothrow_copy_constructible<Value>::value) : inner(right) {}
         ///Move constructor that takes value.
-        Err(Value&& right) noexcept(std::is_nothrow_move_constructible<Value>::value) : inner(std::move(right)) {}
+        constexpr Err(Value&& right) noexcept(std::is_nothrow_move_constructible<Value>::value) : inner(std::move(right)) {}
 };
 
+/**
+ * Customization point describing niche of type, i.e. value that is never valid.
+ *
+ * When one of Result's types has niche and other one is empty (e.g. tag type),
+ * Result stores no separate tag and uses niche to encode empty variant instead.
+ *
+ * Niche is opt-in and by default no type has it.
+ * Specialization must provide:
+ *
+ * * `static constexpr bool has_niche = true;`
+ * * `static constexpr T niche() noexcept;` - returns niche value.
+ * * `static constexpr bool is_niche(const T&) noexcept;` - checks whether value is niche.
+ *
+ * Use result::niche_value for common case of single invalid value.
+ *
+ * @note It is user's responsibility to never store niche value as valid payload.
+ *
+ * ## Usage
+ *
+ * ~~~~~~~~~~~~~~~
+ * #include "result.hpp"
+ *
+ * struct NotFound {};
+ *
+ * template<>
+ * struct result::niche_traits<Node*>: result::niche_value<Node*, nullptr> {};
+ *
+ * static_assert(sizeof(result::Result<Node*, NotFound>) == sizeof(Node*));
+ * ~~~~~~~~~~~~~~~
+ */
+template<class T>
+struct niche_traits {
+    ///Whether type has niche.
+    static constexpr bool has_niche = false;
+};
+
+/**
+ * Niche traits for type where single value `Niche` is never valid.
+ *
+ * Inherit result::niche_traits specialization from it.
+ */
+template<class T, T Niche>
+struct niche_value {
+    ///Whether type has niche.
+    static constexpr bool has_niche = true;
+
+    ///@returns Niche value.
+    static constexpr T niche() noexcept {
+        return Niche;
+    }
+
+    ///@returns true If value is niche.
+    static constexpr bool is_niche(const T& value) noexcept {
+        return value == Niche;
+    }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+///Reference payload is never null.
+template<class T>
+struct niche_traits<internal::ref<T>> {
+    static constexpr bool has_niche = true;
+
+    static constexpr internal::ref<T> niche() noexcept {
+        return internal::ref<T>(nullptr);
+    }
+
+    static constexpr bool is_niche(const internal::ref<T>& value) noexcept {
+        return value.is_null();
+    }
+};
+
+namespace internal {
+    ///Storage layout of Result.
+    enum class layout {
+        ///Union with separate tag.
+        tagged,
+        ///Only Value is stored, while empty Error is encoded with Value's niche.
+        niche_ok,
+        ///Only Error is stored, while empty Value is encoded with Error's niche.
+        niche_error
+    };
+
+    ///Whether Niche is able to encode Empty without tag.
+    template<class Niche, class Empty>
+    constexpr bool can_encode_in_niche = niche_traits<Niche>::has_niche
+                                         && std::is_empty<Empty>::value && !std::is_final<Empty>::value
+                                         && std::is_default_constructible<Empty>::value
+                                         && std::is_trivially_copyable<Niche>::value && std::is_trivially_copyable<Empty>::value
+                                         && std::is_trivially_move_constructible<Niche>::value && std::is_trivially_move_constructible<Empty>::value
+                                         && std::is_trivially_move_assignable<Niche>::value && std::is_trivially_move_assignable<Empty>::value;
+
+    template<class Value, class Error>
+    struct traits {
+        static constexpr internal::layout storage_layout = can_encode_in_niche<Value, Error> ? layout::niche_ok
+                                                 : can_encode_in_niche<Error, Value> ? layout::niche_error
+                                                 : layout::tagged;
+
+        static constexpr bool is_value_trivially_destructible = std::is_trivially_destructible<Value>::value;
+        static constexpr bool is_error_trivially_destructible = std::is_trivially_destructible<Error>::value;
+        static constexpr bool is_trivially_destructible = is_value_trivially_destructible && is_error_trivially_destructible;
+        static constexpr bool is_trivially_move_constructible = std::is_trivially_move_constructible<Value>::value && std::is_trivially_move_constructible<Error>::value;
+        static constexpr bool is_trivially_move_assignable = is_trivially_destructible && is_trivially_move_constructible
+                                                             && std::is_trivially_move_assignable<Value>::value && std::is_trivially_move_assignable<Error>::value;
+
+        static constexpr bool is_copy_constructible = std::is_copy_constructible<Value>::value && std::is_copy_constructible<Error>::value;
+        static constexpr bool is_copy_assignable = is_copy_constructible && std::is_copy_assignable<Value>::value && std::is_copy_assignable<Error>::value;
+        static constexpr bool is_trivially_copy_constructible = std::is_trivially_copy_constructible<Value>::value && std::is_trivially_copy_constructible<Error>::value;
+        static constexpr bool is_trivially_copy_assignable = is_trivially_destructible && is_trivially_copy_constructible
+                                                             && std::is_trivially_copy_assignable<Value>::value && std::is_trivially_copy_assignable<Error>::value;
+
+        static constexpr bool is_destructor_noexcept = std::is_nothrow_destructible<Value>::value && std::is_nothrow_destructible<Error>::value;
+        ///Whether replacing payload may leave nothing, as neither new payload nor previous one can be moved without throwing.
+        static constexpr bool may_be_valueless = !(std::is_nothrow_move_constructible<Value>::value || (std::is_move_assignable<Value>::value && std::is_nothrow_move_constructible<Error>::value))
+                                                 || !(std::is_nothrow_move_constructible<Error>::value || (std::is_move_assignable<Error>::value && std::is_nothrow_move_constructible<Value>::value));
+        static constexpr bool is_move_const_noexcept = std::is_nothrow_move_constructible<Value>::value && std::is_nothrow_move_constructible<Error>::value;
+        static constexpr bool is_move_assignment_noexcept = is_destructor_noexcept && is_move_const_noexcept
+                                                            && std::is_nothrow_move_assignable<Value>::value && std::is_nothrow_move_assignable<Error>::value;
+        static constexpr bool is_copy_const_noexcept = std::is_nothrow_copy_constructible<Value>::value && std::is_nothrow_copy_constructible<Error>::value;
+        static constexpr bool is_copy_assignment_noexcept = is_destructor_noexcept && is_copy_const_noexcept
+                                                            && std::is_nothrow_copy_assignable<Value>::value && std::is_nothrow_copy_assignable<Error>::value;
+    };
+
+    enum class type: unsigned char {
+        ok,
+        error,
+        ///Nothing is constructed, either while storage is being constructed or after replacing payload threw.
+        pending
+    };
+
+    ///Raw union storage.
+    ///
+    ///Destructor is trivial only when both types are trivially destructible,
+    ///otherwise it is empty and actual destructor is invoked by owner.
+    template<class Value, class Error, bool = traits<Value, Error>::is_trivially_destructible>
+    union storage {
+        Value ok;
+        Error error;
+
+        ///construct value
+        template<class... A>
+        constexpr explicit storage(storage_ok_t, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) : ok(std::forward<A>(a)...) {}
+
+        ///construct value from fn's return
+        template<class Fn, class A>
+        constexpr explicit storage(storage_ok_t, storage_invoke_t, Fn&& fn, A&& a) : ok(make_payload<Value>(std::forward<Fn>(fn), std::forward<A>(a))) {}
+
+        ///construct error
+        template<class... A>
+        constexpr explicit storage(storage_error_t, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) : error(std::forward<A>(a)...) {}
+
+        ///construct error from fn's return
+        template<class Fn, class A>
+        constexpr explicit storage(storage_error_t, storage_invoke_t, Fn&& fn, A&& a) : error(make_payload<Error>(std::forward<Fn>(fn), std::forward<A>(a))) {}
+
+        ///Empty constructor for Result's copy/move
+        RESULT_CONSTEXPR20 explicit storage(storage_empty_t) noexcept {}
+    };
+
+    template<class Value, class Error>
+    union storage<Value, Error, false> {
+        Value ok;
+        Error error;
+
+        ///construct value
+        template<class... A>
+        constexpr explicit storage(storage_ok_t, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) : ok(std::forward<A>(a)...) {}
+
+        ///construct value from fn's return
+        template<class Fn, class A>
+        constexpr explicit storage(storage_ok_t, storage_invoke_t, Fn&& fn, A&& a) : ok(make_payload<Value>(std::forward<Fn>(fn), std::forward<A>(a))) {}
+
+        ///construct error
+        template<class... A>
+        constexpr explicit storage(storage_error_t, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) : error(std::forward<A>(a)...) {}
+
+        ///construct error from fn's return
+        template<class Fn, class A>
+        constexpr explicit storage(storage_error_t, storage_invoke_t, Fn&& fn, A&& a) : error(make_payload<Error>(std::forward<Fn>(fn), std::forward<A>(a))) {}
+
+        ///Empty constructor for Result's copy/move
+        RESULT_CONSTEXPR20 explicit storage(storage_empty_t) noexcept {}
+
+        ///Empty destructor.
+        ///
+        ///Actual destructor is invoked from storage_dtor.
+        RESULT_CONSTEXPR20 ~storage() noexcept {}
+    };
+
+    ///Common part of storage, provides tagged access to union.
+    template<class Value, class Error, layout = traits<Value, Error>::storage_layout>
+    struct storage_base {
+        using traits = internal::traits<Value, Error>;
+
+        //Tag precedes payload, so that padding is inside rather than at the tail, which derived layers could reuse.
+        //Otherwise GCC copies base as separate fields and cannot keep Result in registers, while size is the same either way.
+        type variant;
+        storage<Value, Error> store;
+
+        template<class... A>
+        constexpr explicit storage_base(storage_ok_t tag, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) : variant(type::ok), store(tag, std::forward<A>(a)...) {}
+
+        template<class... A>
+        constexpr explicit storage_base(storage_error_t tag, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) : variant(type::error), store(tag, std::forward<A>(a)...) {}
+
+        ///Leaves storage uninitialized, caller must construct one of variants.
+        RESULT_CONSTEXPR20 explicit storage_base(storage_empty_t tag, type variant) noexcept : variant(variant), store(tag) {}
+
+        constexpr bool holds_ok() const noexcept {
+            return variant == type::ok;
+        }
+
+        constexpr bool holds_error() const noexcept {
+            if constexpr (traits::may_be_valueless) {
+                return variant == type::error;
+            } else {
+                return variant != type::ok;
+            }
+        }
+
+        ///Panics on access to payload of valueless storage, which is otherwise unreachable.
+        constexpr void expect_payload() const noexcept {
+            if constexpr (traits::may_be_valueless) {
+                if (RESULT_UNLIKELY(variant == type::pending)) {
+                    panic("Result is valueless...");
+                }
+            }
+        }
+
+        constexpr Value& ok_ref() noexcept {
+            expect_payload();
+            return store.ok;
+        }
+        constexpr const Value& ok_ref() const noexcept {
+            expect_payload();
+            return store.ok;
+        }
+
+        constexpr Error& error_ref() noexcept {
+            expect_payload();
+            return store.error;
+        }
+        constexpr const Error& error_ref() const noexcept {
+            expect_payload();
+            return store.error;
+        }
+
+        ///Destroys currently stored variant, if required.
+        RESULT_CONSTEXPR20 void destroy() noexcept(traits::is_destructor_noexcept) {
+            if constexpr (!traits::is_value_trivially_destructible) {
+                if (variant == type::ok) {
+                    store.ok.~Value();
+                }
+            }
+
+            if constexpr (!traits::is_error_trivially_destructible) {
+                if (variant == type::error) {
+                    store.error.~Error();
+                }
+            }
+        }
+
+        ///Replaces stored variant with T constructed from arguments.
+        ///
+        ///If construction can throw, but move of T cannot, T is constructed aside first, so nothing changes on exception.
+        ///Otherwise T of the same variant is constructed aside and move assigned, leaving it as its assignment does,
+        ///while payload of the other variant is moved aside and restored on exception, if its move cannot throw.
+        ///Only when none applies exception leaves storage pending, with nothing constructed.
+        template<class T, class Other, class... A>
+        RESULT_CONSTEXPR20 T& replace(T& slot, type target, Other& other, type other_target, A&&... a) noexcept(traits::is_destructor_noexcept && std::is_nothrow_constructible<T, A...>::value) {
+            if constexpr (std::is_nothrow_constructible<T, A...>::value) {
+                destroy();
+                internal::construct_at(&slot, std::forward<A>(a)...);
+            } else if constexpr (std::is_nothrow_move_constructible<T>::value) {
+                T temp(std::forward<A>(a)...);
+                destroy();
+                internal::construct_at(&slot, std::move(temp));
+            } else {
+                if constexpr (std::is_move_assignable<T>::value) {
+                    if (variant == target) {
+                        T temp(std::forward<A>(a)...);
+                        slot = std::move(temp);
+                        return slot;
+                    }
+                }
+#ifdef RESULT_HAS_EXCEPTIONS
+                if constexpr (std::is_nothrow_move_constructible<Other>::value) {
+                    if (variant == other_target) {
+                        Other kept(std::move(other));
+                        destroy();
+                        variant = type::pending;
+                        try {
+                            internal::construct_at(&slot, std::forward<A>(a)...);
+                        } catch (...) {
+                            internal::construct_at(&other, std::move(kept));
+                            variant = other_target;
+                            throw;
+                        }
+                        variant = target;
+                        return slot;
+                    }
+                }
+#endif
+                destroy();
+                variant = type::pending;
+                internal::construct_at(&slot, std::forward<A>(a)...);
+            }
+            variant = target;
+            return slot;
+        }
+
+        template<class... A>
+        RESULT_CONSTEXPR20 Value& emplace(storage_ok_t, A&&... a) noexcept(traits::is_destructor_noexcept && std::is_nothrow_constructible<Value, A...>::value) {
+            return replace(store.ok, type::ok, store.error, type::error, std::forward<A>(a)...);
+        }
+
+        template<class... A>
+        RESULT_CONSTEXPR20 Error& emplace(storage_error_t, A&&... a) noexcept(traits::is_destructor_noexcept && std::is_nothrow_constructible<Error, A...>::value) {
+            return replace(store.error, type::error, store.ok, type::ok, std::forward<A>(a)...);
+        }
+
+        ///Constructs variant of right in uninitialized storage, which must be pending until it succeeds.
+        RESULT_CONSTEXPR20 void construct_from(storage_base&& right) noexcept(traits::is_move_const_noexcept) {
+            switch (right.variant) {
+                case type::ok: internal::construct_at(&store.ok, std::move(right.store.ok)); break;
+                case type::error: internal::construct_at(&store.error, std::move(right.store.error)); break;
+                case type::pending: break;
+            }
+            variant = right.variant;
+        }
+
+        ///Copies variant of right into uninitialized storage, which must be pending until it succeeds.
+        RESULT_CONSTEXPR20 void construct_from(const storage_base& right) noexcept(traits::is_copy_const_noexcept) {
+            switch (right.variant) {
+                case type::ok: internal::construct_at(&store.ok, right.store.ok); break;
+                case type::error: internal::construct_at(&store.error, right.store.error); break;
+                case type::pending: break;
+            }
+            variant = right.variant;
+        }
+
+        ///Assigns right, re-using current payload if variant is the same.
+        template<class Right>
+        RESULT_CONSTEXPR20 void assign_from(Right&& right) {
+            if (right.variant == variant) {
+                switch (variant) {
+                    case type::ok: store.ok = std::forward<Right>(right).store.ok; break;
+                    case type::error: store.error = std::forward<Right>(right).store.error; break;
+                    case type::pending: break;
+                }
+                return;
+            }
+
+            //Since different type we should clean up old value.
+            switch (right.variant) {
+                case type::ok: emplace(storage_ok, std::forward<Right>(right).store.ok); break;
+                case type::error: emplace(storage_error, std::forward<Right>(right).store.error); break;
+                case type::pending:
+                    destroy();
+                    variant = type::pending;
+                    break;
+            }
+        }
+    };
+
+    ///Storage of niche payload and empty type.
+    ///
+    ///Empty type occupies no space due to empty base optimization.
+    template<class Niche, class Empty>
+    struct compact_storage: Empty {
+        Niche payload;
+
+        ///construct payload
+        template<class... A>
+        constexpr explicit compact_storage(storage_ok_t, A&&... a) noexcept(std::is_nothrow_constructible<Niche, A...>::value) : Empty(), payload(std::forward<A>(a)...) {}
+
+        ///construct payload from fn's return
+        template<class Fn, class A>
+        constexpr explicit compact_storage(storage_ok_t, storage_invoke_t, Fn&& fn, A&& a) : Empty(), payload(make_payload<Niche>(std::forward<Fn>(fn), std::forward<A>(a))) {}
+
+        ///construct empty type, marking payload with niche.
+        template<class... A>
+        constexpr explicit compact_storage(storage_error_t, A&&... a) noexcept(std::is_nothrow_constructible<Empty, A...>::value) : Empty(std::forward<A>(a)...), payload(niche_traits<Niche>::niche()) {}
+
+        ///construct empty type from fn's return
+        template<class Fn, class A>
+        constexpr explicit compact_storage(storage_error_t, storage_invoke_t, Fn&& fn, A&& a) : Empty(make_payload<Empty>(std::forward<Fn>(fn), std::forward<A>(a))), payload(niche_traits<Niche>::niche()) {}
+
+        ///Leaves payload uninitialized, caller must construct one of variants.
+        RESULT_CONSTEXPR20 explicit compact_storage(storage_empty_t) noexcept : Empty() {}
+
+        constexpr bool holds_payload() const noexcept {
+            return !niche_traits<Niche>::is_niche(payload);
+        }
+    };
+
+    ///Value with niche, Error is empty type.
+    ///
+    ///Both types are trivially copyable, so there is nothing to destroy or move manually.
+    template<class Value, class Error>
+    struct storage_base<Value, Error, layout::niche_ok> {
+        compact_storage<Value, Error> store;
+
+        template<class... A>
+        constexpr explicit storage_base(storage_ok_t tag, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) : store(tag, std::forward<A>(a)...) {}
+
+        template<class... A>
+        constexpr explicit storage_base(storage_error_t tag, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) : store(tag, std::forward<A>(a)...) {}
+
+        RESULT_CONSTEXPR20 explicit storage_base(storage_empty_t tag, type) noexcept : store(tag) {}
+
+        template<class... A>
+        constexpr Value& emplace(storage_ok_t tag, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) {
+            store = compact_storage<Value, Error>(tag, std::forward<A>(a)...);
+            return store.payload;
+        }
+
+        template<class... A>
+        constexpr Error& emplace(storage_error_t tag, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) {
+            store = compact_storage<Value, Error>(tag, std::forward<A>(a)...);
+            return store;
+        }
+
+        constexpr bool holds_ok() const noexcept {
+            return store.holds_payload();
+        }
+
+        constexpr bool holds_error() const noexcept {
+            return !store.holds_payload();
+        }
+
+        constexpr Value& ok_ref() noexcept {
+            return store.payload;
+        }
+        constexpr const Value& ok_ref() const noexcept {
+            return store.payload;
+        }
+
+        constexpr Error& error_ref() noexcept {
+            return store;
+        }
+        constexpr const Error& error_ref() const noexcept {
+            return store;
+        }
+    };
+
+    ///Error with niche, Value is empty type.
+    ///
+    ///Both types are trivially copyable, so there is nothing to destroy or move manually.
+    template<class Value, class Error>
+    struct storage_base<Value, Error, layout::niche_error> {
+        compact_storage<Error, Value> store;
+
+        template<class... A>
+        constexpr explicit storage_base(storage_ok_t, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) : store(storage_error, std::forward<A>(a)...) {}
+
+        template<class... A>
+        constexpr explicit storage_base(storage_error_t, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) : store(storage_ok, std::forward<A>(a)...) {}
+
+        RESULT_CONSTEXPR20 explicit storage_base(storage_empty_t tag, type) noexcept : store(tag) {}
+
+        template<class... A>
+        constexpr Value& emplace(storage_ok_t, A&&... a) noexcept(std::is_nothrow_constructible<Value, A...>::value) {
+            store = compact_storage<Error, Value>(storage_error, std::forward<A>(a)...);
+            return store;
+        }
+
+        template<class... A>
+        constexpr Error& emplace(storage_error_t, A&&... a) noexcept(std::is_nothrow_constructible<Error, A...>::value) {
+            store = compact_storage<Error, Value>(storage_ok, std::forward<A>(a)...);
+            return store.payload;
+        }
+
+        constexpr bool holds_ok() const noexcept {
+            return !store.holds_payload();
+        }
+
+        constexpr bool holds_error() const noexcept {
+            return store.holds_payload();
+        }
+
+        constexpr Value& ok_ref() noexcept {
+            return store;
+        }
+        constexpr const Value& ok_ref() const noexcept {
+            return store;
+        }
+
+        constexpr Error& error_ref() noexcept {
+            return store.payload;
+        }
+        constexpr const Error& error_ref() const noexcept {
+            return store.payload;
+        }
+    };
+
+    ///Destructor layer, trivial if both types are trivially destructible.
+    template<class Value, class Error, bool = traits<Value, Error>::is_trivially_destructible>
+    struct storage_dtor: storage_base<Value, Error> {
+        using storage_base<Value, Error>::storage_base;
+    };
+
+    template<class Value, class Error>
+    struct storage_dtor<Value, Error, false>: storage_base<Value, Error> {
+        using storage_base<Value, Error>::storage_base;
+
+        storage_dtor(storage_dtor&&) = default;
+        storage_dtor(const storage_dtor&) = default;
+        storage_dtor& operator=(storage_dtor&&) = default;
+        storage_dtor& operator=(const storage_dtor&) = default;
+
+        RESULT_CONSTEXPR20 ~storage_dtor() noexcept(traits<Value, Error>::is_destructor_noexcept) {
+            this->destroy();
+        }
+    };
+
+    ///Move constructor layer, trivial if both types are trivially move constructible.
+    template<class Value, class Error, bool = traits<Value, Error>::is_trivially_move_constructible>
+    struct storage_move_ctor: storage_dtor<Value, Error> {
+        using storage_dtor<Value, Error>::storage_dtor;
+    };
+
+    template<class Value, class Error>
+    struct storage_move_ctor<Value, Error, false>: storage_dtor<Value, Error> {
+        using storage_dtor<Value, Error>::storage_dtor;
+
+        RESULT_CONSTEXPR20 storage_move_ctor(storage_move_ctor&& right) noexcept(traits<Value, Error>::is_move_const_noexcept) : storage_dtor<Value, Error>(storage_empty, type::pending) {
+            this->construct_from(std::move(right));
+        }
+        storage_move_ctor(const storage_move_ctor&) = default;
+        storage_move_ctor& operator=(storage_move_ctor&&) = default;
+        storage_move_ctor& operator=(const storage_move_ctor&) = default;
+    };
+
+    ///Copy constructor layer, trivial if both types are trivially copy constructible and deleted if either is not copyable.
+    template<class Value, class Error, bool = traits<Value, Error>::is_trivially_copy_constructible, bool = traits<Value, Error>::is_copy_constructible>
+    struct storage_copy_ctor: storage_move_ctor<Value, Error> {
+        using storage_move_ctor<Value, Error>::storage_move_ctor;
+    };
+
+    template<class Value, class Error>
+    struct storage_copy_ctor<Value, Error, false, true>: storage_move_ctor<Value, Error> {
+        using storage_move_ctor<Value, Error>::storage_move_ctor;
+
+        storage_copy_ctor(storage_copy_ctor&&) = default;
+        RESULT_CONSTEXPR20 storage_copy_ctor(const storage_copy_ctor& right) noexcept(traits<Value, Error>::is_copy_const_noexcept) : storage_move_ctor<Value, Error>(storage_empty, type::pending) {
+            this->construct_from(right);
+        }
+        storage_copy_ctor& operator=(storage_copy_ctor&&) = default;
+        storage_copy_ctor& operator=(const storage_copy_ctor&) = default;
+    };
+
+    template<class Value, class Error>
+    struct storage_copy_ctor<Value, Error, false, false>: storage_move_ctor<Value, Error> {
+        using storage_move_ctor<Value, Error>::storage_move_ctor;
+
+        storage_copy_ctor(storage_copy_ctor&&) = default;
+        storage_copy_ctor(const storage_copy_ctor&) = delete;
+        storage_copy_ctor& operator=(storage_copy_ctor&&) = default;
+        storage_copy_ctor& operator=(const storage_copy_ctor&) = default;
+    };
+
+    ///Move assignment layer, trivial if both types are trivially move assignable.
+    template<class Value, class Error, bool = traits<Value, Error>::is_trivially_move_assignable>
+    struct storage_move_assign: storage_copy_ctor<Value, Error> {
+        using storage_copy_ctor<Value, Error>::storage_copy_ctor;
+    };
+
+    template<class Value, class Error>
+    struct storage_move_assign<Value, Error, false>: storage_copy_ctor<Value, Error> {
+        using storage_copy_ctor<Value, Error>::storage_copy_ctor;
+
+        storage_move_assign(storage_move_assign&&) = default;
+        storage_move_assign(const storage_move_assign&) = default;
+        RESULT_CONSTEXPR20 storage_move_assign& operator=(storage_move_assign&& right) noexcept(traits<Value, Error>::is_move_assignment_noexcept) {
+            this->assign_from(std::move(right));
+            return *this;
+        }
+        storage_move_assign& operator=(const storage_move_assign&) = default;
+    };
+
+    ///Copy assignment layer, trivial if both types are trivially copy assignable and deleted if either is not copyable.
+    template<class Value, class Error, bool = traits<Value, Error>::is_trivially_copy_assignable, bool = traits<Value, Error>::is_copy_assignable>
+    struct storage_copy_assign: storage_move_assign<Value, Error> {
+        using storage_move_assign<Value, Error>::storage_move_assign;
+    };
+
+    template<class Value, class Error>
+    struct storage_copy_assign<Value, Error, false, true>: storage_move_assign<Value, Error> {
+        using storage_move_assign<Value, Error>::storage_move_assign;
+
+        storage_copy_assign(storage_copy_assign&&) = default;
+        storage_copy_assign(const storage_copy_assign&) = default;
+        storage_copy_assign& operator=(storage_copy_assign&&) = default;
+        RESULT_CONSTEXPR20 storage_copy_assign& operator=(const storage_copy_assign& right) noexcept(traits<Value, Error>::is_copy_assignment_noexcept) {
+            this->assign_from(right);
+            return *this;
+        }
+    };
+
+    template<class Value, class Error>
+    struct storage_copy_assign<Value, Error, false, false>: storage_move_assign<Value, Error> {
+        using storage_move_assign<Value, Error>::storage_move_assign;
+
+        storage_copy_assign(storage_copy_assign&&) = default;
+        storage_copy_assign(const storage_copy_assign&) = default;
+        storage_copy_assign& operator=(storage_copy_assign&&) = default;
+        storage_copy_assign& operator=(const storage_copy_assign&) = delete;
+    };
+}
+#endif
+
 /**
  * Result type that represents two-possible outcomes:
  *
@@ -110,58 +1029,142 @@ class Err {
  * ~~~~~~~~~~~~~~~
  *
  * The intention is to create similar to Rust [Result](https://doc.rust-lang.org/std/result/enum.Result.html) type.
+ *
+ * ## Triviality
+ *
+ * Destructor, copy and move constructors and assignments are trivial whenever they are trivial for both `Value` and `Error`.
+ * This makes Result of trivial types, like `Result<int, int>`, to be passed and returned in registers.
+ *
+ * Copy is available only when both `Value` and `Error` are copyable.
+ * Assignment of the same variant assigns content, so e.g. `std::string` keeps its buffer,
+ * while assignment of the other variant and `emplace_ok`/`emplace_err` destroy content and construct new one.
+ * If that construction throws, previous content is kept whenever it can be, see `emplace_ok`.
+ *
+ * ## Constant evaluation
+ *
+ * Result of literal types can be created and consumed in constant expressions, including `map` and `and_then`.
+ * Before C++20 it is limited to trivially destructible types, while with C++20, when `RESULT_HAS_CONSTEXPR` is defined,
+ * any types with constexpr destructor can be used, so parsers can be `consteval` and bad input fails the build.
+ *
+ * ~~~~~~~~~~~~~~~
+ * consteval result::Result<Config, ParseError> parse_config(std::string_view text);
+ *
+ * constexpr Config config = parse_config(CONFIG_TEXT).unwrap();
+ * ~~~~~~~~~~~~~~~
+ *
+ * ## Reference
+ *
+ * `Value` can be lvalue reference, in which case Result stores pointer to referent, so lookup doesn't copy what it found.
+ * If `Error` is empty type, null pointer encodes Error and Result is of pointer size.
+ * `unwrap` and `value` yield referent even on const Result, callbacks of `map`, `and_then` and etc receive referent
+ * and assignment rebinds reference. `Error` cannot be reference.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<const Entry&, NotFound> find(const Table& table, Key key);
+ *
+ * const Entry& entry = find(table, key).unwrap();
+ * auto size = find(table, key).map([](const Entry& entry) {
+ *     return entry.size;
+ * });
+ * ~~~~~~~~~~~~~~~
+ *
+ * ## Void
+ *
+ * Either `Value` or `Error` can be `void`, in which case it takes no space.
+ * Factory of void variant accepts no arguments, callbacks of `map`, `and_then` and etc accept no arguments
+ * and `unwrap` returns nothing.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<void, std::error_code> write_all();
+ *
+ * auto written = write_all().map([]() {
+ *     return 1;
+ * });
+ * ~~~~~~~~~~~~~~~
+ *
+ * ## Panic
+ *
+ * By default failed `unwrap` throws content of Error and failed `unwrap_err` throws string.
+ * If `RESULT_PANIC` is defined, which is the case when exceptions are disabled,
+ * they call handler installed by `result::set_panic_handler` instead.
+ * In both cases failure path is out of line, so it doesn't bloat caller.
+ *
+ * ## Telemetry
+ *
+ * If `RESULT_TELEMETRY` is defined, creation of Err and failed unwraps are counted per error type
+ * and call site, see `result_telemetry.hpp`. Err that is only propagated, e.g. by `map`, is not counted.
+ * Otherwise there is no overhead at all.
+ *
+ * ## Error context
+ *
+ * Error type may opt in to receive location of its creation by being constructible from argument of `error`
+ * or content of `Err` followed by `result::source_location`.
+ * It may also define `on_propagate(const result::source_location&)`, which is called when `and_then`
+ * passes it through, and `on_unwrap_failed(const result::source_location&) const`, which is called before
+ * failed `unwrap` throws or panics. `result::Traced` in `result_trace.hpp` uses them to build context trail.
+ * Location is passed as default argument, so Result of any other error is not affected.
  */
 template<class Value, class Error>
-class Result {
-    //It might be a bad idea to allow Value and Error to be the same
-    //but for now lets leave it as it is.
-    static_assert(!std::is_void<Value>::value, "Result Value cannot be void");
-    static_assert(!std::is_void<Error>::value, "Result Error cannot be void");
-
-    private:
-        static constexpr bool is_value_trivially_destructible = std::is_trivially_destructible<Value>::value;
-        static constexpr bool is_error_trivially_destructible = std::is_trivially_destructible<Error>::value;
-        static constexpr bool is_trivially_destructible = is_value_trivially_destructible && is_error_trivially_destructible;
-
-        union storage {
-            Value ok;
-            Error error;
+class Result: private internal::storage_copy_assign<internal::payload_t<Value>, internal::payload_t<Error>> {
+    template<class, class>
+    friend class Result;
+    friend class internal::promise_base<Value, Error>;
+    friend struct internal::result_access;
 
-            static constexpr bool is_value_noexcept = std::is_nothrow_constructible<Value>::value;
-            static constexpr bool is_error_noexcept = std::is_nothrow_constructible<Error>::value;
+    static_assert(!std::is_reference<Error>::value, "Error cannot be reference");
 
-            ///construct value
-            template<class... A>
-            explicit storage(internal::storage_ok_t, A&&... a) noexcept(is_value_noexcept) : ok(std::forward<A>(a)...) {}
-
-            ///construct error
-            template<class... A>
-            explicit storage(internal::storage_error_t, A&&... a) noexcept(is_error_noexcept) : error(std::forward<A>(a)...) {}
+    private:
+        using value_type = internal::payload_t<Value>;
+        using error_type = internal::payload_t<Error>;
+        using base = internal::storage_copy_assign<value_type, error_type>;
 
-            ///Empty constructor for Result's copy/move
-            explicit storage(internal::storage_empty_t) noexcept {}
+        //Reference payload yields its referent regardless of Result's constness.
+        using value_reference = std::conditional_t<std::is_void<Value>::value, void, internal::payload_arg_t<value_type&>>;
+        using const_value_reference = std::conditional_t<std::is_void<Value>::value, void, internal::payload_arg_t<const value_type&>>;
+        using value_pointer = std::add_pointer_t<value_reference>;
+        using const_value_pointer = std::add_pointer_t<const_value_reference>;
+        using error_reference = std::conditional_t<std::is_void<Error>::value, void, error_type&>;
+        using const_error_reference = std::conditional_t<std::is_void<Error>::value, void, const error_type&>;
 
-            ///Empty destructor.
-            ///
-            ///Actual destructor is invoked from ~Result().
-            ~storage() noexcept {}
-        };
+        template<class... A>
+        constexpr explicit Result(internal::storage_ok_t tag, A&&... value) noexcept(std::is_nothrow_constructible<value_type, A...>::value) : base(tag, std::forward<A>(value)...) {}
 
-        enum class type: unsigned char {
-            ok,
-            error
-        };
+        template<class... A>
+        constexpr explicit Result(internal::storage_error_t tag, A&&... error) noexcept(std::is_nothrow_constructible<error_type, A...>::value) : base(tag, std::forward<A>(error)...) {}
 
-        type variant;
-        storage store;
+        ///Leaves storage uninitialized, so that it is overwritten as whole.
+        RESULT_CONSTEXPR20 explicit Result(internal::storage_empty_t tag) noexcept : base(tag, internal::type::pending) {}
 
-        static constexpr bool is_constructor_noexcept = storage::is_value_noexcept && storage::is_error_noexcept;
-        static constexpr bool is_destructor_noexcept = std::is_nothrow_destructible<Value>::value && std::is_nothrow_destructible<Error>::value;
-        static constexpr bool is_move_const_noexcept = std::is_nothrow_move_constructible<Value>::value && std::is_nothrow_move_constructible<Error>::value;
-        static constexpr bool is_move_assignment_noexcept = std::is_nothrow_move_assignable<Value>::value && std::is_nothrow_move_assignable<Error>::value;
+        ///Moves itself out as whole, when combinator passes Result through unchanged.
+        ///
+        ///GCC splits copy of fields into tag and payload, which it packs back into register on return,
+        ///so trivially copyable tagged Result is copied as bytes instead, which it keeps in single register.
+        template<bool Bytes = std::is_trivially_copyable<base>::value && internal::traits<value_type, error_type>::storage_layout == internal::layout::tagged>
+        constexpr Result pass_through() && noexcept(internal::traits<value_type, error_type>::is_move_const_noexcept) {
+#if defined(__GNUC__) && !defined(__clang__) && defined(RESULT_HAS_IS_CONSTANT_EVALUATED)
+            if constexpr (Bytes) {
+                if (!RESULT_IS_CONSTANT_EVALUATED()) {
+                    Result out(internal::storage_empty);
+                    std::memcpy(static_cast<void*>(&out), static_cast<const void*>(this), sizeof(Result));
+                    return out;
+                }
+            }
+#endif
+            return std::move(*this);
+        }
 
-        template<class... A>
-        explicit Result(type variant, A&&... value) noexcept(is_constructor_noexcept) : variant(variant), store(std::forward<A>(value)...) {}
+        ///Creates Result with error propagated by `and_then`, notifying error about location of propagation.
+        template<class E>
+        static constexpr Result propagate_error(E&& error, const source_location& location) {
+            if constexpr (internal::has_propagate_hook<error_type>::value) {
+                Result result(internal::storage_error, std::forward<E>(error));
+                result.error_ref().on_propagate(location);
+                return result;
+            } else {
+                static_cast<void>(location);
+                return Result(internal::storage_error, std::forward<E>(error));
+            }
+        }
 
     public:
         ///OK type
@@ -173,82 +1176,138 @@ class Result {
         Result() = delete;
 
         ///Creates Ok variant.
+        ///
+        ///If `Value` is `void`, no arguments are accepted.
         template<class... T>
-        static Result<Value, Error> ok(T&&... value) noexcept(storage::is_value_noexcept) {
-            return Result<Value, Error>(type::ok, internal::storage_ok, std::forward<T>(value)...);
+        static constexpr Result<Value, Error> ok(T&&... value) noexcept(std::is_nothrow_constructible<value_type, T...>::value) {
+            return Result<Value, Error>(internal::storage_ok, std::forward<T>(value)...);
         }
 
         ///Creates Error variant.
-        template<class... E>
-        static Result<Value, Error> error(E&&... error) noexcept(storage::is_error_noexcept) {
-            return Result<Value, Error>(type::error, internal::storage_error, std::forward<E>(error)...);
+        ///
+        ///If `Error` is `void`, no arguments are accepted.
+        template<class V = Error, typename = std::enable_if_t<std::is_void<V>::value>>
+        static constexpr Result<Value, Error> error(RESULT_CALLER_LOCATION) noexcept {
+            RESULT_RECORD_ERROR(Error, created);
+            return Result<Value, Error>(internal::storage_error);
         }
-
-        ///Destructor that invokes, if required, underlying storage's destructor.
-        ~Result() noexcept(is_destructor_noexcept) {
-            if constexpr (!is_value_trivially_destructible && std::is_destructible<Value>::value) {
-                if (variant == type::ok) {
-                    store.ok.~Value();
-                }
-            }
-
-            if constexpr (!is_error_trivially_destructible && std::is_destructible<Error>::value) {
-                if (variant == type::error) {
-                    store.error.~Error();
-                }
+        ///Creates Error variant.
+        ///
+        ///If `Error` can be constructed from argument and `result::source_location`, it receives location of caller.
+        template<class E>
+        static constexpr Result<Value, Error> error(E&& error, RESULT_CALLER_LOCATION) noexcept(std::is_nothrow_constructible<error_type, E>::value) {
+            RESULT_RECORD_ERROR(Error, created);
+            if constexpr (internal::is_located_error<error_type, E>) {
+                return Result<Value, Error>(internal::storage_error, std::forward<E>(error), location);
+            } else {
+                return Result<Value, Error>(internal::storage_error, std::forward<E>(error));
             }
         }
+        ///Creates Error variant from multiple arguments.
+        template<class E1, class E2, class... E>
+        static constexpr Result<Value, Error> error(E1&& first, E2&& second, E&&... rest) noexcept(std::is_nothrow_constructible<error_type, E1, E2, E...>::value) {
+#ifdef RESULT_TELEMETRY
+            //Location cannot follow multiple arguments, so it is recorded as unknown.
+            const source_location location;
+            RESULT_RECORD_ERROR(Error, created);
+#endif
+            return Result<Value, Error>(internal::storage_error, std::forward<E1>(first), std::forward<E2>(second), std::forward<E>(rest)...);
+        }
+
+        ///Destructor that invokes, if required, underlying storage's destructor.
+        ~Result() = default;
 
         ///Move constructor
-        Result(Result&& right) noexcept(is_move_const_noexcept) : variant(right.variant), store(internal::storage_empty) {
-            static_assert(std::is_move_constructible<Value>::value, "Value is not move constructable");
-            static_assert(std::is_move_constructible<Error>::value, "Error is not move constructable");
+        Result(Result&& right) = default;
 
-            switch (variant) {
-                case type::ok: ::new(&store.ok) Value(std::move(right.store.ok)); break;
-                case type::error: ::new(&store.error) Error(std::move(right.store.error)); break;
-            }
-        }
+        ///Copy constructor, available when both `Value` and `Error` are copy constructible.
+        Result(const Result& right) = default;
 
         ///Initializer from Ok
-        Result(const result::Ok<Value>& right) noexcept(std::is_nothrow_copy_constructible<Value>::value): variant(type::ok), store(internal::storage_ok, right.inner) { }
+        constexpr Result(const result::Ok<value_type>& right) noexcept(std::is_nothrow_copy_constructible<value_type>::value): base(internal::storage_ok, right.inner) { }
         ///Initializer from Ok
-        Result(result::Ok<Value>&& right) noexcept(std::is_nothrow_move_constructible<Value>::value): variant(type::ok), store(internal::storage_ok, std::move(right.inner)) { }
+        constexpr Result(result::Ok<value_type>&& right) noexcept(std::is_nothrow_move_constructible<value_type>::value): base(internal::storage_ok, std::move(right.inner)) { }
 
         ///Initializer from Err
-        Result(const result::Err<Error>& right) noexcept(std::is_nothrow_copy_constructible<Error>::value): variant(type::error), store(internal::storage_error, right.inner) { }
+        constexpr Result(const result::Err<error_type>& right RESULT_CALLER_LOCATION_NEXT) noexcept(std::is_nothrow_copy_constructible<error_type>::value): base(internal::storage_error, right.inner) {
+            RESULT_RECORD_ERROR(Error, created);
+        }
         ///Initializer from Err
-        Result(result::Err<Error>&& right) noexcept(std::is_nothrow_move_constructible<Error>::value): variant(type::error), store(internal::storage_error, std::move(right.inner)) { }
+        constexpr Result(result::Err<error_type>&& right RESULT_CALLER_LOCATION_NEXT) noexcept(std::is_nothrow_move_constructible<error_type>::value): base(internal::storage_error, std::move(right.inner)) {
+            RESULT_RECORD_ERROR(Error, created);
+        }
+        ///Initializer from Err, that is passed to `Error` together with location of caller.
+        template<class E, typename = std::enable_if_t<internal::is_located_error<error_type, const E&>>>
+        constexpr Result(const result::Err<E>& right RESULT_CALLER_LOCATION_NEXT) noexcept(std::is_nothrow_constructible<error_type, const E&, const source_location&>::value): base(internal::storage_error, right.inner, location) {
+            RESULT_RECORD_ERROR(Error, created);
+        }
+        ///Initializer from Err, that is passed to `Error` together with location of caller.
+        template<class E, typename = std::enable_if_t<internal::is_located_error<error_type, E&&>>>
+        constexpr Result(result::Err<E>&& right RESULT_CALLER_LOCATION_NEXT) noexcept(std::is_nothrow_constructible<error_type, E&&, const source_location&>::value): base(internal::storage_error, std::move(right.inner), location) {
+            RESULT_RECORD_ERROR(Error, created);
+        }
 
         ///Move assignment
-        Result& operator=(Result&& right) noexcept(is_move_assignment_noexcept) {
-            static_assert(std::is_move_assignable<Value>::value, "Value is not move assignable");
-            static_assert(std::is_move_assignable<Error>::value, "Error is not move assignable");
+        ///
+        ///If variant is the same, current content is move assigned, otherwise it is replaced as by `emplace_ok`/`emplace_err`.
+        Result& operator=(Result&& right) = default;
 
-            if (right.variant != variant) {
-                //Since different type we should clean up old value.
-                this->~Result();
-                variant = right.variant;
-            }
+        ///Copy assignment, available when both `Value` and `Error` are copy constructible and copy assignable.
+        ///
+        ///If variant is the same, current content is copy assigned, so it can re-use its capacity.
+        ///Otherwise it is replaced as by `emplace_ok`/`emplace_err`.
+        Result& operator=(const Result& right) = default;
 
-            switch (variant) {
-                case type::ok: store.ok = std::move(right.store.ok); break;
-                case type::error: store.error = std::move(right.store.error); break;
-            }
+        ///Replaces content with Ok value constructed in place from arguments.
+        ///
+        ///If `Value` is `void`, no arguments are accepted.
+        ///Arguments must not refer to current content, which may be destroyed before construction.
+        ///
+        ///If constructor throws, Result is unchanged as long as `Value` has non-throwing move constructor.
+        ///Otherwise Ok value is constructed aside and move assigned to current one, while Err error is kept
+        ///if its move constructor doesn't throw, and only if neither is possible Result is left `valueless()`.
+        ///
+        ///@returns Reference to constructed value.
+        template<class... T>
+        RESULT_CONSTEXPR20 value_reference emplace_ok(T&&... value) noexcept(std::is_nothrow_destructible<error_type>::value && std::is_nothrow_destructible<value_type>::value
+                                                                             && std::is_nothrow_constructible<value_type, T...>::value) {
+            return static_cast<value_reference>(this->emplace(internal::storage_ok, std::forward<T>(value)...));
+        }
 
-            return *this;
+        ///Replaces content with Error constructed in place from arguments.
+        ///
+        ///If `Error` is `void`, no arguments are accepted.
+        ///Arguments must not refer to current content, which may be destroyed before construction.
+        ///
+        ///If constructor throws, Result is unchanged as long as `Error` has non-throwing move constructor.
+        ///Otherwise Err error is constructed aside and move assigned to current one, while Ok value is kept
+        ///if its move constructor doesn't throw, and only if neither is possible Result is left `valueless()`.
+        ///
+        ///@returns Reference to constructed error.
+        template<class... E>
+        RESULT_CONSTEXPR20 error_reference emplace_err(E&&... error) noexcept(std::is_nothrow_destructible<error_type>::value && std::is_nothrow_destructible<value_type>::value
+                                                                             && std::is_nothrow_constructible<error_type, E...>::value) {
+            return static_cast<error_reference>(this->emplace(internal::storage_error, std::forward<E>(error)...));
         }
 
     //Interface
     public:
         ///@returns true If Ok value.
         constexpr bool is_ok() const noexcept {
-            return variant == type::ok;
+            return this->holds_ok();
         }
 
         ///@returns true If Error value.
         constexpr bool is_err() const noexcept {
-            return variant == type::error;
+            return this->holds_error();
+        }
+
+        ///@returns true If Result holds nothing, as constructor of its new payload threw and previous one could not be kept.
+        ///
+        ///Such Result is neither Ok nor Err, it can be assigned or destroyed, while access to its payload panics.
+        ///It is only possible if both `Value` and `Error` have throwing move constructors, see `emplace_ok`.
+        constexpr bool valueless() const noexcept {
+            return !this->holds_ok() && !this->holds_error();
         }
 
         ///@returns true If Ok value.
@@ -258,189 +1317,387 @@ class Result {
 
         ///Returns pointer to underlying value.
         ///
+        ///Not available if `Value` is `void`.
+        ///
         ///@retval nullptr If not-OK.
-        constexpr Value* value() noexcept {
-            return is_ok() ? &store.ok : nullptr;
+        template<class V = Value, typename = std::enable_if_t<!std::is_void<V>::value>>
+        constexpr value_pointer value() noexcept {
+            return is_ok() ? std::addressof(static_cast<value_reference>(this->ok_ref())) : nullptr;
         }
         ///Returns pointer to underlying value.
         ///
+        ///Not available if `Value` is `void`.
+        ///
         ///@retval nullptr If not-OK.
-        constexpr const Value* value() const noexcept {
-            return const_cast<Result*>(this)->value();
+        template<class V = Value, typename = std::enable_if_t<!std::is_void<V>::value>>
+        constexpr const_value_pointer value() const noexcept {
+            return is_ok() ? std::addressof(static_cast<const_value_reference>(this->ok_ref())) : nullptr;
         }
         ///Returns pointer to underlying error.
         ///
+        ///Not available if `Error` is `void`.
+        ///
         ///@retval nullptr If not-OK.
-        constexpr Error* error() noexcept {
-            return is_err() ? &store.error : nullptr;
+        template<class E = Error, typename = std::enable_if_t<!std::is_void<E>::value>>
+        constexpr E* error() noexcept {
+            return is_err() ? &this->error_ref() : nullptr;
         }
         ///Returns pointer to underlying error.
         ///
+        ///Not available if `Error` is `void`.
+        ///
         ///@retval nullptr If not-OK.
-        constexpr const Error* error() const noexcept {
+        template<class E = Error, typename = std::enable_if_t<!std::is_void<E>::value>>
+        constexpr const E* error() const noexcept {
             return const_cast<Result*>(this)->error();
         }
 
         ///Attempts to unwrap result, yielding content of Ok.
         ///
         ///@throws Content of Error.
-        constexpr Value& unwrap() & {
+        constexpr value_reference unwrap(RESULT_CALLER_LOCATION) & {
             //TODO: consider if non-const reference is good idea?
-            if (is_ok()) {
-                return store.ok;
-            } else {
-                throw store.error;
+            if (RESULT_UNLIKELY(is_err())) {
+                RESULT_RECORD_ERROR(Error, unwrap_failed);
+                internal::unwrap_failed(this->error_ref(), location);
             }
+
+            return static_cast<value_reference>(this->ok_ref());
         }
         ///Attempts to unwrap result, yielding const ref content of Ok.
         ///
         ///@throws Content of Error.
-        constexpr const Value& unwrap() const & {
-            return const_cast<Result*>(this)->unwrap();
+        constexpr const_value_reference unwrap(RESULT_CALLER_LOCATION) const & {
+            if (RESULT_UNLIKELY(is_err())) {
+                RESULT_RECORD_ERROR(Error, unwrap_failed);
+                internal::unwrap_failed(this->error_ref(), location);
+            }
+
+            return static_cast<const_value_reference>(this->ok_ref());
         }
         ///Attempts to unwrap result, yielding content of Ok.
         ///
         ///@note Moves out Ok's value
         ///
         ///@throws Content of Error.
-        constexpr Value unwrap() && {
-            if (is_ok()) {
-                return std::move(store.ok);
-            } else {
-                throw store.error;
+        constexpr Value unwrap(RESULT_CALLER_LOCATION) && {
+            if (RESULT_UNLIKELY(is_err())) {
+                RESULT_RECORD_ERROR(Error, unwrap_failed);
+                internal::unwrap_failed(this->error_ref(), location);
             }
+
+            return static_cast<Value>(std::move(this->ok_ref()));
         }
 
         ///Attempts to unwrap result, yielding content of Err.
         ///
         ///@throws If no error.
-        constexpr Error& unwrap_err() & {
-            if (is_err()) {
-                return store.error;
-            } else {
-                throw "Surprisingly no error...";
+        constexpr error_reference unwrap_err(RESULT_CALLER_LOCATION) & {
+            if (RESULT_UNLIKELY(is_ok())) {
+                RESULT_RECORD_ERROR(Error, unwrap_err_failed);
+                internal::unwrap_err_failed();
             }
+
+            return static_cast<error_reference>(this->error_ref());
         }
         ///Attempts to unwrap result, yielding content of Err.
         ///
         ///@throws If no error.
-        constexpr const Error& unwrap_err() const & {
-            return const_cast<Result*>(this)->unwrap_err();
+        constexpr const_error_reference unwrap_err(RESULT_CALLER_LOCATION) const & {
+            if (RESULT_UNLIKELY(is_ok())) {
+                RESULT_RECORD_ERROR(Error, unwrap_err_failed);
+                internal::unwrap_err_failed();
+            }
+
+            return static_cast<const_error_reference>(this->error_ref());
         }
         ///Attempts to unwrap result, yielding content of Err.
         ///
         ///@note Moves out Error's value
         ///
         ///@throws If no error.
-        constexpr Error unwrap_err() && {
-            if (is_err()) {
-                return std::move(store.error);
-            } else {
-                throw "Surprisingly no error...";
+        constexpr Error unwrap_err(RESULT_CALLER_LOCATION) && {
+            if (RESULT_UNLIKELY(is_ok())) {
+                RESULT_RECORD_ERROR(Error, unwrap_err_failed);
+                internal::unwrap_err_failed();
             }
+
+            return static_cast<Error>(std::move(this->error_ref()));
         }
 
         ///Attempts to unwrap result, yielding content of Ok or, if it is not ok, other.
-        constexpr Value unwrap_or(Value&& other) const & noexcept(std::is_nothrow_move_constructible<Value>::value && std::is_nothrow_copy_constructible<Value>::value) {
-            return is_ok() ? store.ok : std::move(other);
+        constexpr Value unwrap_or(value_type&& other) const & noexcept(std::is_nothrow_move_constructible<value_type>::value && std::is_nothrow_copy_constructible<value_type>::value) {
+            static_assert(!std::is_void<Value>::value, "Cannot unwrap_or void Value");
+            return is_ok() ? this->ok_ref() : std::move(other);
         }
         ///Attempts to unwrap result, yielding content of Ok or, if it is not ok, other.
         ///
         ///@note Moves out Ok's value
-        constexpr Value unwrap_or(Value&& other) && noexcept(std::is_nothrow_move_constructible<Value>::value) {
-            return std::move(is_ok() ? store.ok : other);
+        constexpr Value unwrap_or(value_type&& other) && noexcept(std::is_nothrow_move_constructible<value_type>::value) {
+            static_assert(!std::is_void<Value>::value, "Cannot unwrap_or void Value");
+            return std::move(is_ok() ? this->ok_ref() : other);
         }
 
         ///Attempts to unwrap result, yielding content of Ok or, default constructed value.
         ///
         ///This is only possible if `Value` is trivially copable.
-        constexpr Value unwrap_or_default() const & noexcept(std::is_nothrow_constructible<Value>::value && std::is_nothrow_copy_constructible<Value>::value) {
-            return is_ok() ? store.ok : Value();
+        constexpr Value unwrap_or_default() const & noexcept(std::is_nothrow_constructible<value_type>::value && std::is_nothrow_copy_constructible<value_type>::value) {
+            static_assert(!std::is_void<Value>::value, "Cannot unwrap_or_default void Value");
+            static_assert(!std::is_reference<Value>::value, "Cannot unwrap_or_default reference Value");
+            return is_ok() ? this->ok_ref() : Value();
         }
         ///Attempts to unwrap result, yielding content of Ok or, if it is not ok, other.
         ///
         ///@note Moves out Ok's value
-        constexpr Value unwrap_or_default() && noexcept(std::is_nothrow_move_constructible<Value>::value && std::is_nothrow_constructible<Value>::value) {
-            return is_ok() ? std::move(store.ok) : Value();
+        constexpr Value unwrap_or_default() && noexcept(std::is_nothrow_move_constructible<value_type>::value && std::is_nothrow_constructible<value_type>::value) {
+            static_assert(!std::is_void<Value>::value, "Cannot unwrap_or_default void Value");
+            static_assert(!std::is_reference<Value>::value, "Cannot unwrap_or_default reference Value");
+            return is_ok() ? std::move(this->ok_ref()) : Value();
+        }
+
+        ///Maps OK value of Result into different value/type.
+        ///
+        ///Ok value is passed to `fn` as lvalue, new value is constructed in place from `fn`'s return.
+        ///
+        ///@note Copies Err error into new Result
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewValue = internal::invoke_payload_result_t<Fn, value_type&>>
+        constexpr Result<NewValue, Error> map(Fn&& fn) & {
+            static_assert(internal::is_payload_invocable<Fn, value_type&>, "Fn must be callable and accept Value as argument, or no argument if Value is void");
+
+            if (is_ok()) {
+                return Result<NewValue, Error>(internal::storage_ok, internal::storage_invoke, std::forward<Fn>(fn), this->ok_ref());
+            } else {
+                return Result<NewValue, Error>(internal::storage_error, this->error_ref());
+            }
+        }
+
+        ///Maps OK value of Result into different value/type.
+        ///
+        ///Ok value is passed to `fn` as const lvalue, new value is constructed in place from `fn`'s return.
+        ///
+        ///@note Copies Err error into new Result
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewValue = internal::invoke_payload_result_t<Fn, const value_type&>>
+        constexpr Result<NewValue, Error> map(Fn&& fn) const & {
+            static_assert(internal::is_payload_invocable<Fn, const value_type&>, "Fn must be callable and accept Value as argument, or no argument if Value is void");
+
+            if (is_ok()) {
+                return Result<NewValue, Error>(internal::storage_ok, internal::storage_invoke, std::forward<Fn>(fn), this->ok_ref());
+            } else {
+                return Result<NewValue, Error>(internal::storage_error, this->error_ref());
+            }
         }
 
         ///Maps OK value of Result into different value/type.
         ///
-        ///@note Moves underlying storage out of old Result
+        ///Ok value is passed to `fn` as rvalue, new value is constructed in place from `fn`'s return.
+        ///
+        ///@note Moves Err error into new Result
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewValue = internal::invoke_payload_result_t<Fn, value_type&&>>
+        constexpr Result<NewValue, Error> map(Fn&& fn) && {
+            static_assert(internal::is_payload_invocable<Fn, value_type&&>, "Fn must be callable and accept Value as argument, or no argument if Value is void");
+
+            if (is_ok()) {
+                return Result<NewValue, Error>(internal::storage_ok, internal::storage_invoke, std::forward<Fn>(fn), std::move(this->ok_ref()));
+            } else if constexpr (std::is_same<Result<NewValue, Error>, Result>::value) {
+                return std::move(*this).pass_through();
+            } else {
+                return Result<NewValue, Error>(internal::storage_error, std::move(this->error_ref()));
+            }
+        }
+
+        ///Maps Err error of Result into different value/type.
+        ///
+        ///Err error is passed to `fn` as lvalue, new error is constructed in place from `fn`'s return.
+        ///
+        ///@note Copies Ok value into new Result
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewError = internal::invoke_payload_result_t<Fn, error_type&>>
+        constexpr Result<Value, NewError> map_err(Fn&& fn) & {
+            static_assert(internal::is_payload_invocable<Fn, error_type&>, "Fn must be callable and accept Error as argument, or no argument if Error is void");
+
+            if (is_ok()) {
+                return Result<Value, NewError>::ok(this->ok_ref());
+            } else {
+                return Result<Value, NewError>(internal::storage_error, internal::storage_invoke, std::forward<Fn>(fn), this->error_ref());
+            }
+        }
+
+        ///Maps Err error of Result into different value/type.
+        ///
+        ///Err error is passed to `fn` as const lvalue, new error is constructed in place from `fn`'s return.
+        ///
+        ///@note Copies Ok value into new Result
         ///
         ///@returns New result.
-        template<typename Fn, typename NewValue = std::invoke_result_t<Fn, Value>>
-        constexpr Result<NewValue, Error> map(Fn fn) {
-            static_assert(std::is_invocable<Fn, Value>::value, "Fn must be callable and accept Value as argument");
+        template<typename Fn, typename NewError = internal::invoke_payload_result_t<Fn, const error_type&>>
+        constexpr Result<Value, NewError> map_err(Fn&& fn) const & {
+            static_assert(internal::is_payload_invocable<Fn, const error_type&>, "Fn must be callable and accept Error as argument, or no argument if Error is void");
 
-            if (is_err()) {
-                Error error = std::move(this->store.error);
-                return Result<NewValue, Error>::error(error);
+            if (is_ok()) {
+                return Result<Value, NewError>::ok(this->ok_ref());
             } else {
-                Value value = std::move(this->store.ok);
-                return Result<NewValue, Error>::ok(fn(value));
+                return Result<Value, NewError>(internal::storage_error, internal::storage_invoke, std::forward<Fn>(fn), this->error_ref());
             }
         }
 
         ///Maps Err error of Result into different value/type.
         ///
-        ///@note Moves underlying storage out of old Result
+        ///Err error is passed to `fn` as rvalue, new error is constructed in place from `fn`'s return.
+        ///
+        ///@note Moves Ok value into new Result
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewError = internal::invoke_payload_result_t<Fn, error_type&&>>
+        constexpr Result<Value, NewError> map_err(Fn&& fn) && {
+            static_assert(internal::is_payload_invocable<Fn, error_type&&>, "Fn must be callable and accept Error as argument, or no argument if Error is void");
+
+            if (is_ok()) {
+                return Result<Value, NewError>::ok(std::move(this->ok_ref()));
+            } else {
+                return Result<Value, NewError>(internal::storage_error, internal::storage_invoke, std::forward<Fn>(fn), std::move(this->error_ref()));
+            }
+        }
+
+        ///Chains itself to new Result, returned by function with potentially different Value.
+        ///
+        ///Ok value is passed to `fn` as lvalue.
+        ///
+        ///@note Copies Err error into new Result
+        ///
+        ///@param fn Callback to be called when result is Ok.
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewResult = internal::invoke_payload_result_t<Fn, value_type&>>
+        constexpr NewResult and_then(Fn&& fn RESULT_CALLER_LOCATION_NEXT) & {
+            static_assert(internal::is_payload_invocable<Fn, value_type&>, "Fn must be callable and accept Value as argument, or no argument if Value is void");
+            static_assert(is_result<NewResult>::value, "Fn must return result");
+            static_assert(std::is_same<typename NewResult::Err, Error>::value, "New Result must have the same Error type");
+
+            if (is_ok()) {
+                return internal::invoke_payload(std::forward<Fn>(fn), this->ok_ref());
+            } else {
+                return NewResult::propagate_error(this->error_ref(), location);
+            }
+        }
+
+        ///Chains itself to new Result, returned by function with potentially different Value.
+        ///
+        ///Ok value is passed to `fn` as const lvalue.
+        ///
+        ///@note Copies Err error into new Result
+        ///
+        ///@param fn Callback to be called when result is Ok.
         ///
         ///@returns New result.
-        template<typename Fn, typename NewError = std::invoke_result_t<Fn, Error>>
-        constexpr Result<Value, NewError> map_err(Fn fn) {
-            static_assert(std::is_invocable<Fn, Error>::value, "Fn must be callable and accept Error as argument");
+        template<typename Fn, typename NewResult = internal::invoke_payload_result_t<Fn, const value_type&>>
+        constexpr NewResult and_then(Fn&& fn RESULT_CALLER_LOCATION_NEXT) const & {
+            static_assert(internal::is_payload_invocable<Fn, const value_type&>, "Fn must be callable and accept Value as argument, or no argument if Value is void");
+            static_assert(is_result<NewResult>::value, "Fn must return result");
+            static_assert(std::is_same<typename NewResult::Err, Error>::value, "New Result must have the same Error type");
 
             if (is_ok()) {
-                Value ok = std::move(this->store.ok);
-                return Result<Value, NewError>::ok(ok);
+                return internal::invoke_payload(std::forward<Fn>(fn), this->ok_ref());
             } else {
-                Error error = std::move(this->store.error);
-                return Result<Value, NewError>::error(fn(error));
+                return NewResult::propagate_error(this->error_ref(), location);
             }
         }
 
         ///Chains itself to new Result, returned by function with potentially different Value.
         ///
-        ///@note Moves underlying storage out of old Result
+        ///Ok value is passed to `fn` as rvalue.
+        ///
+        ///@note Moves Err error into new Result
         ///
         ///@param fn Callback to be called when result is Ok.
         ///
         ///@returns New result.
-        template<typename Fn, typename NewResult = std::invoke_result_t<Fn, Value>>
-        constexpr NewResult and_then(Fn fn) {
-            static_assert(std::is_invocable<Fn, Value>::value, "Fn must be callable and accept Value as argument");
+        template<typename Fn, typename NewResult = internal::invoke_payload_result_t<Fn, value_type&&>>
+        constexpr NewResult and_then(Fn&& fn RESULT_CALLER_LOCATION_NEXT) && {
+            static_assert(internal::is_payload_invocable<Fn, value_type&&>, "Fn must be callable and accept Value as argument, or no argument if Value is void");
             static_assert(is_result<NewResult>::value, "Fn must return result");
             static_assert(std::is_same<typename NewResult::Err, Error>::value, "New Result must have the same Error type");
 
             if (is_ok()) {
-                Value ok = std::move(this->store.ok);
-                return fn(ok);
+                return internal::invoke_payload(std::forward<Fn>(fn), std::move(this->ok_ref()));
+            } else if constexpr (std::is_same<NewResult, Result>::value && !internal::has_propagate_hook<error_type>::value) {
+                //Returns itself as whole, so that compiler doesn't take it apart and pack error back.
+                static_cast<void>(location);
+                return std::move(*this).pass_through();
+            } else {
+                return NewResult::propagate_error(std::move(this->error_ref()), location);
+            }
+        }
+
+        ///Chains itself to new Result, returned by function with potentially different Error.
+        ///
+        ///Err error is passed to `fn` as lvalue.
+        ///
+        ///@note Copies Ok value into new Result
+        ///
+        ///@param fn Callback to be called when result is Err.
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewResult = internal::invoke_payload_result_t<Fn, error_type&>>
+        constexpr NewResult or_else(Fn&& fn) & {
+            static_assert(internal::is_payload_invocable<Fn, error_type&>, "Fn must be callable and accept Error as argument, or no argument if Error is void");
+            static_assert(is_result<NewResult>::value, "Fn must return result");
+            static_assert(std::is_same<typename NewResult::Ok, Value>::value, "New Result must have the same Value type");
+
+            if (is_ok()) {
+                return NewResult::ok(this->ok_ref());
+            } else {
+                return internal::invoke_payload(std::forward<Fn>(fn), this->error_ref());
+            }
+        }
+
+        ///Chains itself to new Result, returned by function with potentially different Error.
+        ///
+        ///Err error is passed to `fn` as const lvalue.
+        ///
+        ///@note Copies Ok value into new Result
+        ///
+        ///@param fn Callback to be called when result is Err.
+        ///
+        ///@returns New result.
+        template<typename Fn, typename NewResult = internal::invoke_payload_result_t<Fn, const error_type&>>
+        constexpr NewResult or_else(Fn&& fn) const & {
+            static_assert(internal::is_payload_invocable<Fn, const error_type&>, "Fn must be callable and accept Error as argument, or no argument if Error is void");
+            static_assert(is_result<NewResult>::value, "Fn must return result");
+            static_assert(std::is_same<typename NewResult::Ok, Value>::value, "New Result must have the same Value type");
+
+            if (is_ok()) {
+                return NewResult::ok(this->ok_ref());
             } else {
-                Error error = std::move(this->store.error);
-                return NewResult::error(error);
+                return internal::invoke_payload(std::forward<Fn>(fn), this->error_ref());
             }
         }
 
         ///Chains itself to new Result, returned by function with potentially different Error.
         ///
-        ///@note Moves underlying storage out of old Result
+        ///Err error is passed to `fn` as rvalue.
+        ///
+        ///@note Moves Ok value into new Result
         ///
         ///@param fn Callback to be called when result is Err.
         ///
         ///@returns New result.
-        template<typename Fn, typename NewResult = std::invoke_result_t<Fn, Error>>
-        constexpr NewResult or_else(Fn fn) {
-            static_assert(std::is_invocable<Fn, Error>::value, "Fn must be callable and accept Error as argument");
+        template<typename Fn, typename NewResult = internal::invoke_payload_result_t<Fn, error_type&&>>
+        constexpr NewResult or_else(Fn&& fn) && {
+            static_assert(internal::is_payload_invocable<Fn, error_type&&>, "Fn must be callable and accept Error as argument, or no argument if Error is void");
             static_assert(is_result<NewResult>::value, "Fn must return result");
             static_assert(std::is_same<typename NewResult::Ok, Value>::value, "New Result must have the same Value type");
 
             if (is_ok()) {
-                Value ok = std::move(this->store.ok);
-                return NewResult::ok(ok);
+                return NewResult::ok(std::move(this->ok_ref()));
             } else {
-                Error error = std::move(this->store.error);
-                return fn(error);
+                return internal::invoke_payload(std::forward<Fn>(fn), std::move(this->error_ref()));
             }
         }
 
@@ -473,4 +1730,410 @@ namespace internal {
 template<typename T>
 struct is_result: std::integral_constant<bool, internal::is_result<T>::value> {};
 
+/**
+ * Compares Results, which are equal if both are Ok with equal values or both are Err with equal errors.
+ * Valueless Results are equal only to each other.
+ *
+ * Void payloads are equal to each other, and can be compared only with void.
+ *
+ * ~~~~~~~~~~~~~~~
+ * assert(result::Result<int, std::string>::ok(1) == result::Result<long, const char*>::ok(1));
+ * assert(result::Result<int, int>::ok(1) != result::Result<int, int>::error(1));
+ * ~~~~~~~~~~~~~~~
+ */
+template<class V1, class E1, class V2, class E2>
+constexpr bool operator==(const Result<V1, E1>& left, const Result<V2, E2>& right) {
+    static_assert(std::is_void<V1>::value == std::is_void<V2>::value, "void Value can be compared only with void");
+    static_assert(std::is_void<E1>::value == std::is_void<E2>::value, "void Error can be compared only with void");
+
+    if (left.is_ok() != right.is_ok() || left.is_err() != right.is_err()) {
+        return false;
+    } else if (left.is_ok()) {
+        if constexpr (std::is_void<V1>::value) {
+            return true;
+        } else {
+            return *left.value() == *right.value();
+        }
+    } else if (left.is_err()) {
+        if constexpr (std::is_void<E1>::value) {
+            return true;
+        } else {
+            return *left.error() == *right.error();
+        }
+    } else {
+        //Both are valueless.
+        return true;
+    }
+}
+
+///Compares Results, which are unequal if variants or their payloads differ.
+template<class V1, class E1, class V2, class E2>
+constexpr bool operator!=(const Result<V1, E1>& left, const Result<V2, E2>& right) {
+    return !(left == right);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Hash of payload, mixed with seed of its variant, so that Ok and Err of equal payloads differ.
+    template<class T, class Ptr>
+    std::size_t hash_variant(std::size_t seed, Ptr payload) {
+        if constexpr (std::is_void<T>::value) {
+            static_cast<void>(payload);
+            return seed;
+        } else {
+            const std::size_t hash = std::hash<std::remove_cv_t<std::remove_reference_t<T>>>()(*payload);
+            return seed ^ (hash + static_cast<std::size_t>(0x9e3779b97f4a7c15ull) + (seed << 6) + (seed >> 2));
+        }
+    }
+}
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Constructs Result bypassing its public factories.
+    struct result_access {
+        ///Creates Err, that is propagated rather than newly created, so it is not recorded by telemetry.
+        template<class R, class... A>
+        static constexpr R error(A&&... error) {
+            return R(storage_error, std::forward<A>(error)...);
+        }
+
+        ///Creates Ok out of payload, which is unit if Value is void.
+        template<class R, class... A>
+        static constexpr R ok(A&&... value) {
+            return R(storage_ok, std::forward<A>(value)...);
+        }
+
+        ///@returns Payload of Ok, which must be Ok.
+        template<class R>
+        static constexpr auto& ok_payload(R& result) noexcept {
+            return result.ok_ref();
+        }
+
+        ///@returns Payload of Err, which must be Err.
+        template<class R>
+        static constexpr auto& error_payload(R& result) noexcept {
+            return result.error_ref();
+        }
+    };
+}
+#endif
+
+#if defined(RESULT_HAS_COROUTINE) && !defined(DOXYGEN_SHOULD_SKIP_THIS)
+namespace internal {
+    ///Thread local cache of coroutine frames.
+    ///
+    ///Frames of the same coroutine have the same size, so memory of finished coroutine
+    ///is re-used by the next call, making steady state free of allocations even if compiler
+    ///is unable to elide frame allocation.
+    class frame_cache {
+        static constexpr std::size_t capacity = 16;
+
+        void* frames[capacity];
+        std::size_t sizes[capacity];
+        std::size_t len = 0;
+
+        frame_cache() noexcept = default;
+
+        public:
+            frame_cache(const frame_cache&) = delete;
+            frame_cache& operator=(const frame_cache&) = delete;
+
+            ~frame_cache() {
+                while (len > 0) {
+                    len--;
+                    ::operator delete(frames[len], sizes[len]);
+                }
+            }
+
+            static frame_cache& local() noexcept {
+                thread_local frame_cache cache;
+                return cache;
+            }
+
+            void* allocate(std::size_t size) {
+                for (std::size_t idx = len; idx > 0; idx--) {
+                    if (sizes[idx - 1] == size) {
+                        void* frame = frames[idx - 1];
+                        len--;
+                        frames[idx - 1] = frames[len];
+                        sizes[idx - 1] = sizes[len];
+                        return frame;
+                    }
+                }
+
+                return ::operator new(size);
+            }
+
+            void deallocate(void* frame, std::size_t size) noexcept {
+                if (len < capacity) {
+                    frames[len] = frame;
+                    sizes[len] = size;
+                    len++;
+                } else {
+                    ::operator delete(frame, size);
+                }
+            }
+    };
+
+    template<class Value, class Error>
+    class promise;
+
+    ///Awaiter that yields Ok value or short-circuits coroutine with Err.
+    template<class Promise, class R>
+    class result_awaiter {
+        R result;
+
+        public:
+            explicit result_awaiter(R&& result) noexcept : result(std::forward<R>(result)) {}
+
+            bool await_ready() const noexcept {
+                return result.is_ok();
+            }
+
+            void await_suspend(std::coroutine_handle<Promise> handle) {
+                handle.promise().short_circuit(std::forward<R>(result));
+            }
+
+            decltype(auto) await_resume() {
+                return std::forward<R>(result).unwrap();
+            }
+    };
+
+    ///Awaiter that always short-circuits coroutine with Err.
+    template<class Promise, class E>
+    class err_awaiter {
+        E error;
+
+        public:
+            explicit err_awaiter(E&& error) noexcept : error(std::forward<E>(error)) {}
+
+            bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<Promise> handle) {
+                handle.promise().short_circuit_err(std::forward<E>(error).inner);
+            }
+
+            void await_resume() const noexcept {}
+    };
+
+    ///Base of promise that stores outcome of coroutine.
+    ///
+    ///Coroutine starts suspended and is run by conversion of return object into Result,
+    ///so that it doesn't matter whether compiler converts return object before or after running coroutine.
+    ///Result is constructed within coroutine frame and moved out by return object,
+    ///which then destroys frame allowing compiler to elide its allocation.
+    template<class Value, class Error>
+    class promise_base {
+        using result_type = Result<Value, Error>;
+
+        public:
+            class return_object;
+
+        private:
+            alignas(result_type) unsigned char buffer[sizeof(result_type)];
+            result_type* slot = nullptr;
+#ifdef RESULT_HAS_EXCEPTIONS
+            std::exception_ptr failure;
+#endif
+
+        protected:
+            template<class... A>
+            void emplace(A&&... args) {
+                slot = ::new(static_cast<void*>(buffer)) result_type(std::forward<A>(args)...);
+            }
+
+        public:
+            ///Object that is converted into Result, owning coroutine frame until then.
+            class return_object {
+                friend class promise_base;
+
+                std::coroutine_handle<promise<Value, Error>> handle;
+
+                public:
+                    explicit return_object(std::coroutine_handle<promise<Value, Error>> handle) noexcept : handle(handle) {}
+                    return_object(const return_object&) = delete;
+                    return_object& operator=(const return_object&) = delete;
+
+                    ~return_object() {
+                        if (handle) {
+                            handle.destroy();
+                        }
+                    }
+
+                    ///Runs coroutine until it returns or short-circuits, yielding its Result.
+                    ///
+                    ///Result is never constructed in place of returned object, as it may be temporary
+                    ///that compiler copies, e.g. Result in registers.
+                    operator result_type() {
+                        handle.resume();
+#ifdef RESULT_HAS_EXCEPTIONS
+                        if (handle.promise().failure) {
+                            const std::exception_ptr failure = std::move(handle.promise().failure);
+#if defined(__GNUC__) && !defined(__clang__)
+                            //GCC destroys frame itself, once exception leaves conversion within coroutine.
+                            handle = nullptr;
+#endif
+                            std::rethrow_exception(failure);
+                        }
+#endif
+                        return std::move(*handle.promise().slot);
+                    }
+            };
+
+            promise_base() noexcept = default;
+            promise_base(const promise_base&) = delete;
+            promise_base& operator=(const promise_base&) = delete;
+
+            ~promise_base() {
+                if (slot != nullptr) {
+                    slot->~result_type();
+                }
+            }
+
+            static void* operator new(std::size_t size) {
+                return frame_cache::local().allocate(size);
+            }
+
+            static void operator delete(void* frame, std::size_t size) noexcept {
+                frame_cache::local().deallocate(frame, size);
+            }
+
+            return_object get_return_object() noexcept {
+                return return_object(std::coroutine_handle<promise<Value, Error>>::from_promise(static_cast<promise<Value, Error>&>(*this)));
+            }
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            ///Keeps frame, that return object destroys after taking Result.
+            std::suspend_always final_suspend() const noexcept {
+                return {};
+            }
+
+            ///Keeps exception to rethrow it to the caller, once coroutine reaches its final point.
+            ///
+            ///It is not rethrown right away, as compilers disagree whether frame is destroyed then.
+            void unhandled_exception() {
+#ifdef RESULT_HAS_EXCEPTIONS
+                failure = std::current_exception();
+#else
+                std::abort();
+#endif
+            }
+
+            template<class R>
+            void short_circuit(R&& result) {
+                if constexpr (std::is_void<typename std::remove_reference_t<R>::Err>::value) {
+                    short_circuit_err();
+                } else {
+                    short_circuit_err(std::forward<R>(result).unwrap_err());
+                }
+            }
+
+            template<class... E>
+            void short_circuit_err(E&&... error) {
+                emplace(internal::storage_error, std::forward<E>(error)...);
+            }
+
+            template<class T, class E>
+            auto await_transform(Result<T, E>& result) noexcept {
+                return result_awaiter<promise<Value, Error>, Result<T, E>&>(result);
+            }
+
+            template<class T, class E>
+            auto await_transform(Result<T, E>&& result) noexcept {
+                return result_awaiter<promise<Value, Error>, Result<T, E>&&>(std::move(result));
+            }
+
+            template<class E>
+            auto await_transform(result::Err<E>&& error) noexcept {
+                return err_awaiter<promise<Value, Error>, result::Err<E>&&>(std::move(error));
+            }
+    };
+
+    template<class Value, class Error>
+    class promise: public promise_base<Value, Error> {
+        public:
+            ///Accepts Ok value or anything Result can be constructed from.
+            template<class T>
+            void return_value(T&& value) {
+                if constexpr (std::is_constructible<Result<Value, Error>, T&&>::value) {
+                    this->emplace(std::forward<T>(value));
+                } else {
+                    this->emplace(internal::storage_ok, std::forward<T>(value));
+                }
+            }
+    };
+
+    template<class Error>
+    class promise<void, Error>: public promise_base<void, Error> {
+        public:
+            void return_void() {
+                this->emplace(internal::storage_ok);
+            }
+    };
+}
+#endif
+
 } // namespace result
+
+namespace std {
+    /**
+     * Hash of Result, consistent with its equality, so that it can be key of unordered containers.
+     *
+     * Requires `std::hash` of non-void Value and Error.
+     */
+    template<class Value, class Error>
+    struct hash<result::Result<Value, Error>> {
+        std::size_t operator()(const result::Result<Value, Error>& res) const {
+            if (res.is_ok()) {
+                if constexpr (std::is_void<Value>::value) {
+                    return result::internal::hash_variant<Value>(1, nullptr);
+                } else {
+                    return result::internal::hash_variant<Value>(1, res.value());
+                }
+            } else if (res.is_err()) {
+                if constexpr (std::is_void<Error>::value) {
+                    return result::internal::hash_variant<Error>(2, nullptr);
+                } else {
+                    return result::internal::hash_variant<Error>(2, res.error());
+                }
+            } else {
+                return 0;
+            }
+        }
+    };
+}
+
+#if defined(RESULT_HAS_COROUTINE) && !defined(DOXYGEN_SHOULD_SKIP_THIS)
+namespace std {
+    /**
+     * Allows Result to be coroutine's return type.
+     *
+     * Inside such coroutine `co_await` on Result yields its Ok value or returns its Err from coroutine,
+     * similarly to Rust's `?` operator.
+     * `co_await result::Err(error)` returns error immediately.
+     *
+     * ~~~~~~~~~~~~~~~
+     * result::Result<int, std::string> parse(const char* text);
+     *
+     * result::Result<int, std::string> sum(const char* left, const char* right) {
+     *     const int left_num = co_await parse(left);
+     *     const int right_num = co_await parse(right);
+     *     if (right_num == 0) {
+     *         co_await result::Err(std::string("zero"));
+     *     }
+     *     co_return left_num + right_num;
+     * }
+     * ~~~~~~~~~~~~~~~
+     */
+    template<class Value, class Error, class... Args>
+    struct coroutine_traits<result::Result<Value, Error>, Args...> {
+        using promise_type = result::internal::promise<Value, Error>;
+    };
+}
+#endif
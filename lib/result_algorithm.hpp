@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.hpp"
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#endif
+
+namespace result {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    template<class Range>
+    using range_reference_t = decltype(*std::begin(std::declval<Range&>()));
+
+    template<class Range>
+    using range_element_t = std::remove_cv_t<std::remove_reference_t<range_reference_t<Range>>>;
+
+    template<class Range>
+    using range_category_t = typename std::iterator_traits<decltype(std::begin(std::declval<Range&>()))>::iterator_category;
+
+    template<class Range>
+    constexpr bool is_forward_range = std::is_base_of<std::forward_iterator_tag, range_category_t<Range>>::value;
+
+    ///Number of elements if it is known without iterating.
+    template<class Range>
+    auto size_hint(const Range& range, int) -> decltype(static_cast<std::size_t>(std::size(range))) {
+        return static_cast<std::size_t>(std::size(range));
+    }
+
+    template<class Range>
+    std::size_t size_hint(const Range&, long) {
+        return 0;
+    }
+
+    ///Whether Range is rvalue, that owns its elements, so that they can be moved out.
+    ///
+    ///View or borrowed range, such as span, refers to elements of other range, which are left intact.
+    template<class Range>
+#if defined(__cpp_lib_ranges)
+    constexpr bool owns_elements = !std::is_lvalue_reference<Range>::value && !std::ranges::view<std::remove_cvref_t<Range>> && !std::ranges::borrowed_range<Range>;
+#else
+    constexpr bool owns_elements = !std::is_lvalue_reference<Range>::value;
+#endif
+
+    ///Forwards element of range, moving it out if range is rvalue that owns it.
+    template<class Range, class Elem>
+    constexpr decltype(auto) forward_element(Elem&& elem) noexcept {
+        if constexpr (owns_elements<Range>) {
+            return std::move(elem);
+        } else {
+            return std::forward<Elem>(elem);
+        }
+    }
+
+    ///Ok value of Result, moved out of rvalue.
+    template<class R>
+    constexpr decltype(auto) take_ok(R&& result) noexcept {
+        if constexpr (std::is_lvalue_reference<R>::value) {
+            return *result.value();
+        } else {
+            return std::move(*result.value());
+        }
+    }
+
+    ///Err error of Result, moved out of rvalue.
+    template<class R>
+    constexpr decltype(auto) take_error(R&& result) noexcept {
+        if constexpr (std::is_lvalue_reference<R>::value) {
+            return *result.error();
+        } else {
+            return std::move(*result.error());
+        }
+    }
+
+    ///Creates Result Out with Err taken out of result.
+    template<class Out, class R>
+    constexpr Out err_into(R&& result) {
+        if constexpr (std::is_void<typename std::remove_reference_t<R>::Err>::value) {
+            return result_access::error<Out>();
+        } else {
+            return result_access::error<Out>(take_error(std::forward<R>(result)));
+        }
+    }
+
+    ///Err type of first Result among T...
+    template<class... T>
+    struct first_error {
+        using type = void;
+        static constexpr bool found = false;
+    };
+
+    template<class T, class... Rest>
+    struct first_error<T, Rest...>: first_error<Rest...> {};
+
+    template<class Value, class Error, class... Rest>
+    struct first_error<Result<Value, Error>, Rest...> {
+        using type = Error;
+        static constexpr bool found = true;
+    };
+
+    ///Argument that is passed to callback for element of range: Ok value of Result or element itself.
+    template<class Range, bool = is_result<range_element_t<Range>>::value>
+    struct step_input {
+        using type = decltype(take_ok(forward_element<Range>(std::declval<range_reference_t<Range>>())));
+    };
+
+    template<class Range>
+    struct step_input<Range, false> {
+        using type = decltype(forward_element<Range>(std::declval<range_reference_t<Range>>()));
+    };
+
+    template<class Range>
+    using step_input_t = typename step_input<Range>::type;
+
+    ///Whether A and B have the same Err, if both are Result.
+    template<class A, class B, bool = is_result<A>::value && is_result<B>::value>
+    constexpr bool same_error = true;
+
+    template<class A, class B>
+    constexpr bool same_error<A, B, true> = std::is_same<typename A::Err, typename B::Err>::value;
+
+    ///Value of callback's return, that may be Result.
+    template<class T, bool = is_result<T>::value>
+    struct step_value {
+        using type = T;
+    };
+
+    template<class T>
+    struct step_value<T, true> {
+        using type = typename T::Ok;
+    };
+}
+#endif
+
+/**
+ * Transforms range into vector, stopping at the first Err.
+ *
+ * Elements of range may be Result, in which case `fn` receives Ok value
+ * and first Err element is returned as it is.
+ * `fn` may return Result too, and its first Err is returned similarly.
+ * Error types of elements and `fn` must be the same.
+ *
+ * Output is reserved upfront if range has known size, so at most one allocation is made.
+ * Elements of rvalue range are moved from, unless it is view or borrowed range, like `std::span`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<int, std::string> parse(const std::string& text);
+ *
+ * result::Result<std::vector<int>, std::string> numbers = result::try_transform(lines, parse);
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Range, class Fn>
+auto try_transform(Range&& range, Fn&& fn) {
+    using element = internal::range_element_t<Range>;
+    using output = std::invoke_result_t<Fn&, internal::step_input_t<Range>>;
+    using errors = internal::first_error<element, std::decay_t<output>>;
+    using value = std::decay_t<typename internal::step_value<std::decay_t<output>>::type>;
+    using result_type = Result<std::vector<value>, typename errors::type>;
+
+    static_assert(errors::found, "Either elements of range or return of Fn must be Result");
+    static_assert(internal::same_error<element, std::decay_t<output>>, "Elements of range and return of Fn must have the same Error");
+    static_assert(!std::is_void<value>::value, "Cannot collect void values");
+
+    std::vector<value> values;
+    values.reserve(internal::size_hint(range, 0));
+
+    for (auto&& elem : range) {
+        if constexpr (is_result<element>::value) {
+            if (elem.is_err()) {
+                return internal::err_into<result_type>(internal::forward_element<Range>(std::forward<decltype(elem)>(elem)));
+            }
+        }
+
+        decltype(auto) input = [&]() -> internal::step_input_t<Range> {
+            if constexpr (is_result<element>::value) {
+                return internal::take_ok(internal::forward_element<Range>(std::forward<decltype(elem)>(elem)));
+            } else {
+                return internal::forward_element<Range>(std::forward<decltype(elem)>(elem));
+            }
+        }();
+
+        if constexpr (is_result<std::decay_t<output>>::value) {
+            auto step = std::invoke(fn, std::forward<internal::step_input_t<Range>>(input));
+            if (step.is_err()) {
+                return internal::err_into<result_type>(std::move(step));
+            }
+            values.push_back(internal::take_ok(std::move(step)));
+        } else {
+            values.push_back(std::invoke(fn, std::forward<internal::step_input_t<Range>>(input)));
+        }
+    }
+
+    return result_type::ok(std::move(values));
+}
+
+/**
+ * Collects range of Result into Result of vector, stopping at the first Err.
+ *
+ * Output is reserved upfront if range has known size, so at most one allocation is made.
+ * Elements of rvalue range are moved from, unless it is view or borrowed range, like `std::span`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * std::vector<result::Result<int, std::string>> parsed;
+ *
+ * result::Result<std::vector<int>, std::string> numbers = result::collect(std::move(parsed));
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Range>
+auto collect(Range&& range) {
+    static_assert(is_result<internal::range_element_t<Range>>::value, "Range must contain Result");
+
+    return try_transform(std::forward<Range>(range), [](auto&& value) -> decltype(auto) {
+        return std::forward<decltype(value)>(value);
+    });
+}
+
+/**
+ * Folds range into single value, stopping at the first Err.
+ *
+ * `fn` is invoked with accumulator as rvalue and element, or its Ok value if it is Result.
+ * `fn` may return either new accumulator or Result of it.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<long, std::string> total = result::try_fold(lines, 0L, [](long sum, const std::string& line) {
+ *     return parse(line).map([sum](int num) {
+ *         return sum + num;
+ *     });
+ * });
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Range, class Acc, class Fn>
+auto try_fold(Range&& range, Acc init, Fn&& fn) {
+    using element = internal::range_element_t<Range>;
+    using output = std::decay_t<std::invoke_result_t<Fn&, Acc&&, internal::step_input_t<Range>>>;
+    using errors = internal::first_error<element, output>;
+    using result_type = Result<Acc, typename errors::type>;
+
+    static_assert(errors::found, "Either elements of range or return of Fn must be Result");
+    static_assert(internal::same_error<element, output>, "Elements of range and return of Fn must have the same Error");
+    static_assert(std::is_same<typename internal::step_value<output>::type, Acc>::value, "Fn must return accumulator or Result of it");
+
+    for (auto&& elem : range) {
+        if constexpr (is_result<element>::value) {
+            if (elem.is_err()) {
+                return internal::err_into<result_type>(internal::forward_element<Range>(std::forward<decltype(elem)>(elem)));
+            }
+        }
+
+        decltype(auto) input = [&]() -> internal::step_input_t<Range> {
+            if constexpr (is_result<element>::value) {
+                return internal::take_ok(internal::forward_element<Range>(std::forward<decltype(elem)>(elem)));
+            } else {
+                return internal::forward_element<Range>(std::forward<decltype(elem)>(elem));
+            }
+        }();
+
+        if constexpr (is_result<output>::value) {
+            auto step = std::invoke(fn, std::move(init), std::forward<internal::step_input_t<Range>>(input));
+            if (step.is_err()) {
+                return internal::err_into<result_type>(std::move(step));
+            }
+            init = internal::take_ok(std::move(step));
+        } else {
+            init = std::invoke(fn, std::move(init), std::forward<internal::step_input_t<Range>>(input));
+        }
+    }
+
+    return result_type::ok(std::move(init));
+}
+
+/**
+ * Splits range of Result into vector of Ok values and vector of Err errors, preserving order.
+ *
+ * If range can be iterated multiple times, both vectors are allocated with exact size upfront.
+ * Elements of rvalue range are moved from, unless it is view or borrowed range, like `std::span`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * auto [numbers, errors] = result::partition(std::move(parsed));
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Range>
+auto partition(Range&& range) {
+    using element = internal::range_element_t<Range>;
+    static_assert(is_result<element>::value, "Range must contain Result");
+
+    using value = typename element::Ok;
+    using error = typename element::Err;
+    static_assert(!std::is_void<value>::value && !std::is_void<error>::value, "Cannot partition void values");
+
+    std::pair<std::vector<value>, std::vector<error>> parts;
+
+    if constexpr (internal::is_forward_range<Range>) {
+        std::size_t oks = 0;
+        std::size_t len = 0;
+        for (const auto& elem : range) {
+            oks += elem.is_ok() ? 1 : 0;
+            len++;
+        }
+
+        parts.first.reserve(oks);
+        parts.second.reserve(len - oks);
+    }
+
+    for (auto&& elem : range) {
+        if (elem.is_ok()) {
+            parts.first.push_back(internal::take_ok(internal::forward_element<Range>(std::forward<decltype(elem)>(elem))));
+        } else {
+            parts.second.push_back(internal::take_error(internal::forward_element<Range>(std::forward<decltype(elem)>(elem))));
+        }
+    }
+
+    return parts;
+}
+
+} // namespace result
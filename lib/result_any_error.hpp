@@ -0,0 +1,312 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    template<class E, class = void>
+    struct has_what: std::false_type {};
+
+    template<class E>
+    struct has_what<E, std::void_t<decltype(std::string_view(std::declval<const E&>().what()))>>: std::true_type {};
+
+    ///Whether R can be viewed after call that returned it.
+    template<class R>
+    constexpr bool is_message_view = std::is_convertible<R, std::string_view>::value &&
+        (std::is_reference<R>::value || std::is_same<std::decay_t<R>, std::string_view>::value || std::is_same<std::decay_t<R>, const char*>::value);
+
+    template<class E, class = void>
+    struct has_message_view: std::false_type {};
+
+    template<class E>
+    struct has_message_view<E, std::void_t<decltype(std::declval<const E&>().message())>>: std::bool_constant<is_message_view<decltype(std::declval<const E&>().message())>> {};
+
+    template<class E, class = void>
+    struct has_message_string: std::false_type {};
+
+    template<class E>
+    struct has_message_string<E, std::void_t<decltype(std::declval<const E&>().message())>>: std::is_convertible<decltype(std::declval<const E&>().message()), std::string> {};
+
+    ///Whether default message is string returned by value, such as `std::error_code::message()`.
+    template<class E>
+    constexpr bool has_message_value = !std::is_convertible<const E&, std::string_view>::value && !has_what<E>::value &&
+        !has_message_view<E>::value && has_message_string<E>::value;
+
+    template<class T>
+    struct is_in_place_type: std::false_type {};
+
+    template<class T>
+    struct is_in_place_type<std::in_place_type_t<T>>: std::true_type {};
+}
+#endif
+
+/**
+ * Describes error stored in AnyError.
+ *
+ * By default message is the error itself if it is convertible to `std::string_view`,
+ * result of `what()` or result of `message()`.
+ * Otherwise message is empty.
+ *
+ * Message may also be returned as `std::string`, as `message()` of `std::error_code` does.
+ * Then it is formatted only when AnyError is asked for message, so erasing `std::error_code` doesn't allocate.
+ *
+ * Specialize it to provide message of own error type:
+ *
+ * ~~~~~~~~~~~~~~~
+ * template<>
+ * struct result::error_traits<HttpError> {
+ *     static std::string_view message(const HttpError& error) noexcept {
+ *         return error.reason;
+ *     }
+ * };
+ * ~~~~~~~~~~~~~~~
+ */
+template<class E>
+struct error_traits {
+    ///@returns Message view that is valid as long as error, or message string.
+    static auto message(const E& error) noexcept(!internal::has_message_value<E>) {
+        if constexpr (std::is_convertible<const E&, std::string_view>::value) {
+            return std::string_view(error);
+        } else if constexpr (internal::has_what<E>::value) {
+            return std::string_view(error.what());
+        } else if constexpr (internal::has_message_view<E>::value) {
+            return std::string_view(error.message());
+        } else if constexpr (internal::has_message_value<E>) {
+            return std::string(error.message());
+        } else {
+            static_cast<void>(error);
+            return std::string_view();
+        }
+    }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Unique address per type, which identifies type without RTTI.
+    template<class T>
+    struct type_tag {
+        static constexpr char id = 0;
+    };
+
+    struct any_error_vtable {
+        const void* type;
+        bool is_inline;
+        void (*destroy)(void* storage) noexcept;
+        ///Move constructs error into `to` and destroys one in `from`.
+        void (*relocate)(void* to, void* from) noexcept;
+        const void* (*get)(const void* storage) noexcept;
+        std::string (*message)(const void* storage);
+    };
+
+    template<class E>
+    struct any_error_inline {
+        static void destroy(void* storage) noexcept {
+            static_cast<E*>(storage)->~E();
+        }
+
+        static void relocate(void* to, void* from) noexcept {
+            new (to) E(std::move(*static_cast<E*>(from)));
+            static_cast<E*>(from)->~E();
+        }
+
+        static const void* get(const void* storage) noexcept {
+            return storage;
+        }
+
+        static std::string message(const void* storage) {
+            return std::string(error_traits<E>::message(*static_cast<const E*>(storage)));
+        }
+
+        static constexpr any_error_vtable vtable{&type_tag<E>::id, true, &destroy, &relocate, &get, &message};
+    };
+
+    template<class E>
+    struct any_error_heap {
+        static E* const& pointer(const void* storage) noexcept {
+            return *static_cast<E* const*>(storage);
+        }
+
+        static void destroy(void* storage) noexcept {
+            delete pointer(storage);
+        }
+
+        static void relocate(void* to, void* from) noexcept {
+            new (to) E*(pointer(from));
+        }
+
+        static const void* get(const void* storage) noexcept {
+            return pointer(storage);
+        }
+
+        static std::string message(const void* storage) {
+            return std::string(error_traits<E>::message(*pointer(storage)));
+        }
+
+        static constexpr any_error_vtable vtable{&type_tag<E>::id, false, &destroy, &relocate, &get, &message};
+    };
+}
+#endif
+
+/**
+ * Type erased error, that stores small errors inline without heap allocation.
+ *
+ * Error is stored inline if it fits into `AnyError::buffer_size` bytes, is aligned to at most pointer
+ * and is nothrow move constructible, otherwise it is allocated on heap.
+ * AnyError is move only and moving it never allocates.
+ *
+ * Original error can be accessed through `downcast`, which doesn't require RTTI,
+ * and its message through `message`, as described by `error_traits`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<Config, result::AnyError> load(const char* path) {
+ *     return read_file(path).map_err(result::to_any_error).and_then(parse_config);
+ * }
+ *
+ * auto config = load("app.conf");
+ * if (const std::error_code* code = config.unwrap_err().downcast<std::error_code>()) {
+ *     //Handle IO error
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+class AnyError {
+    public:
+        ///Size of inline storage.
+        static constexpr std::size_t buffer_size = 32;
+
+        ///@returns Whether E is stored without allocation.
+        template<class E>
+        static constexpr bool fits_inline = sizeof(E) <= buffer_size && alignof(E) <= alignof(void*) && std::is_nothrow_move_constructible<E>::value;
+
+    private:
+        const internal::any_error_vtable* vtable;
+        alignas(void*) unsigned char buffer[buffer_size];
+
+        void reset() noexcept {
+            if (vtable != nullptr) {
+                vtable->destroy(buffer);
+                vtable = nullptr;
+            }
+        }
+
+    public:
+        ///Creates error of type E in place.
+        template<class E, class... A>
+        explicit AnyError(std::in_place_type_t<E>, A&&... args) {
+            static_assert(std::is_same<E, std::decay_t<E>>::value, "Error must not be reference or cv-qualified");
+
+            if constexpr (fits_inline<E>) {
+                new (buffer) E(std::forward<A>(args)...);
+                vtable = &internal::any_error_inline<E>::vtable;
+            } else {
+                new (buffer) E*(new E(std::forward<A>(args)...));
+                vtable = &internal::any_error_heap<E>::vtable;
+            }
+        }
+
+        ///Erases type of error.
+        template<class E, typename = std::enable_if_t<!std::is_same<std::decay_t<E>, AnyError>::value && !internal::is_in_place_type<std::decay_t<E>>::value>>
+        AnyError(E&& error) : AnyError(std::in_place_type<std::decay_t<E>>, std::forward<E>(error)) {}
+
+        AnyError(AnyError&& right) noexcept : vtable(right.vtable) {
+            if (vtable != nullptr) {
+                vtable->relocate(buffer, right.buffer);
+                right.vtable = nullptr;
+            }
+        }
+
+        AnyError& operator=(AnyError&& right) noexcept {
+            if (this != &right) {
+                reset();
+                if (right.vtable != nullptr) {
+                    right.vtable->relocate(buffer, right.buffer);
+                    vtable = right.vtable;
+                    right.vtable = nullptr;
+                }
+            }
+            return *this;
+        }
+
+        AnyError(const AnyError&) = delete;
+        AnyError& operator=(const AnyError&) = delete;
+
+        ~AnyError() {
+            reset();
+        }
+
+        ///@returns true If error has been moved out.
+        bool empty() const noexcept {
+            return vtable == nullptr;
+        }
+
+        ///@returns true If error is stored without heap allocation.
+        bool is_inline() const noexcept {
+            return vtable == nullptr || vtable->is_inline;
+        }
+
+        ///@returns true If stored error is of type E.
+        template<class E>
+        bool is() const noexcept {
+            return vtable != nullptr && vtable->type == &internal::type_tag<E>::id;
+        }
+
+        ///Accesses stored error as E.
+        ///
+        ///@retval nullptr If stored error is not of type E.
+        template<class E>
+        E* downcast() noexcept {
+            return is<E>() ? static_cast<E*>(const_cast<void*>(vtable->get(buffer))) : nullptr;
+        }
+        ///Accesses stored error as E.
+        ///
+        ///@retval nullptr If stored error is not of type E.
+        template<class E>
+        const E* downcast() const noexcept {
+            return is<E>() ? static_cast<const E*>(vtable->get(buffer)) : nullptr;
+        }
+
+        ///@returns Message of error, which is formatted on every call.
+        std::string message() const {
+            return vtable != nullptr ? vtable->message(buffer) : std::string();
+        }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    struct to_any_error_fn {
+        template<class E>
+        AnyError operator()(E&& error) const {
+            return AnyError(std::forward<E>(error));
+        }
+    };
+}
+#endif
+
+///Converts any error into AnyError, intended for use with `map_err`.
+///
+///~~~~~~~~~~~~~~~
+///result::Result<int, result::AnyError> erased = parse(text).map_err(result::to_any_error);
+///~~~~~~~~~~~~~~~
+constexpr internal::to_any_error_fn to_any_error{};
+
+///Erases error type of Result, moving out its content.
+template<class Value, class Error>
+Result<Value, AnyError> erase_error(Result<Value, Error>&& result) {
+    return std::move(result).map_err(to_any_error);
+}
+
+///Erases error type of Result, copying its content.
+template<class Value, class Error>
+Result<Value, AnyError> erase_error(const Result<Value, Error>& result) {
+    return result.map_err(to_any_error);
+}
+
+} // namespace result
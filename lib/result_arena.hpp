@@ -0,0 +1,531 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "result.hpp"
+
+namespace result {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Block of arena memory, followed by its `size` bytes.
+    struct alignas(std::max_align_t) arena_chunk {
+        arena_chunk* next;
+        std::size_t size;
+
+        char* data() noexcept {
+            return reinterpret_cast<char*>(this + 1);
+        }
+    };
+}
+#endif
+
+/**
+ * Bump allocator for error payloads.
+ *
+ * Memory is taken from chunks, that are kept on `reset`, so once arena has grown to
+ * size of the largest request, creating errors no longer allocates.
+ * Everything allocated in arena is released at once, by `reset` or when `Scope` ends,
+ * and destructors are never called, so only trivially destructible objects are stored in it.
+ *
+ * Each thread has its own arena, `ErrorArena::current()`, which is reset at request boundary:
+ *
+ * ~~~~~~~~~~~~~~~
+ * void handle(const Request& request) {
+ *     result::ErrorArena::Scope scope;
+ *     auto response = process(request);
+ *     if (response.is_err()) {
+ *         //Error must not be used once scope ends, unless converted with to_string()
+ *         log(response.error()->to_string());
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~
+ *
+ * Arena is not thread safe, but errors allocated in it can be read by other threads
+ * as long as owning thread doesn't reset it.
+ */
+class ErrorArena {
+    public:
+        ///Size of chunk, unless larger one is required by single allocation.
+        static constexpr std::size_t default_chunk_size = 16 * 1024;
+
+        ///Position in arena, that `rewind` returns to.
+        struct Mark {
+            internal::arena_chunk* chunk;
+            char* top;
+        };
+
+        class Scope;
+
+    private:
+        internal::arena_chunk* first;
+        internal::arena_chunk* last_used;
+        char* top;
+        char* end;
+        std::size_t chunk_size;
+
+        RESULT_COLD void* allocate_slow(std::size_t size, std::size_t align) {
+            const std::size_t required = size + align - 1;
+            internal::arena_chunk* chunk = last_used != nullptr ? last_used->next : first;
+
+            //Chunks after the last used one are left from before reset, so reused if large enough.
+            if (chunk == nullptr || chunk->size < required) {
+                const std::size_t chunk_len = required > chunk_size ? required : chunk_size;
+                internal::arena_chunk* fresh = static_cast<internal::arena_chunk*>(::operator new(sizeof(internal::arena_chunk) + chunk_len));
+                fresh->next = chunk;
+                fresh->size = chunk_len;
+                if (last_used != nullptr) {
+                    last_used->next = fresh;
+                } else {
+                    first = fresh;
+                }
+                chunk = fresh;
+            }
+
+            last_used = chunk;
+            top = chunk->data();
+            end = top + chunk->size;
+            return allocate(size, align);
+        }
+
+    public:
+        ///Creates empty arena, which allocates its first chunk on first use.
+        explicit ErrorArena(std::size_t chunk_size = default_chunk_size) noexcept : first(nullptr), last_used(nullptr), top(nullptr), end(nullptr), chunk_size(chunk_size) {}
+
+        ErrorArena(const ErrorArena&) = delete;
+        ErrorArena& operator=(const ErrorArena&) = delete;
+
+        ~ErrorArena() {
+            release();
+        }
+
+        ///@returns Arena of calling thread.
+        static ErrorArena& current() noexcept {
+            thread_local ErrorArena arena;
+            return arena;
+        }
+
+        ///Allocates `size` bytes aligned to `align`, which must be power of two.
+        void* allocate(std::size_t size, std::size_t align = alignof(std::max_align_t)) {
+            const std::uintptr_t aligned = (reinterpret_cast<std::uintptr_t>(top) + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+            if (RESULT_LIKELY(aligned + size <= reinterpret_cast<std::uintptr_t>(end) && aligned != 0)) {
+                char* block = top + (aligned - reinterpret_cast<std::uintptr_t>(top));
+                top = block + size;
+                return block;
+            }
+            return allocate_slow(size, align);
+        }
+
+        ///Changes size of block of characters, in place if it is the last allocation.
+        ///
+        ///@returns Block with at least `new_size` bytes, which contains previous content.
+        char* resize(char* block, std::size_t size, std::size_t new_size) {
+            if (block != nullptr && block + size == top && new_size <= static_cast<std::size_t>(end - block)) {
+                top = block + new_size;
+                return block;
+            } else if (new_size <= size) {
+                return block;
+            }
+
+            char* moved = static_cast<char*>(allocate(new_size, 1));
+            if (size > 0) {
+                std::memcpy(moved, block, size);
+            }
+            return moved;
+        }
+
+        ///@returns Current position in arena.
+        Mark mark() const noexcept {
+            return Mark{last_used, top};
+        }
+
+        ///Releases everything allocated after `position`, keeping memory for reuse.
+        void rewind(const Mark& position) noexcept {
+            last_used = position.chunk;
+            top = position.top;
+            end = position.chunk != nullptr ? position.chunk->data() + position.chunk->size : nullptr;
+        }
+
+        ///Releases everything allocated in arena, keeping memory for reuse.
+        void reset() noexcept {
+            rewind(Mark{nullptr, nullptr});
+        }
+
+        ///Releases everything allocated in arena and returns memory to the system.
+        void release() noexcept {
+            while (first != nullptr) {
+                internal::arena_chunk* next = first->next;
+                ::operator delete(first);
+                first = next;
+            }
+            reset();
+        }
+
+        ///@returns Number of bytes reserved by arena.
+        std::size_t capacity() const noexcept {
+            std::size_t total = 0;
+            for (const internal::arena_chunk* chunk = first; chunk != nullptr; chunk = chunk->next) {
+                total += chunk->size;
+            }
+            return total;
+        }
+};
+
+///Releases everything allocated in arena during its lifetime.
+class ErrorArena::Scope {
+    private:
+        ErrorArena& arena;
+        const Mark saved;
+
+    public:
+        ///Starts scope in arena, by default one of calling thread.
+        explicit Scope(ErrorArena& arena = ErrorArena::current()) noexcept : arena(arena), saved(arena.mark()) {}
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope() {
+            arena.rewind(saved);
+        }
+};
+
+/**
+ * Immutable string, that is either static or allocated in ErrorArena.
+ *
+ * It is a trivially copyable handle, so copying it never copies characters.
+ * Arena string is valid until its arena is reset past it.
+ */
+class ArenaString {
+    private:
+        const char* ptr;
+        std::uint32_t len;
+
+        constexpr ArenaString(const char* ptr, std::size_t len) noexcept : ptr(ptr), len(static_cast<std::uint32_t>(len)) {}
+
+        friend class ArenaStringBuilder;
+        friend class ArenaError;
+
+    public:
+        ///Creates empty string.
+        constexpr ArenaString() noexcept : ptr(""), len(0) {}
+
+        ///Refers to string with static storage duration, e.g. literal, without copying it.
+        static constexpr ArenaString from_static(std::string_view text) noexcept {
+            return ArenaString(text.data(), text.size());
+        }
+
+        ///Copies string into arena, by default one of calling thread.
+        static ArenaString copy(std::string_view text, ErrorArena& arena = ErrorArena::current()) {
+            char* buffer = static_cast<char*>(arena.allocate(text.size(), 1));
+            if (!text.empty()) {
+                std::memcpy(buffer, text.data(), text.size());
+            }
+            return ArenaString(buffer, text.size());
+        }
+
+        ///@returns Pointer to characters, which are not null terminated.
+        constexpr const char* data() const noexcept {
+            return ptr;
+        }
+
+        ///@returns Number of characters.
+        constexpr std::size_t size() const noexcept {
+            return len;
+        }
+
+        ///@returns Whether string is empty.
+        constexpr bool empty() const noexcept {
+            return len == 0;
+        }
+
+        constexpr operator std::string_view() const noexcept {
+            return std::string_view(ptr, len);
+        }
+};
+
+static_assert(std::is_trivially_copyable<ArenaString>::value, "ArenaString must be trivially copyable");
+
+/**
+ * Formats string directly into ErrorArena.
+ *
+ * Accepts strings, characters, booleans and numbers.
+ * Characters are appended to the last allocation of arena, so nothing else must be allocated
+ * in the same arena until `str()` is called.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::ArenaString message = (result::ArenaStringBuilder() << "user " << id << " not found").str();
+ * ~~~~~~~~~~~~~~~
+ */
+class ArenaStringBuilder {
+    private:
+        ErrorArena& arena;
+        char* buffer;
+        std::size_t len;
+        std::size_t cap;
+
+        static constexpr std::size_t min_capacity = 64;
+        ///Enough for any integer and `%g` of double.
+        static constexpr std::size_t max_digits = 32;
+
+        void reserve(std::size_t additional) {
+            if (RESULT_UNLIKELY(len + additional > cap)) {
+                std::size_t new_cap = cap * 2 > min_capacity ? cap * 2 : min_capacity;
+                if (new_cap < len + additional) {
+                    new_cap = len + additional;
+                }
+                buffer = arena.resize(buffer, cap, new_cap);
+                cap = new_cap;
+            }
+        }
+
+    public:
+        ///Starts string in arena, by default one of calling thread.
+        explicit ArenaStringBuilder(ErrorArena& arena = ErrorArena::current()) noexcept : arena(arena), buffer(nullptr), len(0), cap(0) {}
+
+        ArenaStringBuilder(const ArenaStringBuilder&) = delete;
+        ArenaStringBuilder& operator=(const ArenaStringBuilder&) = delete;
+
+        ///Appends characters.
+        ArenaStringBuilder& append(std::string_view text) {
+            reserve(text.size());
+            if (!text.empty()) {
+                std::memcpy(buffer + len, text.data(), text.size());
+                len += text.size();
+            }
+            return *this;
+        }
+
+        ///Appends textual representation of value.
+        template<class T>
+        ArenaStringBuilder& operator<<(const T& value) {
+            if constexpr (std::is_same<T, bool>::value) {
+                return append(value ? "true" : "false");
+            } else if constexpr (std::is_same<T, char>::value) {
+                reserve(1);
+                buffer[len++] = value;
+                return *this;
+            } else if constexpr (std::is_integral<T>::value) {
+                reserve(max_digits);
+                len = static_cast<std::size_t>(std::to_chars(buffer + len, buffer + len + max_digits, value).ptr - buffer);
+                return *this;
+            } else if constexpr (std::is_floating_point<T>::value) {
+                reserve(max_digits);
+                const int written = std::snprintf(buffer + len, max_digits, "%g", static_cast<double>(value));
+                len += written > 0 ? static_cast<std::size_t>(written) : 0;
+                return *this;
+            } else {
+                static_assert(std::is_convertible<const T&, std::string_view>::value, "Value cannot be formatted");
+                return append(std::string_view(value));
+            }
+        }
+
+        ///@returns Number of characters written so far.
+        std::size_t size() const noexcept {
+            return len;
+        }
+
+        ///Finishes string, returning unused capacity to arena.
+        ///
+        ///Builder is empty afterwards and can start new string.
+        ArenaString str() {
+            const ArenaString result = len > 0 ? ArenaString(arena.resize(buffer, cap, len), len) : ArenaString();
+            buffer = nullptr;
+            len = 0;
+            cap = 0;
+            return result;
+        }
+};
+
+///Formats all parts into single string in arena of calling thread.
+template<class... A>
+ArenaString arena_format(const A&... parts) {
+    ArenaStringBuilder builder;
+    static_cast<void>((builder << ... << parts));
+    return builder.str();
+}
+
+///Key and value of ArenaError context.
+struct ArenaField {
+    ArenaString key;
+    ArenaString value;
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    struct arena_field_node {
+        ArenaField field;
+        const arena_field_node* next;
+    };
+}
+#endif
+
+///Context of ArenaError, iterated from the most recently added field.
+class ArenaContext {
+    private:
+        const internal::arena_field_node* head;
+
+    public:
+        class iterator {
+            private:
+                const internal::arena_field_node* node;
+
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = ArenaField;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const ArenaField*;
+                using reference = const ArenaField&;
+
+                explicit iterator(const internal::arena_field_node* node) noexcept : node(node) {}
+
+                reference operator*() const noexcept {
+                    return node->field;
+                }
+
+                pointer operator->() const noexcept {
+                    return &node->field;
+                }
+
+                iterator& operator++() noexcept {
+                    node = node->next;
+                    return *this;
+                }
+
+                iterator operator++(int) noexcept {
+                    iterator prev = *this;
+                    node = node->next;
+                    return prev;
+                }
+
+                bool operator==(const iterator& right) const noexcept {
+                    return node == right.node;
+                }
+
+                bool operator!=(const iterator& right) const noexcept {
+                    return node != right.node;
+                }
+        };
+
+        explicit ArenaContext(const internal::arena_field_node* head) noexcept : head(head) {}
+
+        iterator begin() const noexcept {
+            return iterator(head);
+        }
+
+        iterator end() const noexcept {
+            return iterator(nullptr);
+        }
+
+        bool empty() const noexcept {
+            return head == nullptr;
+        }
+};
+
+/**
+ * Error with code, message and key/value context, that are stored in ErrorArena.
+ *
+ * It is trivially copyable handle of 24 bytes, so `Result<T, ArenaError>` is trivially copyable
+ * and creating or propagating it, including copies made by `map_err` and `and_then`, never allocates
+ * once arena is warmed up.
+ *
+ * Error is valid until its arena is reset, use `to_string` to keep it longer.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<User, result::ArenaError> find_user(int id) {
+ *     if (!exists(id)) {
+ *         return result::Result<User, result::ArenaError>::error(result::ArenaError::make(404, "user ", id, " not found").with("table", "users"));
+ *     }
+ *     ...
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+class ArenaError {
+    private:
+        const char* text;
+        const internal::arena_field_node* fields;
+        std::uint32_t text_len;
+        std::int32_t error_code;
+
+    public:
+        ///Creates error with message, that is static or already in arena.
+        explicit ArenaError(std::int32_t code, ArenaString message = ArenaString()) noexcept : text(message.ptr), fields(nullptr), text_len(message.len), error_code(code) {}
+
+        ///Creates error with message formatted from parts in arena of calling thread.
+        template<class... A>
+        static ArenaError make(std::int32_t code, const A&... parts) {
+            return ArenaError(code, arena_format(parts...));
+        }
+
+        ///@returns Error code.
+        std::int32_t code() const noexcept {
+            return error_code;
+        }
+
+        ///@returns Message of error.
+        std::string_view message() const noexcept {
+            return std::string_view(text, text_len);
+        }
+
+        ///@returns Context fields, the most recently added first.
+        ArenaContext context() const noexcept {
+            return ArenaContext(fields);
+        }
+
+        ///@returns Value of the most recently added field with key.
+        ///@retval nullptr If there is no such field.
+        const ArenaString* find(std::string_view key) const noexcept {
+            for (const internal::arena_field_node* node = fields; node != nullptr; node = node->next) {
+                if (std::string_view(node->field.key) == key) {
+                    return &node->field.value;
+                }
+            }
+            return nullptr;
+        }
+
+        ///Adds field to context, formatting value in arena, by default one of calling thread.
+        ///
+        ///@returns Error with new field, while this error is unchanged.
+        template<class T>
+        ArenaError with(std::string_view key, const T& value, ErrorArena& arena = ErrorArena::current()) const {
+            const ArenaString field_key = ArenaString::copy(key, arena);
+            ArenaStringBuilder builder(arena);
+            builder << value;
+            const ArenaString field_value = builder.str();
+
+            ArenaError result = *this;
+            result.fields = new (arena.allocate(sizeof(internal::arena_field_node), alignof(internal::arena_field_node))) internal::arena_field_node{ArenaField{field_key, field_value}, fields};
+            return result;
+        }
+
+        ///@returns Copy of error as `message (key=value, ...)`, which outlives arena.
+        std::string to_string() const {
+            std::string result(message());
+            if (fields != nullptr) {
+                result += " (";
+                for (const internal::arena_field_node* node = fields; node != nullptr; node = node->next) {
+                    if (node != fields) {
+                        result += ", ";
+                    }
+                    result.append(node->field.key.data(), node->field.key.size());
+                    result += '=';
+                    result.append(node->field.value.data(), node->field.value.size());
+                }
+                result += ')';
+            }
+            return result;
+        }
+};
+
+static_assert(std::is_trivially_copyable<ArenaError>::value, "ArenaError must be trivially copyable");
+static_assert(std::is_trivially_destructible<internal::arena_field_node>::value, "Arena doesn't call destructors");
+
+} // namespace result
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+
+///Limits of ResultCache, that are set separately for Ok and Err entries.
+struct cache_policy {
+    ///Number of independently locked shards, each holding its part of keys and capacity.
+    std::size_t shards;
+    ///Maximum number of Ok entries, zero disables caching of values.
+    std::size_t ok_capacity;
+    ///Time after which Ok entry is loaded again.
+    std::chrono::steady_clock::duration ok_ttl;
+    ///Maximum number of Err entries, zero disables negative caching.
+    std::size_t error_capacity;
+    ///Time after which Err entry is loaded again.
+    std::chrono::steady_clock::duration error_ttl;
+
+    ///@returns Same policy with different number of shards.
+    constexpr cache_policy with_shards(std::size_t count) const noexcept {
+        return cache_policy{count, ok_capacity, ok_ttl, error_capacity, error_ttl};
+    }
+
+    ///@returns Same policy with different limits of Ok entries.
+    constexpr cache_policy with_ok(std::size_t capacity, std::chrono::steady_clock::duration ttl) const noexcept {
+        return cache_policy{shards, capacity, ttl, error_capacity, error_ttl};
+    }
+
+    ///@returns Same policy with different limits of Err entries.
+    constexpr cache_policy with_error(std::size_t capacity, std::chrono::steady_clock::duration ttl) const noexcept {
+        return cache_policy{shards, ok_capacity, ok_ttl, capacity, ttl};
+    }
+};
+
+///Default cache policy, which keeps errors for shorter time, so that recovered key is not failing for long.
+constexpr cache_policy cache_defaults{16, 4096, std::chrono::minutes(5), 1024, std::chrono::seconds(10)};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Reports loader of ResultCache, that looks up the key it loads.
+    [[noreturn]] RESULT_COLD inline void cache_reentered(const char* message) {
+#ifdef RESULT_PANIC
+        panic(message);
+#else
+        throw std::system_error(std::make_error_code(std::errc::resource_deadlock_would_occur), message);
+#endif
+    }
+}
+#endif
+
+///Counters of ResultCache.
+struct cache_stats {
+    ///Lookups that found Ok entry.
+    std::uint64_t hits;
+    ///Lookups that found Err entry.
+    std::uint64_t negative_hits;
+    ///Lookups that found nothing or expired entry.
+    std::uint64_t misses;
+    ///Calls of loader.
+    std::uint64_t loads;
+    ///Misses that waited for concurrent load of the same key instead of calling loader.
+    std::uint64_t coalesced;
+    ///Entries removed to stay within capacity.
+    std::uint64_t evictions;
+};
+
+/**
+ * Thread-safe memoizing cache of fallible lookups, that stores whole Result including errors.
+ *
+ * Failing key is served from cache as well, so that it doesn't reach backend on every lookup.
+ * Ok and Err entries have separate capacity and time to live, see `cache_policy`.
+ * Within capacity, the oldest entry of the same variant is evicted first.
+ *
+ * Keys are spread over shards, each with own lock, so that threads contend only on lookups of the same shard.
+ * Concurrent misses of the same key are coalesced: one thread calls loader, while others wait for its Result.
+ *
+ * Value and Error must be copyable, as lookup returns copy of cached Result.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::ResultCache<std::string, Address, ResolveError> resolved(result::cache_defaults.with_error(256, std::chrono::seconds(1)));
+ *
+ * result::Result<Address, ResolveError> address = resolved.get_or_load(host, [](const std::string& host) {
+ *     return resolve(host);
+ * });
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Key, class Value, class Error, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>>
+class ResultCache {
+    public:
+        using result_type = Result<Value, Error>;
+        using clock = std::chrono::steady_clock;
+
+        static_assert(std::is_copy_constructible<result_type>::value, "Value and Error must be copyable");
+
+    private:
+        ///Entries of the same variant in order of insertion, which is also order of expiration.
+        using order_list = std::list<const Key*>;
+
+        struct entry {
+            result_type result;
+            clock::time_point expires;
+            typename order_list::iterator position;
+        };
+
+        ///Load in progress.
+        struct flight {
+            std::shared_future<result_type> result;
+            std::thread::id loader;
+            ///Set when key is inserted or erased during load, so that its outdated Result is not stored.
+            bool superseded;
+        };
+
+        struct alignas(64) shard {
+            std::mutex mutex;
+            std::unordered_map<Key, entry, Hash, KeyEqual> entries;
+            order_list ok_order;
+            order_list error_order;
+            std::unordered_map<Key, flight, Hash, KeyEqual> flights;
+
+            std::uint64_t hits = 0;
+            std::uint64_t negative_hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t loads = 0;
+            std::uint64_t coalesced = 0;
+            std::uint64_t evictions = 0;
+
+            ///@returns Live entry of key, if any, counting hit or miss.
+            const result_type* lookup(const Key& key) {
+                const auto found = entries.find(key);
+                if (found == entries.end()) {
+                    misses++;
+                    return nullptr;
+                } else if (found->second.expires <= clock::now()) {
+                    erase(found);
+                    misses++;
+                    return nullptr;
+                }
+
+                (found->second.result.is_ok() ? hits : negative_hits)++;
+                return &found->second.result;
+            }
+
+            void erase(typename std::unordered_map<Key, entry, Hash, KeyEqual>::iterator found) {
+                (found->second.result.is_ok() ? ok_order : error_order).erase(found->second.position);
+                entries.erase(found);
+            }
+
+            void supersede(const Key& key) {
+                const auto pending = flights.find(key);
+                if (pending != flights.end()) {
+                    pending->second.superseded = true;
+                }
+            }
+
+            void store(const Key& key, const result_type& result, clock::time_point now, std::size_t capacity, clock::duration ttl) {
+                const auto existing = entries.find(key);
+                if (existing != entries.end()) {
+                    erase(existing);
+                }
+                if (capacity == 0) {
+                    return;
+                }
+
+                order_list& order = result.is_ok() ? ok_order : error_order;
+                const auto inserted = entries.emplace(key, entry{result, now + ttl, order.end()}).first;
+                inserted->second.position = order.insert(order.end(), &inserted->first);
+
+                while (order.size() > capacity) {
+                    erase(entries.find(*order.front()));
+                    evictions++;
+                }
+            }
+        };
+
+        std::unique_ptr<shard[]> shards;
+        std::size_t shard_count;
+        std::size_t ok_capacity;
+        std::size_t error_capacity;
+        clock::duration ok_ttl;
+        clock::duration error_ttl;
+        Hash hash;
+
+        static std::size_t shard_capacity(std::size_t capacity, std::size_t count) noexcept {
+            return (capacity + count - 1) / count;
+        }
+
+        shard& shard_of(const Key& key) const noexcept {
+            //Mixes high bits in, as shard would otherwise share low bits with bucket of its map.
+            const std::size_t bits = hash(key);
+            return shards[(bits ^ (bits >> 17) ^ (bits >> 31)) % shard_count];
+        }
+
+        void store(shard& part, const Key& key, const result_type& result, clock::time_point now) {
+            if (result.is_ok()) {
+                part.store(key, result, now, ok_capacity, ok_ttl);
+            } else {
+                part.store(key, result, now, error_capacity, error_ttl);
+            }
+        }
+
+        ///Caches loaded Result, unless it is superseded, and hands it to waiting threads.
+        result_type finish_load(shard& part, const Key& key, std::promise<result_type>& loaded, result_type&& result) {
+            {
+                std::lock_guard<std::mutex> lock(part.mutex);
+                const auto pending = part.flights.find(key);
+                if (!pending->second.superseded) {
+                    store(part, key, result, clock::now());
+                }
+                part.flights.erase(pending);
+            }
+            loaded.set_value(result);
+            return std::move(result);
+        }
+
+    public:
+        ///Creates empty cache.
+        explicit ResultCache(cache_policy policy = cache_defaults, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual())
+            : shards(new shard[policy.shards > 0 ? policy.shards : 1]), shard_count(policy.shards > 0 ? policy.shards : 1),
+              ok_capacity(shard_capacity(policy.ok_capacity, shard_count)), error_capacity(shard_capacity(policy.error_capacity, shard_count)),
+              ok_ttl(policy.ok_ttl), error_ttl(policy.error_ttl), hash(hash) {
+            for (std::size_t idx = 0; idx < shard_count; idx++) {
+                shards[idx].entries = std::unordered_map<Key, entry, Hash, KeyEqual>(0, hash, equal);
+                shards[idx].flights = std::unordered_map<Key, flight, Hash, KeyEqual>(0, hash, equal);
+            }
+        }
+
+        ResultCache(const ResultCache&) = delete;
+        ResultCache& operator=(const ResultCache&) = delete;
+
+        /**
+         * Returns cached Result of key, calling `load(key)` to get and cache it if there is none.
+         *
+         * When other thread is already loading the same key, waits for its Result instead.
+         * Exception thrown by loader is rethrown to all waiting threads and nothing is cached.
+         * If key is inserted or erased while it is loaded, loaded Result is returned, but not cached.
+         *
+         * Loader must not look up the same key, as it would wait for itself:
+         * such lookup throws `std::system_error` with `std::errc::resource_deadlock_would_occur`,
+         * or panics if `RESULT_PANIC` is defined.
+         * Loaders of different keys, that wait for each other on different threads, are not detected.
+         */
+        template<class Fn>
+        result_type get_or_load(const Key& key, Fn&& load) {
+            shard& part = shard_of(key);
+            //Promise is created only by the thread that loads, as it allocates.
+            std::optional<std::promise<result_type>> loaded;
+            std::shared_future<result_type> loading;
+            {
+                std::lock_guard<std::mutex> lock(part.mutex);
+                if (const result_type* cached = part.lookup(key)) {
+                    return *cached;
+                }
+
+                const auto pending = part.flights.find(key);
+                if (pending != part.flights.end()) {
+                    if (pending->second.loader == std::this_thread::get_id()) {
+                        internal::cache_reentered("ResultCache: loader looks up key it loads");
+                    }
+                    part.coalesced++;
+                    loading = pending->second.result;
+                } else {
+                    part.loads++;
+                    loaded.emplace();
+                    part.flights.emplace(key, flight{loaded->get_future().share(), std::this_thread::get_id(), false});
+                }
+            }
+
+            if (loading.valid()) {
+                return loading.get();
+            }
+
+#ifdef RESULT_HAS_EXCEPTIONS
+            try {
+                return finish_load(part, key, *loaded, std::invoke(std::forward<Fn>(load), key));
+            } catch (...) {
+                {
+                    std::lock_guard<std::mutex> lock(part.mutex);
+                    part.flights.erase(key);
+                }
+                loaded->set_exception(std::current_exception());
+                throw;
+            }
+#else
+            return finish_load(part, key, *loaded, std::invoke(std::forward<Fn>(load), key));
+#endif
+        }
+
+        ///@returns Cached Result of key, if it is present and not expired.
+        std::optional<result_type> find(const Key& key) const {
+            shard& part = shard_of(key);
+            std::lock_guard<std::mutex> lock(part.mutex);
+            if (const result_type* cached = part.lookup(key)) {
+                return *cached;
+            }
+            return std::nullopt;
+        }
+
+        ///Stores Result of key, replacing cached one and one that is being loaded.
+        void insert(const Key& key, const result_type& result) {
+            shard& part = shard_of(key);
+            std::lock_guard<std::mutex> lock(part.mutex);
+            part.supersede(key);
+            store(part, key, result, clock::now());
+        }
+
+        ///Removes cached Result of key, while Result that is being loaded is not cached.
+        ///
+        ///@returns true If it was present.
+        bool erase(const Key& key) {
+            shard& part = shard_of(key);
+            std::lock_guard<std::mutex> lock(part.mutex);
+            part.supersede(key);
+            const auto found = part.entries.find(key);
+            if (found == part.entries.end()) {
+                return false;
+            }
+            part.erase(found);
+            return true;
+        }
+
+        ///Removes all cached Results, keeping counters, while Results that are being loaded are not cached.
+        void clear() {
+            for (std::size_t idx = 0; idx < shard_count; idx++) {
+                shard& part = shards[idx];
+                std::lock_guard<std::mutex> lock(part.mutex);
+                for (auto& pending : part.flights) {
+                    pending.second.superseded = true;
+                }
+                part.entries.clear();
+                part.ok_order.clear();
+                part.error_order.clear();
+            }
+        }
+
+        ///@returns Number of cached Results, including expired ones that are not looked up since.
+        std::size_t size() const {
+            std::size_t total = 0;
+            for (std::size_t idx = 0; idx < shard_count; idx++) {
+                std::lock_guard<std::mutex> lock(shards[idx].mutex);
+                total += shards[idx].entries.size();
+            }
+            return total;
+        }
+
+        ///@returns Counters summed over shards.
+        cache_stats stats() const {
+            cache_stats total{0, 0, 0, 0, 0, 0};
+            for (std::size_t idx = 0; idx < shard_count; idx++) {
+                shard& part = shards[idx];
+                std::lock_guard<std::mutex> lock(part.mutex);
+                total.hits += part.hits;
+                total.negative_hits += part.negative_hits;
+                total.misses += part.misses;
+                total.loads += part.loads;
+                total.coalesced += part.coalesced;
+                total.evictions += part.evictions;
+            }
+            return total;
+        }
+};
+
+}
@@ -0,0 +1,539 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result_parallel.hpp"
+
+#ifndef RESULT_GRAPH_TRACE
+///Observes idle workers of TaskGraph, called with event name: "checked" after worker finds run not finished,
+///"parked" before it sleeps and "woken" after. Intended for tests, does nothing by default.
+#define RESULT_GRAPH_TRACE(event)
+#endif
+
+namespace result {
+
+///Outcome of node in task graph.
+enum class node_status: unsigned char {
+    ///Node has not finished, because graph was not run or was aborted by exception.
+    pending,
+    ///Task returned Ok.
+    ok,
+    ///Task returned Err.
+    failed,
+    ///Task was not started, because one of its inputs failed.
+    skipped
+};
+
+///Timing of single node, measured from start of `TaskGraph::run`.
+struct node_timing {
+    ///Name given to node.
+    const char* name;
+    node_status status;
+    ///Index of worker that run or skipped node, where 0 is calling thread.
+    unsigned thread;
+    ///When task started, or when node was skipped.
+    std::chrono::nanoseconds start;
+    ///How long task run, zero if it was skipped.
+    std::chrono::nanoseconds duration;
+};
+
+template<class Value, class Error>
+class TaskNode;
+
+template<class Error>
+class TaskGraph;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Reports misuse of graph by throwing `std::logic_error` or panic.
+    [[noreturn]] RESULT_COLD inline void graph_misuse(const char* message) {
+#ifdef RESULT_PANIC
+        panic(message);
+#else
+        throw std::logic_error(message);
+#endif
+    }
+
+    enum class graph_state: unsigned char {
+        ///Some inputs are not finished yet.
+        waiting,
+        ///Node is queued or running.
+        scheduled,
+        ///One of inputs failed, so node will never run.
+        cancelled
+    };
+
+    template<class Error>
+    struct graph_node_base {
+        const char* name;
+        std::vector<graph_node_base*> dependents;
+        std::size_t inputs = 0;
+        std::atomic<std::size_t> pending{0};
+        std::atomic<graph_state> state{graph_state::waiting};
+        node_timing timing;
+
+        explicit graph_node_base(const char* name) noexcept : name(name), timing{name, node_status::pending, 0, {}, {}} {}
+        virtual ~graph_node_base() = default;
+
+        ///Whether payload and error can be handed to another dependent, which requires copy.
+        virtual bool is_shareable() const noexcept = 0;
+        ///Runs task with payloads of inputs, all of which are Ok, and returns whether it succeeded.
+        virtual bool run() = 0;
+        ///Skips task, storing error of failed input.
+        virtual void skip(graph_node_base& input) = 0;
+        ///@returns Error for dependent, which is moved out if it is the only dependent.
+        virtual payload_t<Error> take_error() = 0;
+    };
+
+    template<class Value, class Error>
+    struct graph_node: graph_node_base<Error> {
+        std::optional<Result<Value, Error>> result;
+
+        using graph_node_base<Error>::graph_node_base;
+
+        bool is_shareable() const noexcept override {
+            return std::is_copy_constructible<payload_t<Value>>::value && std::is_copy_constructible<payload_t<Error>>::value;
+        }
+
+        void skip(graph_node_base<Error>& input) override {
+            result.emplace(result_access::error<Result<Value, Error>>(input.take_error()));
+        }
+
+        payload_t<Error> take_error() override {
+            if constexpr (std::is_void<Error>::value) {
+                return unit();
+            } else if constexpr (std::is_copy_constructible<Error>::value) {
+                if (this->dependents.size() > 1) {
+                    return *result->error();
+                }
+                return std::move(*result->error());
+            } else {
+                return std::move(*result->error());
+            }
+        }
+    };
+
+    ///Payload of input passed to task as rvalue, which is moved from input if task is its only dependent.
+    template<class Value, class Error>
+    class graph_arg {
+        graph_node<Value, Error>& input;
+        std::optional<Value> copy;
+
+        public:
+            explicit graph_arg(graph_node<Value, Error>& input) noexcept : input(input) {}
+
+            std::tuple<Value&&> forward() {
+                if constexpr (std::is_copy_constructible<Value>::value) {
+                    if (input.dependents.size() > 1) {
+                        copy.emplace(*input.result->value());
+                        return std::tuple<Value&&>(std::move(*copy));
+                    }
+                }
+                return std::tuple<Value&&>(std::move(*input.result->value()));
+            }
+    };
+
+    template<class Error>
+    class graph_arg<void, Error> {
+        public:
+            explicit graph_arg(graph_node<void, Error>&) noexcept {}
+
+            std::tuple<> forward() noexcept {
+                return std::tuple<>();
+            }
+    };
+
+    ///Return of Fn invoked with payloads of inputs, omitting void ones.
+    template<class Fn, class Error, class... In>
+    using graph_output_t = decltype(std::apply(std::declval<Fn&>(), std::tuple_cat(std::declval<graph_arg<In, Error>&>().forward()...)));
+
+    template<class Value, class Error, class Fn, class... In>
+    struct graph_task final: graph_node<Value, Error> {
+        Fn fn;
+        std::tuple<graph_node<In, Error>*...> sources;
+
+        template<class F>
+        graph_task(const char* name, F&& fn, graph_node<In, Error>*... sources) : graph_node<Value, Error>(name), fn(std::forward<F>(fn)), sources(sources...) {}
+
+        template<std::size_t... I>
+        void run_with(std::index_sequence<I...>) {
+            std::tuple<graph_arg<In, Error>...> args(*std::get<I>(sources)...);
+            static_cast<void>(args);
+            this->result.emplace(std::apply(fn, std::tuple_cat(std::get<I>(args).forward()...)));
+        }
+
+        bool run() override {
+            run_with(std::index_sequence_for<In...>());
+            return this->result->is_ok();
+        }
+    };
+
+    ///Work stealing executor of single graph run.
+    template<class Error>
+    class graph_executor {
+        using node = graph_node_base<Error>;
+        using clock = std::chrono::steady_clock;
+
+        struct alignas(cache_line) queue {
+            std::mutex lock;
+            std::deque<node*> tasks;
+        };
+
+        std::vector<queue> queues;
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> aborted;
+        const clock::time_point started;
+
+        //Idle workers sleep until epoch changes, which happens whenever task is pushed or run ends.
+        std::atomic<std::size_t> epoch;
+        std::atomic<std::size_t> sleeping;
+        std::mutex idle_lock;
+        std::condition_variable wakeup;
+#ifdef RESULT_HAS_EXCEPTIONS
+        std::exception_ptr exception;
+#endif
+
+        std::chrono::nanoseconds now() const noexcept {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started);
+        }
+
+        void push(std::size_t worker, node* task) {
+            {
+                queue& own = queues[worker];
+                std::lock_guard<std::mutex> guard(own.lock);
+                own.tasks.push_back(task);
+            }
+
+            epoch.fetch_add(1);
+            if (sleeping.load() != 0) {
+                std::lock_guard<std::mutex> guard(idle_lock);
+                wakeup.notify_one();
+            }
+        }
+
+        ///Wakes every idle worker, once there is nothing left to do.
+        void wake_all() {
+            epoch.fetch_add(1);
+            std::lock_guard<std::mutex> guard(idle_lock);
+            wakeup.notify_all();
+        }
+
+        bool finished() const noexcept {
+            return remaining.load(std::memory_order_acquire) == 0 || aborted.load(std::memory_order_acquire);
+        }
+
+        ///Sleeps until epoch differs from one seen before queues were found empty, or run ends.
+        void park(std::size_t seen) {
+            sleeping.fetch_add(1);
+            RESULT_GRAPH_TRACE("parked");
+            {
+                std::unique_lock<std::mutex> guard(idle_lock);
+                wakeup.wait(guard, [this, seen] {
+                    return epoch.load() != seen || finished();
+                });
+            }
+            RESULT_GRAPH_TRACE("woken");
+            sleeping.fetch_sub(1);
+        }
+
+        ///Takes the newest task of own queue or steals the oldest one of other worker.
+        node* pop(std::size_t worker) {
+            for (std::size_t offset = 0; offset < queues.size(); offset++) {
+                queue& victim = queues[(worker + offset) % queues.size()];
+                std::lock_guard<std::mutex> guard(victim.lock);
+                if (victim.tasks.empty()) {
+                    continue;
+                }
+
+                node* task;
+                if (offset == 0) {
+                    task = victim.tasks.back();
+                    victim.tasks.pop_back();
+                } else {
+                    task = victim.tasks.front();
+                    victim.tasks.pop_front();
+                }
+                return task;
+            }
+            return nullptr;
+        }
+
+        ///Notifies dependents of finished node, skipping whole subtree of failed one at once.
+        void complete(std::size_t worker, node* finished, bool ok) {
+            std::vector<node*> failed;
+            if (!ok) {
+                failed.push_back(finished);
+            } else {
+                for (node* dependent : finished->dependents) {
+                    graph_state waiting = graph_state::waiting;
+                    if (dependent->pending.fetch_sub(1, std::memory_order_acq_rel) == 1
+                        && dependent->state.compare_exchange_strong(waiting, graph_state::scheduled, std::memory_order_acq_rel)) {
+                        push(worker, dependent);
+                    }
+                }
+            }
+            remaining.fetch_sub(1, std::memory_order_acq_rel);
+
+            while (!failed.empty()) {
+                node* source = failed.back();
+                failed.pop_back();
+
+                for (node* dependent : source->dependents) {
+                    graph_state waiting = graph_state::waiting;
+                    if (dependent->state.compare_exchange_strong(waiting, graph_state::cancelled, std::memory_order_acq_rel)) {
+                        dependent->skip(*source);
+                        dependent->timing.status = node_status::skipped;
+                        dependent->timing.thread = static_cast<unsigned>(worker);
+                        dependent->timing.start = now();
+                        failed.push_back(dependent);
+                        remaining.fetch_sub(1, std::memory_order_acq_rel);
+                    }
+                }
+            }
+
+            if (remaining.load(std::memory_order_acquire) == 0) {
+                wake_all();
+            }
+        }
+
+        void execute(std::size_t worker, node* task) {
+            task->timing.thread = static_cast<unsigned>(worker);
+            task->timing.start = now();
+            const bool ok = task->run();
+            task->timing.duration = now() - task->timing.start;
+            task->timing.status = ok ? node_status::ok : node_status::failed;
+            complete(worker, task, ok);
+        }
+
+        void work(std::size_t worker) noexcept {
+            for (;;) {
+                //Epoch is read before checking for end of run and looking into queues,
+                //so that task pushed or run ended after that wakes worker up.
+                const std::size_t seen = epoch.load();
+                if (finished()) {
+                    return;
+                }
+                RESULT_GRAPH_TRACE("checked");
+
+                node* task = pop(worker);
+                if (task == nullptr) {
+                    park(seen);
+                    continue;
+                }
+
+#ifdef RESULT_HAS_EXCEPTIONS
+                try {
+                    execute(worker, task);
+                } catch (...) {
+                    if (!aborted.exchange(true)) {
+                        exception = std::current_exception();
+                    }
+                    wake_all();
+                    return;
+                }
+#else
+                execute(worker, task);
+#endif
+            }
+        }
+
+        public:
+            graph_executor(std::size_t workers, std::size_t nodes) : queues(workers), remaining(nodes), aborted(false), started(clock::now()), epoch(0), sleeping(0) {}
+
+            ///Runs graph on calling thread and `queues.size() - 1` other threads.
+            void run(const std::vector<std::unique_ptr<node>>& nodes) {
+                std::size_t next = 0;
+                for (const std::unique_ptr<node>& each : nodes) {
+                    if (each->inputs == 0) {
+                        each->state.store(graph_state::scheduled, std::memory_order_relaxed);
+                        queues[next++ % queues.size()].tasks.push_back(each.get());
+                    }
+                }
+
+                std::vector<std::thread> threads;
+                threads.reserve(queues.size() - 1);
+                for (std::size_t idx = 1; idx < queues.size(); idx++) {
+#ifdef RESULT_HAS_EXCEPTIONS
+                    try {
+                        threads.emplace_back([this, idx] {
+                            work(idx);
+                        });
+                    } catch (const std::system_error&) {
+                        //Calling thread steals everything left anyway.
+                        break;
+                    }
+#else
+                    threads.emplace_back([this, idx] {
+                        work(idx);
+                    });
+#endif
+                }
+                work(0);
+                for (std::thread& thread : threads) {
+                    thread.join();
+                }
+
+#ifdef RESULT_HAS_EXCEPTIONS
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+#endif
+            }
+    };
+}
+#endif
+
+///Handle of node in TaskGraph, that produces `Result<Value, Error>`.
+template<class Value, class Error>
+class TaskNode {
+    friend class TaskGraph<Error>;
+
+    internal::graph_node<Value, Error>* node;
+
+    explicit TaskNode(internal::graph_node<Value, Error>* node) noexcept : node(node) {}
+
+    public:
+        ///Type of node's Result.
+        using result_type = Result<Value, Error>;
+};
+
+/**
+ * Graph of fallible tasks, where Err short-circuits everything that depends on it.
+ *
+ * Each node is a callback returning `Result<T, Error>`, which receives Ok payloads of its inputs,
+ * omitting void ones, as rvalues, just like `and_then` does.
+ * Payload is moved into dependent if it is the only one, otherwise each dependent receives a copy.
+ *
+ * `run` executes graph on work stealing pool: node becomes ready once all inputs are Ok and
+ * it is pushed to queue of worker that finished the last input, while idle workers steal the oldest tasks,
+ * or sleep until some task is pushed.
+ * Once node returns Err, its whole subtree is skipped right away, without waiting for other inputs,
+ * and every skipped node holds the first error that reached it. So each sink ends up with either its value
+ * or the first error upstream of it.
+ *
+ * Each node records when, where and how long it run, see `timings`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::TaskGraph<Error> graph;
+ *
+ * auto page = graph.add("fetch", [&] { return fetch(url); });
+ * auto doc = graph.add("parse", parse, page);
+ * auto valid = graph.add("validate", validate, doc);
+ * auto rich = graph.add("enrich", [](Document&& doc) { return enrich(std::move(doc)); }, doc);
+ *
+ * graph.run(result::par.with_threads(4));
+ * auto report = graph.take(rich);
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Error>
+class TaskGraph {
+    std::vector<std::unique_ptr<internal::graph_node_base<Error>>> nodes;
+    bool finished = false;
+
+    template<class Value>
+    internal::graph_node<Value, Error>& finished_node(TaskNode<Value, Error> handle) const {
+        if (!finished || !handle.node->result) {
+            internal::graph_misuse("Node has not finished");
+        }
+        return *handle.node;
+    }
+
+    public:
+        TaskGraph() = default;
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator=(const TaskGraph&) = delete;
+
+        ///Adds node, that runs `fn` with payloads of `inputs` once all of them are Ok.
+        ///
+        ///Input with multiple dependents must have copyable payload and error.
+        ///
+        ///@param name Static string, that identifies node in timings.
+        template<class Fn, class... In, class Output = internal::graph_output_t<std::decay_t<Fn>, Error, In...>>
+        TaskNode<typename Output::Ok, Error> add(const char* name, Fn&& fn, TaskNode<In, Error>... inputs) {
+            static_assert(is_result<Output>::value, "Fn must return Result");
+            static_assert(std::is_same<typename Output::Err, Error>::value, "Fn must return Result with Error of graph");
+            static_assert(!std::is_reference<typename Output::Ok>::value, "Fn must not return reference");
+            using value = typename Output::Ok;
+
+            if (finished) {
+                internal::graph_misuse("Graph has already run");
+            }
+            const std::initializer_list<internal::graph_node_base<Error>*> sources = {inputs.node...};
+            for (internal::graph_node_base<Error>* input : sources) {
+                if (!input->dependents.empty() && !input->is_shareable()) {
+                    internal::graph_misuse("Input with multiple dependents must be copyable");
+                }
+            }
+
+            auto task = std::make_unique<internal::graph_task<value, Error, std::decay_t<Fn>, In...>>(name, std::forward<Fn>(fn), inputs.node...);
+            internal::graph_node<value, Error>* node = task.get();
+            for (internal::graph_node_base<Error>* input : sources) {
+                input->dependents.push_back(node);
+            }
+            node->inputs = sizeof...(In);
+            node->pending.store(sizeof...(In), std::memory_order_relaxed);
+
+            nodes.push_back(std::move(task));
+            return TaskNode<value, Error>(node);
+        }
+
+        ///Runs every node, which can be done only once.
+        ///
+        ///Exception thrown by any task stops all workers and is rethrown, leaving nodes that didn't finish pending.
+        void run(parallel_policy policy = par) {
+            if (finished) {
+                internal::graph_misuse("Graph has already run");
+            }
+            finished = true;
+
+            std::size_t threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+            threads = std::max<std::size_t>(std::min(threads, nodes.size()), 1);
+            internal::graph_executor<Error>(threads, nodes.size()).run(nodes);
+        }
+
+        ///@returns Result of finished node, which has Ok payload moved out if node had single dependent.
+        template<class Value>
+        const Result<Value, Error>& result(TaskNode<Value, Error> node) const {
+            return *finished_node(node).result;
+        }
+
+        ///Moves out Result of finished node.
+        template<class Value>
+        Result<Value, Error> take(TaskNode<Value, Error> node) {
+            return std::move(*finished_node(node).result);
+        }
+
+        ///@returns Number of nodes.
+        std::size_t size() const noexcept {
+            return nodes.size();
+        }
+
+        ///@returns Timing of every node, in order of addition.
+        std::vector<node_timing> timings() const {
+            std::vector<node_timing> result;
+            result.reserve(nodes.size());
+            for (const auto& node : nodes) {
+                result.push_back(node->timing);
+            }
+            return result;
+        }
+};
+
+} // namespace result
@@ -0,0 +1,81 @@
+#pragma once
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+#if defined(__cpp_lib_source_location)
+#include <source_location>
+#endif
+
+namespace result {
+
+/**
+ * Location in source code, captured as default argument at call site.
+ *
+ * With C++20 it wraps `std::source_location`, which is a single pointer to static data.
+ * Before C++20 it uses compiler builtins and stores file, line and function separately.
+ * Unknown location has empty file and function, and line 0.
+ */
+class source_location {
+#if defined(__cpp_lib_source_location)
+    std::source_location inner;
+
+    public:
+        constexpr source_location() noexcept : inner() {}
+        constexpr source_location(std::source_location inner) noexcept : inner(inner) {}
+
+        ///@returns Location of caller, when used as default argument.
+        static constexpr source_location current(std::source_location location = std::source_location::current()) noexcept {
+            return source_location(location);
+        }
+
+        constexpr const char* file() const noexcept {
+            return inner.file_name();
+        }
+
+        constexpr unsigned line() const noexcept {
+            return static_cast<unsigned>(inner.line());
+        }
+
+        constexpr const char* function() const noexcept {
+            return inner.function_name();
+        }
+#else
+    const char* file_name;
+    unsigned line_number;
+    const char* function_name;
+
+    public:
+        constexpr source_location() noexcept : file_name(""), line_number(0), function_name("") {}
+        constexpr source_location(const char* file, unsigned line, const char* function) noexcept : file_name(file), line_number(line), function_name(function) {}
+
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+        ///@returns Location of caller, when used as default argument.
+        static constexpr source_location current(const char* file = __builtin_FILE(), unsigned line = __builtin_LINE(), const char* function = __builtin_FUNCTION()) noexcept {
+            return source_location(file, line, function);
+        }
+#else
+        ///@returns Unknown location, as compiler doesn't provide it.
+        static constexpr source_location current() noexcept {
+            return source_location();
+        }
+#endif
+
+        constexpr const char* file() const noexcept {
+            return file_name;
+        }
+
+        constexpr unsigned line() const noexcept {
+            return line_number;
+        }
+
+        constexpr const char* function() const noexcept {
+            return function_name;
+        }
+#endif
+};
+
+} // namespace result
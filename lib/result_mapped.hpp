@@ -0,0 +1,656 @@
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#if defined(__has_include)
+#if __has_include(<sys/mman.h>) && __has_include(<unistd.h>) && __has_include(<fcntl.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+///Defined when MappedResultArray and MappedResultWriter are available.
+#define RESULT_HAS_MAPPED_FILE 1
+#endif
+#endif
+
+#include "result.hpp"
+
+namespace result {
+
+///Version of binary layout of mapped Results, which changes with every incompatible change of it.
+constexpr std::uint32_t mapped_layout_version = 1;
+
+///Reason why mapping cannot be used as array of Results.
+enum class mapped_errc {
+    ///Mapping does not start with magic of array of Results.
+    bad_magic = 1,
+    ///Mapping uses other version of layout.
+    unsupported_version,
+    ///Mapping was written on host with other byte order.
+    byte_order_mismatch,
+    ///Size or alignment of Value or Error differs from the one in mapping.
+    layout_mismatch,
+    ///Mapping is shorter than its header says.
+    truncated
+};
+
+///@returns Category of `mapped_errc`.
+inline const std::error_category& mapped_category() noexcept {
+    class category final: public std::error_category {
+        public:
+            const char* name() const noexcept override {
+                return "result_mapped";
+            }
+
+            std::string message(int code) const override {
+                switch (static_cast<mapped_errc>(code)) {
+                    case mapped_errc::bad_magic:
+                        return "not an array of Results";
+                    case mapped_errc::unsupported_version:
+                        return "unsupported layout version";
+                    case mapped_errc::byte_order_mismatch:
+                        return "written with other byte order";
+                    case mapped_errc::layout_mismatch:
+                        return "layout of Value or Error differs";
+                    case mapped_errc::truncated:
+                        return "truncated";
+                }
+                return "unknown";
+            }
+    };
+
+    static const category instance;
+    return instance;
+}
+
+///Creates `std::error_code` of `mapped_errc`.
+inline std::error_code make_error_code(mapped_errc code) noexcept {
+    return std::error_code(static_cast<int>(code), mapped_category());
+}
+
+/**
+ * Record of Result with defined binary layout, that is stored in mapped arrays.
+ *
+ * Layout of version 1 is:
+ *
+ * - Tag byte at offset 0, which is `ok_tag` or `error_tag`, while 0 denotes record that was never written;
+ * - Payload of Value or Error at offset `payload_offset`, which is the larger of both alignments;
+ * - Zeroed padding up to `sizeof(ResultRecord)`, which is multiple of payload alignment.
+ *
+ * Value and Error must be trivially copyable, so record can be used in place without deserialization,
+ * and are stored in byte order of host that wrote them, which is recorded in header of mapping.
+ * `void` is stored as empty payload.
+ */
+template<class Value, class Error>
+struct ResultRecord {
+    static_assert(!std::is_reference<Value>::value, "Reference cannot be stored outside of process");
+    static_assert(std::is_trivially_copyable<internal::payload_t<Value>>::value, "Value must be trivially copyable");
+    static_assert(std::is_trivially_copyable<internal::payload_t<Error>>::value, "Error must be trivially copyable");
+
+    ///Tag of Ok record.
+    static constexpr std::uint8_t ok_tag = 1;
+    ///Tag of Err record.
+    static constexpr std::uint8_t error_tag = 2;
+
+    ///Type of Result, that record stores.
+    using result_type = Result<Value, Error>;
+
+    std::uint8_t tag;
+    union storage {
+        internal::payload_t<Value> value;
+        internal::payload_t<Error> error;
+    } payload;
+
+    ///Offset of payload within record.
+    static constexpr std::size_t payload_offset = alignof(storage);
+
+    ///@returns true If record holds Ok.
+    bool is_ok() const noexcept {
+        return tag == ok_tag;
+    }
+
+    ///@returns true If record holds Err.
+    bool is_err() const noexcept {
+        return tag == error_tag;
+    }
+
+    ///Returns pointer to value in place.
+    ///
+    ///@retval nullptr If not-OK.
+    template<class V = Value, typename = std::enable_if_t<!std::is_void<V>::value>>
+    const V* value() const noexcept {
+        return is_ok() ? &payload.value : nullptr;
+    }
+
+    ///Returns pointer to error in place.
+    ///
+    ///@retval nullptr If not-OK.
+    template<class E = Error, typename = std::enable_if_t<!std::is_void<E>::value>>
+    const E* error() const noexcept {
+        return is_err() ? &payload.error : nullptr;
+    }
+
+    ///Stores Result, overwriting record in place.
+    void assign(const result_type& result) noexcept {
+        if (result.is_ok()) {
+            if constexpr (!std::is_void<Value>::value) {
+                payload.value = *result.value();
+            }
+            tag = ok_tag;
+        } else {
+            if constexpr (!std::is_void<Error>::value) {
+                payload.error = *result.error();
+            }
+            tag = error_tag;
+        }
+    }
+
+    ///Creates Result out of record, which must have been written.
+    ///
+    ///Err is not counted by telemetry, as it was already created by writer.
+    result_type to_result() const noexcept {
+        if (is_ok()) {
+            if constexpr (std::is_void<Value>::value) {
+                return result_type::ok();
+            } else {
+                return result_type::ok(payload.value);
+            }
+        }
+
+        if constexpr (std::is_void<Error>::value) {
+            return internal::result_access::error<result_type>();
+        } else {
+            return internal::result_access::error<result_type>(payload.error);
+        }
+    }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    /**
+     * Header of mapped array, which takes whole cache line before the first record.
+     *
+     * All fields are little endian, except `count`, which is stored in byte order of records,
+     * so it can be updated atomically:
+     *
+     * | Offset | Size | Field                                           |
+     * |--------|------|-------------------------------------------------|
+     * | 0      | 8    | magic `RSLTARR\0`                               |
+     * | 8      | 4    | layout version                                  |
+     * | 12     | 1    | byte order of records, 1 for little, 2 for big  |
+     * | 16     | 4    | size of Value                                   |
+     * | 20     | 4    | alignment of Value                              |
+     * | 24     | 4    | size of Error                                   |
+     * | 28     | 4    | alignment of Error                              |
+     * | 32     | 4    | size of record                                  |
+     * | 36     | 4    | offset of payload within record                 |
+     * | 56     | 8    | number of written records                       |
+     */
+    namespace mapped_header {
+        constexpr std::size_t size = cache_line;
+        constexpr unsigned char magic[8] = {'R', 'S', 'L', 'T', 'A', 'R', 'R', '\0'};
+
+        constexpr std::size_t version_at = 8;
+        constexpr std::size_t byte_order_at = 12;
+        constexpr std::size_t value_size_at = 16;
+        constexpr std::size_t value_align_at = 20;
+        constexpr std::size_t error_size_at = 24;
+        constexpr std::size_t error_align_at = 28;
+        constexpr std::size_t record_size_at = 32;
+        constexpr std::size_t payload_offset_at = 36;
+        constexpr std::size_t count_at = 56;
+
+        constexpr std::uint8_t little_endian = 1;
+        constexpr std::uint8_t big_endian = 2;
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Count must be lock free to be shared between processes");
+        static_assert(sizeof(std::atomic<std::uint64_t>) == sizeof(std::uint64_t), "Count must be plain 64 bit integer");
+
+        inline std::uint8_t host_byte_order() noexcept {
+            const std::uint16_t probe = 1;
+            unsigned char first;
+            std::memcpy(&first, &probe, 1);
+            return first == 1 ? little_endian : big_endian;
+        }
+
+        inline void store(unsigned char* header, std::size_t at, std::uint32_t value) noexcept {
+            for (std::size_t idx = 0; idx < 4; idx++) {
+                header[at + idx] = static_cast<unsigned char>(value >> (8 * idx));
+            }
+        }
+
+        inline std::uint32_t load(const unsigned char* header, std::size_t at) noexcept {
+            std::uint32_t value = 0;
+            for (std::size_t idx = 0; idx < 4; idx++) {
+                value |= static_cast<std::uint32_t>(header[at + idx]) << (8 * idx);
+            }
+            return value;
+        }
+
+        inline std::atomic<std::uint64_t>& count(unsigned char* header) noexcept {
+            return *reinterpret_cast<std::atomic<std::uint64_t>*>(header + count_at);
+        }
+
+        template<class Value, class Error>
+        void write(unsigned char* header) noexcept {
+            using record = ResultRecord<Value, Error>;
+
+            std::memset(header, 0, size);
+            std::memcpy(header, magic, sizeof(magic));
+            store(header, version_at, mapped_layout_version);
+            header[byte_order_at] = host_byte_order();
+            store(header, value_size_at, static_cast<std::uint32_t>(sizeof(payload_t<Value>)));
+            store(header, value_align_at, static_cast<std::uint32_t>(alignof(payload_t<Value>)));
+            store(header, error_size_at, static_cast<std::uint32_t>(sizeof(payload_t<Error>)));
+            store(header, error_align_at, static_cast<std::uint32_t>(alignof(payload_t<Error>)));
+            store(header, record_size_at, static_cast<std::uint32_t>(sizeof(record)));
+            store(header, payload_offset_at, static_cast<std::uint32_t>(record::payload_offset));
+            new (header + count_at) std::atomic<std::uint64_t>(0);
+        }
+
+        ///Checks that header of mapping with `bytes` length describes array of `ResultRecord<Value, Error>`.
+        template<class Value, class Error>
+        std::error_code validate(const unsigned char* header, std::size_t bytes) noexcept {
+            using record = ResultRecord<Value, Error>;
+
+            if (bytes < size) {
+                return make_error_code(mapped_errc::truncated);
+            }
+            if (std::memcmp(header, magic, sizeof(magic)) != 0) {
+                return make_error_code(mapped_errc::bad_magic);
+            }
+            if (load(header, version_at) != mapped_layout_version) {
+                return make_error_code(mapped_errc::unsupported_version);
+            }
+            if (header[byte_order_at] != host_byte_order()) {
+                return make_error_code(mapped_errc::byte_order_mismatch);
+            }
+            if (load(header, value_size_at) != sizeof(payload_t<Value>) || load(header, value_align_at) != alignof(payload_t<Value>)
+                || load(header, error_size_at) != sizeof(payload_t<Error>) || load(header, error_align_at) != alignof(payload_t<Error>)
+                || load(header, record_size_at) != sizeof(record) || load(header, payload_offset_at) != record::payload_offset) {
+                return make_error_code(mapped_errc::layout_mismatch);
+            }
+
+            const std::uint64_t count = reinterpret_cast<const std::atomic<std::uint64_t>*>(header + count_at)->load(std::memory_order_acquire);
+            if (count > (bytes - size) / sizeof(record)) {
+                return make_error_code(mapped_errc::truncated);
+            }
+            return std::error_code();
+        }
+    }
+}
+#endif
+
+#ifdef RESULT_HAS_MAPPED_FILE
+///Access to mapped array.
+enum class mapped_access {
+    ///Records can be only read.
+    read,
+    ///Records can be also appended.
+    append
+};
+
+/**
+ * Array of Results stored in memory mapped file or shared memory segment, using layout of ResultRecord.
+ *
+ * Reading is zero copy: records are accessed in place in the mapping and Result is created only on `to_result`.
+ * Appending writes record in place and then publishes it by incrementing count in header with release store,
+ * so another process, that maps the same file, sees only complete records.
+ * There must be single writer at time, while readers are unlimited.
+ *
+ * Array never grows on its own: `push` fails once capacity is exhausted, use MappedResultWriter to grow file.
+ * Readers can pick up records beyond their mapping with `refresh`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * auto replay = result::MappedResultArray<Sample, Fault>::open("samples.bin").unwrap();
+ * for (const auto& record : replay) {
+ *     if (const Sample* sample = record.value()) {
+ *         feed(*sample);
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Value, class Error>
+class MappedResultArray {
+    template<class, class>
+    friend class MappedResultWriter;
+
+    public:
+        ///Type of stored record.
+        using record_type = ResultRecord<Value, Error>;
+        ///Type of stored Result.
+        using result_type = Result<Value, Error>;
+
+    private:
+        static_assert(alignof(record_type) <= internal::cache_line, "Record alignment cannot exceed cache line");
+        static_assert(offsetof(record_type, payload) == record_type::payload_offset, "Payload must follow tag at its alignment");
+
+        int fd;
+        unsigned char* base;
+        std::size_t bytes;
+        mapped_access access;
+
+        MappedResultArray(int fd, mapped_access access) noexcept : fd(fd), base(nullptr), bytes(0), access(access) {}
+
+        static std::error_code last_error() noexcept {
+            return std::error_code(errno, std::system_category());
+        }
+
+        static std::size_t bytes_for(std::size_t capacity) noexcept {
+            return internal::mapped_header::size + capacity * sizeof(record_type);
+        }
+
+        record_type* records() const noexcept {
+            return reinterpret_cast<record_type*>(base + internal::mapped_header::size);
+        }
+
+        std::atomic<std::uint64_t>& count() const noexcept {
+            return internal::mapped_header::count(base);
+        }
+
+        void unmap() noexcept {
+            if (base != nullptr) {
+                ::munmap(base, bytes);
+                base = nullptr;
+                bytes = 0;
+            }
+        }
+
+        ///Maps whole file, replacing current mapping.
+        std::error_code map() noexcept {
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                return last_error();
+            }
+
+            const std::size_t size = static_cast<std::size_t>(info.st_size);
+            if (size < internal::mapped_header::size) {
+                return make_error_code(mapped_errc::truncated);
+            }
+            const int protection = access == mapped_access::append ? PROT_READ | PROT_WRITE : PROT_READ;
+            void* mapped = ::mmap(nullptr, size, protection, MAP_SHARED, fd, 0);
+            if (mapped == MAP_FAILED) {
+                return last_error();
+            }
+
+            unmap();
+            base = static_cast<unsigned char*>(mapped);
+            bytes = size;
+            return std::error_code();
+        }
+
+        ///Resizes file to fit `capacity` records and maps it again.
+        std::error_code resize(std::size_t capacity) noexcept {
+            if (::ftruncate(fd, static_cast<off_t>(bytes_for(capacity))) != 0) {
+                return last_error();
+            }
+            return map();
+        }
+
+        static Result<MappedResultArray, std::error_code> make(int fd, std::size_t capacity) {
+            MappedResultArray array(fd, mapped_access::append);
+            if (const std::error_code error = array.resize(capacity)) {
+                return failure(error);
+            }
+            internal::mapped_header::write<Value, Error>(array.base);
+            return Result<MappedResultArray, std::error_code>::ok(std::move(array));
+        }
+
+        static Result<MappedResultArray, std::error_code> attach(int fd, mapped_access access) {
+            MappedResultArray array(fd, access);
+            std::error_code error = array.map();
+            if (!error) {
+                error = internal::mapped_header::validate<Value, Error>(array.base, array.bytes);
+            }
+            if (error) {
+                return failure(error);
+            }
+            return Result<MappedResultArray, std::error_code>::ok(std::move(array));
+        }
+
+        static Result<MappedResultArray, std::error_code> failure(std::error_code error) noexcept {
+            return Result<MappedResultArray, std::error_code>::error(error);
+        }
+
+    public:
+        MappedResultArray(const MappedResultArray&) = delete;
+        MappedResultArray& operator=(const MappedResultArray&) = delete;
+
+        MappedResultArray(MappedResultArray&& other) noexcept : fd(other.fd), base(other.base), bytes(other.bytes), access(other.access) {
+            other.fd = -1;
+            other.base = nullptr;
+            other.bytes = 0;
+        }
+
+        MappedResultArray& operator=(MappedResultArray&& other) noexcept {
+            std::swap(fd, other.fd);
+            std::swap(base, other.base);
+            std::swap(bytes, other.bytes);
+            std::swap(access, other.access);
+            return *this;
+        }
+
+        ~MappedResultArray() {
+            unmap();
+            if (fd >= 0) {
+                ::close(fd);
+            }
+        }
+
+        ///Creates file at `path`, replacing existing one, with room for `capacity` records.
+        static Result<MappedResultArray, std::error_code> create(const char* path, std::size_t capacity) {
+            const int fd = ::open(path, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (fd < 0) {
+                return failure(last_error());
+            }
+            return make(fd, capacity);
+        }
+
+        ///Initializes shared memory segment or file given by descriptor, e.g. from `shm_open`, with room for `capacity` records.
+        ///
+        ///Descriptor is duplicated, so caller still owns it.
+        static Result<MappedResultArray, std::error_code> create(int descriptor, std::size_t capacity) {
+            const int fd = ::fcntl(descriptor, F_DUPFD_CLOEXEC, 0);
+            if (fd < 0) {
+                return failure(last_error());
+            }
+            return make(fd, capacity);
+        }
+
+        ///Maps existing array at `path`, validating its header against `Value` and `Error`.
+        static Result<MappedResultArray, std::error_code> open(const char* path, mapped_access access = mapped_access::read) {
+            const int fd = ::open(path, (access == mapped_access::append ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+            if (fd < 0) {
+                return failure(last_error());
+            }
+            return attach(fd, access);
+        }
+
+        ///Maps existing array in shared memory segment or file given by descriptor, validating its header.
+        ///
+        ///Descriptor is duplicated, so caller still owns it.
+        static Result<MappedResultArray, std::error_code> open(int descriptor, mapped_access access = mapped_access::read) {
+            const int fd = ::fcntl(descriptor, F_DUPFD_CLOEXEC, 0);
+            if (fd < 0) {
+                return failure(last_error());
+            }
+            return attach(fd, access);
+        }
+
+        ///@returns Number of published records.
+        std::size_t size() const noexcept {
+            return static_cast<std::size_t>(count().load(std::memory_order_acquire));
+        }
+
+        ///@returns Number of records, that fit into current mapping.
+        std::size_t capacity() const noexcept {
+            return (bytes - internal::mapped_header::size) / sizeof(record_type);
+        }
+
+        ///@returns true If there are no published records.
+        bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        ///@returns Record in place, which must be published and within mapping.
+        const record_type& operator[](std::size_t idx) const noexcept {
+            return records()[idx];
+        }
+
+        ///@returns Pointer to the first record.
+        const record_type* begin() const noexcept {
+            return records();
+        }
+
+        ///@returns Pointer past the last published record within mapping.
+        const record_type* end() const noexcept {
+            const std::size_t published = size();
+            return records() + (published < capacity() ? published : capacity());
+        }
+
+        ///Appends Result in place, publishing it to readers.
+        ///
+        ///@returns false If array is full or it is not opened for append, as its mapping is read only.
+        bool push(const result_type& result) noexcept {
+            if (RESULT_UNLIKELY(access != mapped_access::append)) {
+                return false;
+            }
+            const std::uint64_t idx = count().load(std::memory_order_relaxed);
+            if (RESULT_UNLIKELY(idx >= capacity())) {
+                return false;
+            }
+            records()[idx].assign(result);
+            count().store(idx + 1, std::memory_order_release);
+            return true;
+        }
+
+        ///Maps the whole file again, if it was grown by writer in other process.
+        Result<void, std::error_code> refresh() {
+            struct stat info;
+            if (::fstat(fd, &info) != 0) {
+                return Result<void, std::error_code>::error(last_error());
+            }
+            if (static_cast<std::size_t>(info.st_size) != bytes) {
+                if (const std::error_code error = map()) {
+                    return Result<void, std::error_code>::error(error);
+                }
+            }
+            return Result<void, std::error_code>::ok();
+        }
+
+        ///Writes mapped records to file and waits until it is done.
+        Result<void, std::error_code> flush() {
+            if (::msync(base, bytes, MS_SYNC) != 0) {
+                return Result<void, std::error_code>::error(last_error());
+            }
+            return Result<void, std::error_code>::ok();
+        }
+};
+
+/**
+ * Streaming writer of MappedResultArray, which grows file as needed.
+ *
+ * File grows geometrically, by at least `chunk` records, and `finish` truncates it to exact size.
+ * Growing remaps file, so readers in the same process must not hold references to records across `push`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * auto writer = result::MappedResultWriter<Sample, Fault>::create("samples.bin").unwrap();
+ * for (auto& input : inputs) {
+ *     writer.push(measure(input)).unwrap();
+ * }
+ * writer.finish().unwrap();
+ * writer.flush().unwrap();
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Value, class Error>
+class MappedResultWriter {
+    public:
+        ///Type of written array.
+        using array_type = MappedResultArray<Value, Error>;
+        ///Type of written Result.
+        using result_type = Result<Value, Error>;
+
+        ///Default number of records, by which file grows at least.
+        static constexpr std::size_t default_chunk = 1 << 16;
+
+    private:
+        array_type array;
+        std::size_t chunk;
+
+        MappedResultWriter(array_type&& array, std::size_t chunk) noexcept : array(std::move(array)), chunk(chunk > 0 ? chunk : 1) {}
+
+        RESULT_COLD Result<void, std::error_code> grow_and_push(const result_type& result) {
+            const std::size_t capacity = array.capacity();
+            if (const std::error_code error = array.resize(capacity + (capacity > chunk ? capacity : chunk))) {
+                return Result<void, std::error_code>::error(error);
+            }
+            array.push(result);
+            return Result<void, std::error_code>::ok();
+        }
+
+    public:
+        ///Creates file at `path`, replacing existing one.
+        static Result<MappedResultWriter, std::error_code> create(const char* path, std::size_t chunk = default_chunk) {
+            return array_type::create(path, chunk).map([chunk](array_type&& array) {
+                return MappedResultWriter(std::move(array), chunk);
+            });
+        }
+
+        ///Opens existing file at `path` to append to it.
+        static Result<MappedResultWriter, std::error_code> append(const char* path, std::size_t chunk = default_chunk) {
+            return array_type::open(path, mapped_access::append).map([chunk](array_type&& array) {
+                return MappedResultWriter(std::move(array), chunk);
+            });
+        }
+
+        ///Appends Result in place, growing file if it is full.
+        Result<void, std::error_code> push(const result_type& result) {
+            if (RESULT_LIKELY(array.push(result))) {
+                return Result<void, std::error_code>::ok();
+            }
+            return grow_and_push(result);
+        }
+
+        ///@returns Number of written records.
+        std::size_t size() const noexcept {
+            return array.size();
+        }
+
+        ///@returns Array being written.
+        const array_type& records() const noexcept {
+            return array;
+        }
+
+        ///Truncates file to written records.
+        ///
+        ///Records reach file once kernel writes mapping back, use `flush` to wait for it.
+        ///Writer can still be used afterwards, growing file again.
+        Result<void, std::error_code> finish() {
+            if (const std::error_code error = array.resize(array.size())) {
+                return Result<void, std::error_code>::error(error);
+            }
+            return Result<void, std::error_code>::ok();
+        }
+
+        ///Writes mapped records to file and waits until it is done.
+        Result<void, std::error_code> flush() {
+            return array.flush();
+        }
+};
+#endif
+
+} // namespace result
+
+namespace std {
+    template<>
+    struct is_error_code_enum<result::mapped_errc>: true_type {};
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result_algorithm.hpp"
+
+namespace result {
+
+///Execution policy of parallel algorithms.
+struct parallel_policy {
+    ///Number of threads, including calling one. Zero means `std::thread::hardware_concurrency()`.
+    unsigned threads;
+    ///Minimal number of elements that thread takes at once.
+    ///
+    ///Range is split into at most `blocks_per_thread` blocks per thread, unless it makes them smaller than grain.
+    std::size_t grain;
+
+    ///@returns Same policy with different number of threads.
+    constexpr parallel_policy with_threads(unsigned count) const noexcept {
+        return parallel_policy{count, grain};
+    }
+
+    ///@returns Same policy with different grain.
+    constexpr parallel_policy with_grain(std::size_t size) const noexcept {
+        return parallel_policy{threads, size};
+    }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    constexpr std::size_t blocks_per_thread = 8;
+}
+#endif
+
+///Default parallel policy, which uses all cores.
+constexpr parallel_policy par{0, 1024};
+
+/**
+ * Transforms range into vector in parallel, yielding either all values in order or the first Err.
+ *
+ * Semantics are the same as of try_transform, except that range must be random access and
+ * `fn` is invoked concurrently.
+ *
+ * Range is split into blocks, which threads take in increasing order.
+ * Once Err is found, its index is published through atomic, and threads stop processing
+ * anything after it, while elements before it are still processed.
+ * So returned Err is always the one with the lowest index, regardless of scheduling.
+ *
+ * Exception thrown by `fn` stops processing after its element, the same way as Err does,
+ * and it is rethrown to the caller, unless element before it fails first, as with try_transform.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<Record, std::string> validate(const Row& row);
+ *
+ * auto records = result::par_try_transform(result::par, rows, validate);
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Range, class Fn>
+auto par_try_transform(parallel_policy policy, Range&& range, Fn&& fn) {
+    using element = internal::range_element_t<Range>;
+    using output = std::invoke_result_t<Fn&, internal::step_input_t<Range>>;
+    using errors = internal::first_error<element, std::decay_t<output>>;
+    using value = std::decay_t<typename internal::step_value<std::decay_t<output>>::type>;
+    using error = typename errors::type;
+    using result_type = Result<std::vector<value>, error>;
+
+    static_assert(std::is_base_of<std::random_access_iterator_tag, internal::range_category_t<Range>>::value, "Range must be random access");
+    static_assert(errors::found, "Either elements of range or return of Fn must be Result");
+    static_assert(internal::same_error<element, std::decay_t<output>>, "Elements of range and return of Fn must have the same Error");
+    static_assert(!std::is_void<value>::value, "Cannot collect void values");
+
+    ///Output of block, filled by single thread.
+    struct block {
+        std::vector<value> values;
+        std::optional<internal::payload_t<error>> failure;
+#ifdef RESULT_HAS_EXCEPTIONS
+        std::exception_ptr exception;
+#endif
+    };
+
+    const auto first = std::begin(range);
+    const std::size_t len = static_cast<std::size_t>(std::end(range) - first);
+    std::size_t thread_count = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+    thread_count = std::max<std::size_t>(thread_count, 1);
+    //Few blocks per thread balance load while keeping number of allocations low.
+    const std::size_t grain = std::max<std::size_t>({policy.grain, (len + thread_count * internal::blocks_per_thread - 1) / (thread_count * internal::blocks_per_thread), 1});
+    const std::size_t block_count = (len + grain - 1) / grain;
+    thread_count = std::min(thread_count, std::max<std::size_t>(block_count, 1));
+
+    std::vector<block> blocks(block_count);
+    std::atomic<std::size_t> next_block(0);
+    //Index of first known Err or exception, everything after it can be skipped.
+    std::atomic<std::size_t> limit(len);
+
+    const auto cancel_after = [&limit](std::size_t idx) noexcept {
+        std::size_t current = limit.load(std::memory_order_relaxed);
+        while (idx < current && !limit.compare_exchange_weak(current, idx, std::memory_order_relaxed)) {}
+    };
+
+    const auto run_block = [&](std::size_t block_idx) {
+        block& out = blocks[block_idx];
+        const std::size_t begin = block_idx * grain;
+        const std::size_t end = std::min(begin + grain, len);
+        out.values.reserve(end - begin);
+
+        for (std::size_t idx = begin; idx < end && idx < limit.load(std::memory_order_relaxed); idx++) {
+            auto&& elem = first[static_cast<std::ptrdiff_t>(idx)];
+
+            if constexpr (is_result<element>::value) {
+                if (elem.is_err()) {
+                    if constexpr (std::is_void<error>::value) {
+                        out.failure.emplace();
+                    } else {
+                        out.failure.emplace(internal::take_error(internal::forward_element<Range>(std::forward<decltype(elem)>(elem))));
+                    }
+                    cancel_after(idx);
+                    return;
+                }
+            }
+
+            decltype(auto) input = [&]() -> internal::step_input_t<Range> {
+                if constexpr (is_result<element>::value) {
+                    return internal::take_ok(internal::forward_element<Range>(std::forward<decltype(elem)>(elem)));
+                } else {
+                    return internal::forward_element<Range>(std::forward<decltype(elem)>(elem));
+                }
+            }();
+
+            if constexpr (is_result<std::decay_t<output>>::value) {
+                auto step = std::invoke(fn, std::forward<internal::step_input_t<Range>>(input));
+                if (step.is_err()) {
+                    if constexpr (std::is_void<error>::value) {
+                        out.failure.emplace();
+                    } else {
+                        out.failure.emplace(internal::take_error(std::move(step)));
+                    }
+                    cancel_after(idx);
+                    return;
+                }
+                out.values.push_back(internal::take_ok(std::move(step)));
+            } else {
+                out.values.push_back(std::invoke(fn, std::forward<internal::step_input_t<Range>>(input)));
+            }
+        }
+    };
+
+    const auto worker = [&]() noexcept {
+        for (;;) {
+            const std::size_t block_idx = next_block.fetch_add(1, std::memory_order_relaxed);
+            if (block_idx >= block_count || block_idx * grain >= limit.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+#ifdef RESULT_HAS_EXCEPTIONS
+            try {
+                run_block(block_idx);
+            } catch (...) {
+                //Each processed element has its value, so exception is thrown on the next one.
+                block& out = blocks[block_idx];
+                out.exception = std::current_exception();
+                cancel_after(block_idx * grain + out.values.size());
+            }
+#else
+            run_block(block_idx);
+#endif
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+    for (std::size_t idx = 1; idx < thread_count; idx++) {
+#ifdef RESULT_HAS_EXCEPTIONS
+        try {
+            threads.emplace_back(worker);
+        } catch (const std::system_error&) {
+            //Calling thread processes everything left anyway.
+            break;
+        }
+#else
+        threads.emplace_back(worker);
+#endif
+    }
+    worker();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    //Block stops at its first Err or exception, so the lowest one is in block of limit.
+    const std::size_t error_idx = limit.load(std::memory_order_relaxed);
+    if (error_idx < len) {
+        block& failed = blocks[error_idx / grain];
+#ifdef RESULT_HAS_EXCEPTIONS
+        if (failed.exception) {
+            std::rethrow_exception(failed.exception);
+        }
+#endif
+        if constexpr (std::is_void<error>::value) {
+            return internal::result_access::error<result_type>();
+        } else {
+            return internal::result_access::error<result_type>(std::move(*failed.failure));
+        }
+    }
+
+    std::vector<value> values;
+    if (block_count == 1) {
+        values = std::move(blocks[0].values);
+    } else {
+        values.reserve(len);
+        for (block& part : blocks) {
+            std::move(part.values.begin(), part.values.end(), std::back_inserter(values));
+        }
+    }
+
+    return result_type::ok(std::move(values));
+}
+
+} // namespace result
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+
+template<class... Stages>
+class Pipeline;
+
+template<class Source, class... Stages>
+class Pipe;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    struct pipe_access;
+}
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    template<class Fn>
+    struct pipe_map {
+        Fn fn;
+    };
+
+    template<class Fn>
+    struct pipe_map_err {
+        Fn fn;
+    };
+
+    template<class Fn>
+    struct pipe_and_then {
+        Fn fn;
+        source_location location;
+    };
+
+    template<class Fn>
+    struct pipe_or_else {
+        Fn fn;
+    };
+
+    template<class Stage>
+    struct pipe_kind {
+        static constexpr bool is_map = false;
+        static constexpr bool is_map_err = false;
+        static constexpr bool is_and_then = false;
+        static constexpr bool is_or_else = false;
+    };
+
+    template<class Fn>
+    struct pipe_kind<pipe_map<Fn>>: pipe_kind<void> {
+        static constexpr bool is_map = true;
+    };
+
+    template<class Fn>
+    struct pipe_kind<pipe_map_err<Fn>>: pipe_kind<void> {
+        static constexpr bool is_map_err = true;
+    };
+
+    template<class Fn>
+    struct pipe_kind<pipe_and_then<Fn>>: pipe_kind<void> {
+        static constexpr bool is_and_then = true;
+    };
+
+    template<class Fn>
+    struct pipe_kind<pipe_or_else<Fn>>: pipe_kind<void> {
+        static constexpr bool is_or_else = true;
+    };
+
+    ///Result of applying stages one by one, as the same chain of member combinators would return.
+    template<class R, class... Stages>
+    struct pipe_output {
+        using type = R;
+    };
+
+    template<class Value, class Error, class Fn, class... Rest>
+    struct pipe_output<Result<Value, Error>, pipe_map<Fn>, Rest...>: pipe_output<Result<invoke_payload_result_t<Fn&, payload_t<Value>&&>, Error>, Rest...> {};
+
+    template<class Value, class Error, class Fn, class... Rest>
+    struct pipe_output<Result<Value, Error>, pipe_map_err<Fn>, Rest...>: pipe_output<Result<Value, invoke_payload_result_t<Fn&, payload_t<Error>&&>>, Rest...> {};
+
+    template<class Value, class Error, class Fn, class... Rest>
+    struct pipe_output<Result<Value, Error>, pipe_and_then<Fn>, Rest...>: pipe_output<invoke_payload_result_t<Fn&, payload_t<Value>&&>, Rest...> {
+        static_assert(is_result<invoke_payload_result_t<Fn&, payload_t<Value>&&>>::value, "Fn of and_then must return result");
+        static_assert(std::is_same<typename invoke_payload_result_t<Fn&, payload_t<Value>&&>::Err, Error>::value, "Fn of and_then must return Result with the same Error type");
+    };
+
+    template<class Value, class Error, class Fn, class... Rest>
+    struct pipe_output<Result<Value, Error>, pipe_or_else<Fn>, Rest...>: pipe_output<invoke_payload_result_t<Fn&, payload_t<Error>&&>, Rest...> {
+        static_assert(is_result<invoke_payload_result_t<Fn&, payload_t<Error>&&>>::value, "Fn of or_else must return result");
+        static_assert(std::is_same<typename invoke_payload_result_t<Fn&, payload_t<Error>&&>::Ok, Value>::value, "Fn of or_else must return Result with the same Value type");
+    };
+
+    template<class Out, std::size_t I, class Stages, class P>
+    constexpr Out pipe_err(Stages& stages, P&& error);
+
+    ///Continues pipeline at stage `I` with Ok payload, which is passed along as rvalue without being moved,
+    ///until some stage consumes it.
+    template<class Out, std::size_t I, class Stages, class P>
+    constexpr Out pipe_ok(Stages& stages, P&& value) {
+        if constexpr (I == std::tuple_size<Stages>::value) {
+            return result_access::ok<Out>(std::forward<P>(value));
+        } else {
+            auto& stage = std::get<I>(stages);
+            using kind = pipe_kind<std::remove_reference_t<decltype(stage)>>;
+
+            if constexpr (kind::is_map) {
+                using mapped = payload_t<invoke_payload_result_t<decltype(stage.fn)&, P&&>>;
+                return pipe_ok<Out, I + 1>(stages, make_payload<mapped>(stage.fn, std::forward<P>(value)));
+            } else if constexpr (kind::is_and_then) {
+                auto next = invoke_payload(stage.fn, std::forward<P>(value));
+                if (RESULT_LIKELY(next.is_ok())) {
+                    return pipe_ok<Out, I + 1>(stages, std::move(result_access::ok_payload(next)));
+                }
+                return pipe_err<Out, I + 1>(stages, std::move(result_access::error_payload(next)));
+            } else {
+                return pipe_ok<Out, I + 1>(stages, std::forward<P>(value));
+            }
+        }
+    }
+
+    ///Continues pipeline at stage `I` with Err payload.
+    template<class Out, std::size_t I, class Stages, class P>
+    constexpr Out pipe_err(Stages& stages, P&& error) {
+        if constexpr (I == std::tuple_size<Stages>::value) {
+            return result_access::error<Out>(std::forward<P>(error));
+        } else {
+            auto& stage = std::get<I>(stages);
+            using kind = pipe_kind<std::remove_reference_t<decltype(stage)>>;
+
+            if constexpr (kind::is_map_err) {
+                using mapped = payload_t<invoke_payload_result_t<decltype(stage.fn)&, P&&>>;
+                return pipe_err<Out, I + 1>(stages, make_payload<mapped>(stage.fn, std::forward<P>(error)));
+            } else if constexpr (kind::is_or_else) {
+                auto next = invoke_payload(stage.fn, std::forward<P>(error));
+                if (next.is_ok()) {
+                    return pipe_ok<Out, I + 1>(stages, std::move(result_access::ok_payload(next)));
+                }
+                return pipe_err<Out, I + 1>(stages, std::move(result_access::error_payload(next)));
+            } else {
+                if constexpr (kind::is_and_then && has_propagate_hook<std::remove_reference_t<P>>::value) {
+                    error.on_propagate(stage.location);
+                }
+                return pipe_err<Out, I + 1>(stages, std::forward<P>(error));
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * Chain of combinators, that is not applied to any Result yet.
+ *
+ * It is created by `pipe::map`, `pipe::map_err`, `pipe::and_then` and `pipe::or_else`,
+ * and pipelines can be joined with `|` into longer ones, so the same pipeline can be reused.
+ * Applying it to Result with `|` creates lazy Pipe.
+ */
+template<class... Stages>
+class Pipeline {
+    friend struct internal::pipe_access;
+
+    std::tuple<Stages...> stages;
+
+    public:
+        ///Creates pipeline out of stages.
+        constexpr explicit Pipeline(std::tuple<Stages...>&& stages) : stages(std::move(stages)) {}
+};
+
+/**
+ * Result with chain of combinators, that is evaluated lazily and fused into single pass.
+ *
+ * It is created by applying Pipeline to Result with `|` and evaluated when converted to Result or by `eval`.
+ * Result is moved into Pipe, or copied if it is lvalue.
+ * Combinators have semantics of their member counterparts, receiving payloads as rvalues:
+ *
+ * - `map(fn)` maps Ok value;
+ * - `map_err(fn)` maps Err error;
+ * - `and_then(fn)` chains Ok value to fallible `fn`, with the same Error;
+ * - `or_else(fn)` chains Err error to fallible `fn`, with the same Value.
+ *
+ * Unlike member chain, no intermediate Result is created: tag of source is tested once,
+ * then Ok value flows from one callback straight into the next one,
+ * and the only other branches are tests of Results returned by `and_then` and `or_else` callbacks.
+ * Once Err occurs, it is passed only to `map_err` and `or_else` stages.
+ *
+ * ~~~~~~~~~~~~~~~
+ * using namespace result::pipe;
+ *
+ * result::Result<Config, ConfigError> config = read_file(path)
+ *     | and_then(parse_toml)
+ *     | map([](Toml&& toml) { return Config(std::move(toml)); })
+ *     | map_err([](IoError&& error) { return ConfigError(std::move(error)); });
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Source, class... Stages>
+class Pipe {
+    friend struct internal::pipe_access;
+
+    Source source;
+    std::tuple<Stages...> stages;
+
+    template<class R>
+    constexpr Pipe(R&& source, std::tuple<Stages...>&& stages) : source(std::forward<R>(source)), stages(std::move(stages)) {}
+
+    public:
+        ///Type of Result, that pipe evaluates to.
+        using result_type = typename internal::pipe_output<Source, Stages...>::type;
+
+        Pipe(const Pipe&) = delete;
+        Pipe& operator=(const Pipe&) = delete;
+        Pipe(Pipe&&) = default;
+
+        ///Evaluates pipeline, consuming source.
+        constexpr result_type eval() && {
+            if (source.is_ok()) {
+                return internal::pipe_ok<result_type, 0>(stages, std::move(internal::result_access::ok_payload(source)));
+            }
+            return internal::pipe_err<result_type, 0>(stages, std::move(internal::result_access::error_payload(source)));
+        }
+
+        ///Evaluates pipeline, consuming source.
+        constexpr operator result_type() && {
+            return std::move(*this).eval();
+        }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    struct pipe_access {
+        template<class... Stages>
+        static constexpr std::tuple<Stages...>&& stages(Pipeline<Stages...>&& pipeline) noexcept {
+            return std::move(pipeline.stages);
+        }
+
+        template<class... Stages>
+        static constexpr const std::tuple<Stages...>& stages(const Pipeline<Stages...>& pipeline) noexcept {
+            return pipeline.stages;
+        }
+
+        template<class Source, class... Stages, class R>
+        static constexpr Pipe<Source, Stages...> bind(R&& source, std::tuple<Stages...>&& stages) {
+            return Pipe<Source, Stages...>(std::forward<R>(source), std::move(stages));
+        }
+
+        template<class Source, class... Stages, class... Next>
+        static constexpr Pipe<Source, Stages..., Next...> append(Pipe<Source, Stages...>&& pipe, std::tuple<Next...>&& stages) {
+            return Pipe<Source, Stages..., Next...>(std::move(pipe.source), std::tuple_cat(std::move(pipe.stages), std::move(stages)));
+        }
+    };
+}
+#endif
+
+///Joins two pipelines.
+template<class... Stages, class... Next>
+constexpr Pipeline<Stages..., Next...> operator|(Pipeline<Stages...>&& left, Pipeline<Next...>&& right) {
+    return Pipeline<Stages..., Next...>(std::tuple_cat(internal::pipe_access::stages(std::move(left)), internal::pipe_access::stages(std::move(right))));
+}
+
+///Joins two pipelines.
+template<class... Stages, class... Next>
+constexpr Pipeline<Stages..., Next...> operator|(const Pipeline<Stages...>& left, const Pipeline<Next...>& right) {
+    return Pipeline<Stages..., Next...>(std::tuple_cat(internal::pipe_access::stages(left), internal::pipe_access::stages(right)));
+}
+
+///Binds Result to pipeline, creating lazy Pipe.
+template<class R, class... Stages, typename = std::enable_if_t<is_result<std::decay_t<R>>::value>>
+constexpr Pipe<std::decay_t<R>, Stages...> operator|(R&& source, Pipeline<Stages...>&& pipeline) {
+    return internal::pipe_access::bind<std::decay_t<R>>(std::forward<R>(source), internal::pipe_access::stages(std::move(pipeline)));
+}
+
+///Binds Result to pipeline, creating lazy Pipe.
+template<class R, class... Stages, typename = std::enable_if_t<is_result<std::decay_t<R>>::value>>
+constexpr Pipe<std::decay_t<R>, Stages...> operator|(R&& source, const Pipeline<Stages...>& pipeline) {
+    return internal::pipe_access::bind<std::decay_t<R>>(std::forward<R>(source), std::tuple<Stages...>(internal::pipe_access::stages(pipeline)));
+}
+
+///Appends more stages to Pipe.
+template<class Source, class... Stages, class... Next>
+constexpr Pipe<Source, Stages..., Next...> operator|(Pipe<Source, Stages...>&& pipe, Pipeline<Next...>&& pipeline) {
+    return internal::pipe_access::append(std::move(pipe), internal::pipe_access::stages(std::move(pipeline)));
+}
+
+///Appends more stages to Pipe.
+template<class Source, class... Stages, class... Next>
+constexpr Pipe<Source, Stages..., Next...> operator|(Pipe<Source, Stages...>&& pipe, const Pipeline<Next...>& pipeline) {
+    return internal::pipe_access::append(std::move(pipe), std::tuple<Next...>(internal::pipe_access::stages(pipeline)));
+}
+
+///Stages of Pipeline, that can be brought into scope with `using namespace result::pipe`.
+namespace pipe {
+    ///Creates Pipeline, that maps Ok value.
+    template<class Fn>
+    constexpr Pipeline<internal::pipe_map<std::decay_t<Fn>>> map(Fn&& fn) {
+        return Pipeline<internal::pipe_map<std::decay_t<Fn>>>(std::make_tuple(internal::pipe_map<std::decay_t<Fn>>{std::forward<Fn>(fn)}));
+    }
+
+    ///Creates Pipeline, that maps Err error.
+    template<class Fn>
+    constexpr Pipeline<internal::pipe_map_err<std::decay_t<Fn>>> map_err(Fn&& fn) {
+        return Pipeline<internal::pipe_map_err<std::decay_t<Fn>>>(std::make_tuple(internal::pipe_map_err<std::decay_t<Fn>>{std::forward<Fn>(fn)}));
+    }
+
+    ///Creates Pipeline, that chains Ok value to `fn` returning Result with the same Error.
+    ///
+    ///Err, that passes this stage, is propagated from its location.
+    template<class Fn>
+    constexpr Pipeline<internal::pipe_and_then<std::decay_t<Fn>>> and_then(Fn&& fn RESULT_CALLER_LOCATION_NEXT) {
+        return Pipeline<internal::pipe_and_then<std::decay_t<Fn>>>(std::make_tuple(internal::pipe_and_then<std::decay_t<Fn>>{std::forward<Fn>(fn), location}));
+    }
+
+    ///Creates Pipeline, that chains Err error to `fn` returning Result with the same Value.
+    template<class Fn>
+    constexpr Pipeline<internal::pipe_or_else<std::decay_t<Fn>>> or_else(Fn&& fn) {
+        return Pipeline<internal::pipe_or_else<std::decay_t<Fn>>>(std::make_tuple(internal::pipe_or_else<std::decay_t<Fn>>{std::forward<Fn>(fn)}));
+    }
+}
+
+} // namespace result
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "result.hpp"
+
+#if defined(__cpp_lib_atomic_wait)
+///Defined when ResultSlot blocks in `std::atomic::wait` instead of spinning.
+#define RESULT_HAS_ATOMIC_WAIT 1
+#endif
+
+namespace result {
+
+template<class Value, class Error>
+class ResultSlot;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    enum class slot_state: std::uint32_t {
+        ///Nothing is published.
+        empty,
+        ///Continuation is registered, but nothing is published yet.
+        continued,
+        ///Result is published.
+        ready
+    };
+
+    template<class Slot, class NewSlot, class Fn>
+    struct slot_continuation {
+        ///Invokes callback, destroying it along with every other use of slot.
+        static typename NewSlot::result_type consume(Slot& slot, void* storage) noexcept {
+            Fn& stored = *std::launder(static_cast<Fn*>(storage));
+            Fn fn(std::move(stored));
+            stored.~Fn();
+            return std::move(slot.get()).and_then(std::move(fn), slot.location);
+        }
+
+        static void run(Slot& slot, void* storage) noexcept {
+            NewSlot& next = *static_cast<NewSlot*>(slot.next);
+            //Publishing is the last access, as consumer of next may reset or destroy slot right after.
+            next.set(consume(slot, storage));
+        }
+
+        ///Destroys continuation that never ran.
+        static void discard(void* storage) noexcept {
+            std::launder(static_cast<Fn*>(storage))->~Fn();
+        }
+    };
+}
+#endif
+
+/**
+ * One-shot slot, that hands single Result from producer thread to consumer thread without locks.
+ *
+ * Producer constructs Result in place with `emplace_ok`, `emplace_err` or `set`,
+ * while consumer polls with `is_ready` or blocks in `wait`, which uses `std::atomic::wait` when available.
+ * Slot has no heap allocation, no mutex and takes whole cache lines, so slots in array never share one.
+ *
+ * Instead of waiting, consumer may chain `then`, which behaves as `and_then` on the published Result
+ * and publishes its outcome into next slot. It runs on producer thread, right after publishing,
+ * or on calling thread if Result is already published, and it must not throw.
+ *
+ * After Result is consumed, slot can be `reset` and re-used, which is what ResultSlotPool does.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::ResultSlotPool<Config, std::error_code> pool;
+ *
+ * auto& slot = pool.acquire();
+ * workers.submit([&slot] {
+ *     slot.set(load_config());
+ * });
+ *
+ * auto config = slot.take();
+ * pool.release(slot);
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Value, class Error>
+class alignas(internal::cache_line) ResultSlot {
+    template<class, class, class>
+    friend struct internal::slot_continuation;
+
+    public:
+        ///Type of published Result.
+        using result_type = Result<Value, Error>;
+
+        ///Size of inline storage for callback of `then`.
+        static constexpr std::size_t continuation_size = 4 * sizeof(void*);
+
+    private:
+        std::atomic<internal::slot_state> state;
+        alignas(result_type) unsigned char buffer[sizeof(result_type)];
+
+        void (*continuation)(ResultSlot&, void*) noexcept;
+        void (*discard)(void*) noexcept;
+        void* next;
+        source_location location;
+        alignas(std::max_align_t) unsigned char callback[continuation_size];
+
+        result_type& stored() noexcept {
+            return *std::launder(reinterpret_cast<result_type*>(buffer));
+        }
+
+        ///Makes constructed Result visible to consumer and runs continuation, if any.
+        void publish() noexcept {
+            if (state.exchange(internal::slot_state::ready, std::memory_order_acq_rel) == internal::slot_state::continued) {
+                continuation(*this, callback);
+                return;
+            }
+#ifdef RESULT_HAS_ATOMIC_WAIT
+            state.notify_one();
+#endif
+        }
+
+    public:
+        ///Creates empty slot.
+        ResultSlot() noexcept : state(internal::slot_state::empty), continuation(nullptr), discard(nullptr), next(nullptr), location() {}
+
+        ResultSlot(const ResultSlot&) = delete;
+        ResultSlot& operator=(const ResultSlot&) = delete;
+
+        ~ResultSlot() {
+            reset();
+        }
+
+        ///Publishes Ok constructed in place.
+        ///
+        ///Must be called at most once, until slot is reset.
+        template<class... A>
+        void emplace_ok(A&&... value) {
+            new (buffer) result_type(result_type::ok(std::forward<A>(value)...));
+            publish();
+        }
+
+        ///Publishes Err constructed in place.
+        ///
+        ///Must be called at most once, until slot is reset.
+        template<class... A>
+        void emplace_err(A&&... error) {
+            new (buffer) result_type(internal::result_access::error<result_type>(std::forward<A>(error)...));
+            publish();
+        }
+
+        ///Publishes Result.
+        ///
+        ///Must be called at most once, until slot is reset.
+        void set(result_type&& result) noexcept(std::is_nothrow_move_constructible<result_type>::value) {
+            new (buffer) result_type(std::move(result));
+            publish();
+        }
+
+        ///@returns true If Result is published.
+        bool is_ready() const noexcept {
+            return state.load(std::memory_order_acquire) == internal::slot_state::ready;
+        }
+
+        ///Blocks until Result is published.
+        void wait() const noexcept {
+            for (internal::slot_state current = state.load(std::memory_order_acquire); current != internal::slot_state::ready; current = state.load(std::memory_order_acquire)) {
+#ifdef RESULT_HAS_ATOMIC_WAIT
+                state.wait(current, std::memory_order_acquire);
+#else
+                std::this_thread::yield();
+#endif
+            }
+        }
+
+        ///Waits for Result, giving access to it.
+        ///
+        ///Must not be called if `then` is registered, as continuation consumes Result.
+        result_type& get() noexcept {
+            wait();
+            return stored();
+        }
+
+        ///Waits for Result and moves it out.
+        result_type take() noexcept(std::is_nothrow_move_constructible<result_type>::value) {
+            return std::move(get());
+        }
+
+        ///Registers continuation, which is invoked as `and_then` on published Result, publishing its outcome into `into`.
+        ///
+        ///Callback must be nothrow move constructible and fit into `continuation_size` bytes.
+        ///Neither `get` nor `take` can be used once continuation is registered, while `into` can be waited on
+        ///or chained further.
+        ///
+        ///@returns `into`
+        template<class Fn, class NewValue>
+        ResultSlot<NewValue, Error>& then(ResultSlot<NewValue, Error>& into, Fn&& fn RESULT_CALLER_LOCATION_NEXT) {
+            using callback_type = std::decay_t<Fn>;
+            static_assert(std::is_same<decltype(std::declval<result_type>().and_then(std::declval<callback_type>())), Result<NewValue, Error>>::value, "Fn must return Result of next slot");
+            static_assert(sizeof(callback_type) <= continuation_size && alignof(callback_type) <= alignof(std::max_align_t), "Fn must fit into continuation_size");
+            static_assert(std::is_nothrow_move_constructible<callback_type>::value, "Fn must be nothrow move constructible");
+
+            new (callback) callback_type(std::forward<Fn>(fn));
+            continuation = &internal::slot_continuation<ResultSlot, ResultSlot<NewValue, Error>, callback_type>::run;
+            discard = &internal::slot_continuation<ResultSlot, ResultSlot<NewValue, Error>, callback_type>::discard;
+            next = &into;
+            this->location = location;
+
+            internal::slot_state expected = internal::slot_state::empty;
+            if (!state.compare_exchange_strong(expected, internal::slot_state::continued, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                //Already published, so producer will not look at continuation.
+                continuation(*this, callback);
+            }
+            return into;
+        }
+
+        ///Destroys published Result and makes slot empty, so it can be published again.
+        ///
+        ///Must be called only by consumer, once producer has published Result, or before anything is published.
+        void reset() noexcept {
+            const internal::slot_state current = state.load(std::memory_order_acquire);
+            if (current == internal::slot_state::ready) {
+                stored().~result_type();
+            } else if (current == internal::slot_state::continued) {
+                discard(callback);
+            }
+            state.store(internal::slot_state::empty, std::memory_order_relaxed);
+            continuation = nullptr;
+            discard = nullptr;
+            next = nullptr;
+        }
+};
+
+/**
+ * Pool of ResultSlot, that recycles slots instead of allocating them for every task.
+ *
+ * Slots are allocated in chunks, that are never freed until pool is destroyed, so references stay valid.
+ * Pool itself is not thread safe: slots are acquired and released by the same thread,
+ * which is usually the one consuming Results, while producers only publish into them.
+ */
+template<class Value, class Error>
+class ResultSlotPool {
+    public:
+        ///Type of slot.
+        using slot_type = ResultSlot<Value, Error>;
+
+        ///Number of slots allocated at once.
+        static constexpr std::size_t chunk_size = 64;
+
+    private:
+        std::vector<std::unique_ptr<slot_type[]>> chunks;
+        std::vector<slot_type*> free;
+
+    public:
+        ///Creates pool with capacity for at least `reserve` slots.
+        explicit ResultSlotPool(std::size_t reserve = 0) {
+            while (free.size() < reserve) {
+                grow();
+            }
+        }
+
+        ResultSlotPool(const ResultSlotPool&) = delete;
+        ResultSlotPool& operator=(const ResultSlotPool&) = delete;
+
+        ///Allocates another chunk of slots.
+        void grow() {
+            chunks.emplace_back(new slot_type[chunk_size]);
+            slot_type* chunk = chunks.back().get();
+            free.reserve(chunks.size() * chunk_size);
+            for (std::size_t idx = chunk_size; idx > 0; idx--) {
+                free.push_back(&chunk[idx - 1]);
+            }
+        }
+
+        ///@returns Empty slot, allocating new chunk only if all slots are in use.
+        slot_type& acquire() {
+            if (RESULT_UNLIKELY(free.empty())) {
+                grow();
+            }
+            slot_type* slot = free.back();
+            free.pop_back();
+            return *slot;
+        }
+
+        ///Resets slot and returns it to pool.
+        ///
+        ///Producer must have already published into slot, unless it never got it.
+        void release(slot_type& slot) noexcept {
+            slot.reset();
+            free.push_back(&slot);
+        }
+
+        ///@returns Number of slots, that can be acquired without allocation.
+        std::size_t available() const noexcept {
+            return free.size();
+        }
+
+        ///@returns Number of allocated slots.
+        std::size_t capacity() const noexcept {
+            return chunks.size() * chunk_size;
+        }
+};
+
+} // namespace result
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "result_location.hpp"
+
+///Error telemetry, which is enabled by defining `RESULT_TELEMETRY` for whole program.
+///
+///When enabled, `Result::error`, conversion from `Err` and failed `unwrap`/`unwrap_err`
+///count events per error type and call site, using thread local counters.
+///Counters are never reset, so they can be exported as monotonic metrics.
+///
+///~~~~~~~~~~~~~~~
+///for (const result::error_site& site : result::error_telemetry_snapshot()) {
+///    metrics.counter("errors", {{"type", site.type}, {"file", site.file}, {"line", site.line}}).set(site.count);
+///}
+///~~~~~~~~~~~~~~~
+namespace result {
+
+///Kind of error event.
+enum class error_event: unsigned char {
+    ///Err is created by `Result::error` or from `Err`.
+    created,
+    ///`unwrap` is called on Err.
+    unwrap_failed,
+    ///`unwrap_err` is called on Ok.
+    unwrap_err_failed
+};
+
+///Number of error events at single call site.
+struct error_site {
+    ///Name of error type.
+    std::string_view type;
+    ///Source file of call site, or empty if it is unknown.
+    const char* file;
+    ///Line of call site, or 0 if it is unknown.
+    unsigned line;
+    ///Function of call site, or empty if it is unknown.
+    const char* function;
+    error_event event;
+    std::uint64_t count;
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Name of type, extracted from signature of function.
+    template<class T>
+    std::string_view type_name() noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+        const std::string_view signature = __PRETTY_FUNCTION__;
+        const std::size_t start = signature.find("T = ") + 4;
+        const std::size_t end = signature.find_first_of(";]", start);
+        return signature.substr(start, end - start);
+#elif defined(_MSC_VER)
+        const std::string_view signature = __FUNCSIG__;
+        const std::size_t start = signature.find("type_name<") + 10;
+        const std::size_t end = signature.rfind(">(");
+        return signature.substr(start, end - start);
+#else
+        return std::string_view();
+#endif
+    }
+
+    using type_name_fn = std::string_view (*)() noexcept;
+
+    struct telemetry_key {
+        type_name_fn type;
+        const char* file;
+        unsigned line;
+        const char* function;
+        error_event event;
+
+        bool operator==(const telemetry_key& right) const noexcept {
+            return type == right.type && file == right.file && line == right.line && function == right.function && event == right.event;
+        }
+    };
+
+    ///Counter, which is written only by owning thread and read by anyone.
+    struct telemetry_slot {
+        ///Set once key is written.
+        std::atomic<bool> used{false};
+        telemetry_key key{};
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    ///Counters of single thread, which are kept after thread exits to be adopted by next thread.
+    struct telemetry_table {
+        static constexpr std::size_t capacity = 256;
+
+        telemetry_slot slots[capacity];
+        ///Events that didn't fit into table.
+        std::atomic<std::uint64_t> dropped{0};
+        std::atomic<bool> in_use{true};
+        telemetry_table* next = nullptr;
+
+        static void bump(std::atomic<std::uint64_t>& counter) noexcept {
+            //Single writer doesn't need atomic read-modify-write.
+            counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+
+        void increment(const telemetry_key& key) noexcept {
+            std::size_t hash = reinterpret_cast<std::uintptr_t>(key.file) ^ reinterpret_cast<std::uintptr_t>(key.type);
+            hash = (hash ^ (static_cast<std::size_t>(key.line) << 8) ^ static_cast<std::size_t>(key.event)) * 0x9e3779b97f4a7c15ull;
+
+            for (std::size_t probe = 0; probe < capacity; probe++) {
+                telemetry_slot& slot = slots[(hash + probe) % capacity];
+
+                if (!slot.used.load(std::memory_order_relaxed)) {
+                    slot.key = key;
+                    slot.count.store(1, std::memory_order_relaxed);
+                    slot.used.store(true, std::memory_order_release);
+                    return;
+                } else if (slot.key == key) {
+                    bump(slot.count);
+                    return;
+                }
+            }
+
+            bump(dropped);
+        }
+    };
+
+    inline std::atomic<telemetry_table*> telemetry_tables{nullptr};
+
+    ///Takes table of exited thread or registers new one.
+    inline telemetry_table* acquire_telemetry_table() {
+        for (telemetry_table* table = telemetry_tables.load(std::memory_order_acquire); table != nullptr; table = table->next) {
+            bool in_use = false;
+            if (table->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire)) {
+                return table;
+            }
+        }
+
+        telemetry_table* table = new telemetry_table();
+        table->next = telemetry_tables.load(std::memory_order_relaxed);
+        while (!telemetry_tables.compare_exchange_weak(table->next, table, std::memory_order_release, std::memory_order_relaxed)) {}
+        return table;
+    }
+
+    struct telemetry_thread {
+        telemetry_table* table;
+
+        telemetry_thread() : table(acquire_telemetry_table()) {}
+        ~telemetry_thread() {
+            table->in_use.store(false, std::memory_order_release);
+        }
+    };
+
+    inline telemetry_table& local_telemetry_table() {
+        thread_local telemetry_thread thread;
+        return *thread.table;
+    }
+
+    ///Records error event of type E.
+    template<class E>
+    void record_error(error_event event, const source_location& location) noexcept {
+        local_telemetry_table().increment(telemetry_key{&type_name<E>, location.file(), location.line(), location.function(), event});
+    }
+}
+#endif
+
+///Aggregates counters of all threads, merging the same call sites.
+///
+///It is lock free and can be called concurrently with recording,
+///in which case events that happen during snapshot may be missed until next one.
+inline std::vector<error_site> error_telemetry_snapshot() {
+    std::vector<error_site> sites;
+
+    for (internal::telemetry_table* table = internal::telemetry_tables.load(std::memory_order_acquire); table != nullptr; table = table->next) {
+        for (const internal::telemetry_slot& slot : table->slots) {
+            if (!slot.used.load(std::memory_order_acquire)) {
+                continue;
+            }
+
+            const internal::telemetry_key& key = slot.key;
+            const std::string_view type = key.type();
+            const std::uint64_t count = slot.count.load(std::memory_order_relaxed);
+
+            bool merged = false;
+            for (error_site& site : sites) {
+                if (site.event == key.event && site.line == key.line && site.type == type && std::strcmp(site.file, key.file) == 0 && std::strcmp(site.function, key.function) == 0) {
+                    site.count += count;
+                    merged = true;
+                    break;
+                }
+            }
+
+            if (!merged) {
+                sites.push_back(error_site{type, key.file, key.line, key.function, key.event, count});
+            }
+        }
+    }
+
+    return sites;
+}
+
+///@returns Number of events that were not recorded, because thread had too many distinct call sites.
+inline std::uint64_t error_telemetry_dropped() noexcept {
+    std::uint64_t dropped = 0;
+    for (internal::telemetry_table* table = internal::telemetry_tables.load(std::memory_order_acquire); table != nullptr; table = table->next) {
+        dropped += table->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+} // namespace result
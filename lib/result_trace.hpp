@@ -0,0 +1,338 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<execinfo.h>)
+#include <cstdlib>
+#include <execinfo.h>
+///Defined when stack trace can be captured.
+#define RESULT_HAS_STACK_TRACE 1
+#endif
+#endif
+
+#include "result.hpp"
+
+namespace result {
+
+///Raw stack trace, that is symbolized only when requested.
+///
+///It is empty on platforms without `<execinfo.h>`.
+class stack_trace {
+    public:
+        ///Maximum number of captured frames.
+        static constexpr std::size_t max_frames = 32;
+
+    private:
+        void* frames[max_frames];
+        std::size_t len;
+
+    public:
+        ///Creates empty trace.
+        stack_trace() noexcept : frames(), len(0) {}
+
+        ///Captures stack of calling thread, omitting this function and `skip` innermost frames.
+        RESULT_COLD static stack_trace capture(std::size_t skip = 0) noexcept {
+            stack_trace trace;
+#ifdef RESULT_HAS_STACK_TRACE
+            void* raw[max_frames + 8];
+            const int captured = ::backtrace(raw, static_cast<int>(max_frames + 8));
+            for (std::size_t idx = skip + 1; idx < static_cast<std::size_t>(captured) && trace.len < max_frames; idx++) {
+                trace.frames[trace.len++] = raw[idx];
+            }
+#else
+            static_cast<void>(skip);
+#endif
+            return trace;
+        }
+
+        ///@returns Number of frames.
+        std::size_t size() const noexcept {
+            return len;
+        }
+
+        ///@returns true If no frames were captured.
+        bool empty() const noexcept {
+            return len == 0;
+        }
+
+        ///@returns Return address of frame, where 0 is the innermost one.
+        const void* frame(std::size_t idx) const noexcept {
+            return frames[idx];
+        }
+
+        ///Resolves frames into human readable lines, which is slow and allocates.
+        std::vector<std::string> symbolize() const {
+            std::vector<std::string> lines;
+#ifdef RESULT_HAS_STACK_TRACE
+            if (len == 0) {
+                return lines;
+            }
+
+            char** symbols = ::backtrace_symbols(frames, static_cast<int>(len));
+            if (symbols == nullptr) {
+                return lines;
+            }
+
+            lines.reserve(len);
+            for (std::size_t idx = 0; idx < len; idx++) {
+                lines.emplace_back(symbols[idx]);
+            }
+            std::free(symbols);
+#endif
+            return lines;
+        }
+};
+
+///Single step in context trail of Traced error.
+struct trace_hop {
+    ///Where error passed through.
+    source_location location;
+    ///Static note added by `result::context`, or nullptr for `and_then`.
+    const char* note;
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    inline std::atomic<std::uint32_t> trace_sampling_period(0);
+
+    ///Decides whether newly created error captures stack trace.
+    inline bool sample_trace() noexcept {
+        const std::uint32_t period = trace_sampling_period.load(std::memory_order_relaxed);
+        if (RESULT_LIKELY(period == 0)) {
+            return false;
+        }
+
+        thread_local std::uint32_t created = 0;
+        if (++created >= period) {
+            created = 0;
+            return true;
+        }
+        return false;
+    }
+}
+#endif
+
+///Sets how often Traced error captures stack trace on creation.
+///
+///@param period Every `period`-th Traced error created by each thread captures stack trace, 0 disables sampling.
+///
+///@returns Previous period.
+inline std::uint32_t set_trace_sampling(std::uint32_t period) noexcept {
+    return internal::trace_sampling_period.exchange(period, std::memory_order_relaxed);
+}
+
+/**
+ * Error wrapper, that records where it was created and where it passed through.
+ *
+ * Creation location is taken by `Result::error` and conversion from `Err`,
+ * hops are added by `and_then` and by `map_err(result::context(...))`.
+ * Trail has fixed inline capacity of `Hops`, further hops are only counted.
+ *
+ * Stack trace is captured only when sampling, set by `result::set_trace_sampling`, selects error
+ * or when `unwrap` fails on it, and it is symbolized only by `describe`.
+ * So creating Traced costs only copying location and checking sampling counter.
+ *
+ * Tracing is opt-in by error type, Result of any other error doesn't change in size nor code.
+ *
+ * ~~~~~~~~~~~~~~~
+ * using Error = result::Traced<std::error_code>;
+ *
+ * result::Result<Config, Error> load(const char* path) {
+ *     return read_file(path).and_then(parse).map_err(result::context("loading config"));
+ * }
+ *
+ * if (auto config = load(path); config.is_err()) {
+ *     log(config.error()->describe());
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+template<class E, std::size_t Hops = 4>
+class Traced {
+    static_assert(Hops > 0, "Traced must have space for at least one hop");
+
+    public:
+        ///Hops that were added.
+        class trail_view {
+            const trace_hop* first;
+            std::size_t len;
+
+            public:
+                constexpr trail_view(const trace_hop* first, std::size_t len) noexcept : first(first), len(len) {}
+
+                constexpr const trace_hop* begin() const noexcept {
+                    return first;
+                }
+
+                constexpr const trace_hop* end() const noexcept {
+                    return first + len;
+                }
+
+                constexpr std::size_t size() const noexcept {
+                    return len;
+                }
+
+                constexpr bool empty() const noexcept {
+                    return len == 0;
+                }
+
+                constexpr const trace_hop& operator[](std::size_t idx) const noexcept {
+                    return first[idx];
+                }
+        };
+
+    private:
+        E inner;
+        source_location created;
+        trace_hop trail_hops[Hops];
+        std::size_t hop_count;
+        mutable std::shared_ptr<const stack_trace> trace;
+
+        void capture(std::size_t skip) const {
+            trace = std::make_shared<const stack_trace>(stack_trace::capture(skip + 1));
+        }
+
+    public:
+        ///Wraps error, recording location of caller.
+        Traced(E error, const source_location& location = source_location::current()) : inner(std::move(error)), created(location), trail_hops(), hop_count(0), trace() {
+            if (RESULT_UNLIKELY(internal::sample_trace())) {
+                capture(0);
+            }
+        }
+
+        ///@returns Wrapped error.
+        E& error() noexcept {
+            return inner;
+        }
+        ///@returns Wrapped error.
+        const E& error() const noexcept {
+            return inner;
+        }
+
+        ///@returns Location where error was created.
+        const source_location& origin() const noexcept {
+            return created;
+        }
+
+        ///@returns Recorded hops, from the oldest.
+        trail_view trail() const noexcept {
+            return trail_view(trail_hops, hop_count < Hops ? hop_count : Hops);
+        }
+
+        ///@returns Number of hops that didn't fit into trail.
+        std::size_t dropped_hops() const noexcept {
+            return hop_count < Hops ? 0 : hop_count - Hops;
+        }
+
+        ///Records that error passed through location.
+        ///
+        ///@param note Static string or nullptr.
+        void add_hop(const source_location& location, const char* note = nullptr) noexcept {
+            if (hop_count < Hops) {
+                trail_hops[hop_count] = trace_hop{location, note};
+            }
+            hop_count++;
+        }
+
+        ///@returns Captured stack trace or nullptr if there is none.
+        const stack_trace* backtrace() const noexcept {
+            return trace.get();
+        }
+
+        ///Captures stack trace of caller, unless it is already captured.
+        RESULT_COLD void capture_backtrace() const {
+            if (!trace) {
+                capture(1);
+            }
+        }
+
+        ///Called by `and_then` that propagates error.
+        void on_propagate(const source_location& location) noexcept {
+            add_hop(location);
+        }
+
+        ///Called by failed `unwrap` before it throws or panics.
+        void on_unwrap_failed(const source_location&) const {
+            capture_backtrace();
+        }
+
+        ///@returns Multi line description of origin, trail and symbolized stack trace.
+        std::string describe() const {
+            const auto append_location = [](std::string& text, const source_location& location) {
+                text.append(location.file());
+                text.push_back(':');
+                text.append(std::to_string(location.line()));
+                text.append(" in ");
+                text.append(location.function());
+            };
+
+            std::string text("created at ");
+            append_location(text, created);
+
+            for (const trace_hop& hop : trail()) {
+                text.append("\n  via ");
+                append_location(text, hop.location);
+                if (hop.note != nullptr) {
+                    text.append(": ");
+                    text.append(hop.note);
+                }
+            }
+            if (dropped_hops() != 0) {
+                text.append("\n  and ");
+                text.append(std::to_string(dropped_hops()));
+                text.append(" more");
+            }
+
+            if (trace) {
+                text.append("\nstack trace:");
+                for (const std::string& line : trace->symbolize()) {
+                    text.append("\n  ");
+                    text.append(line);
+                }
+            }
+
+            return text;
+        }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    struct context_fn {
+        const char* note;
+        source_location location;
+
+        template<class E, std::size_t Hops>
+        Traced<E, Hops> operator()(Traced<E, Hops>&& error) const noexcept(std::is_nothrow_move_constructible<E>::value) {
+            error.add_hop(location, note);
+            return std::move(error);
+        }
+
+        template<class E, std::size_t Hops>
+        Traced<E, Hops> operator()(const Traced<E, Hops>& error) const {
+            Traced<E, Hops> copy(error);
+            copy.add_hop(location, note);
+            return copy;
+        }
+    };
+}
+#endif
+
+///Creates callback for `map_err`, that adds hop with note at location of caller to Traced error.
+///
+///@param note Static string, which is stored as pointer.
+///
+///~~~~~~~~~~~~~~~
+///return fetch(url).map_err(result::context("fetching manifest"));
+///~~~~~~~~~~~~~~~
+inline internal::context_fn context(const char* note, RESULT_CALLER_LOCATION) noexcept {
+    return internal::context_fn{note, location};
+}
+
+} // namespace result
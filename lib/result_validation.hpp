@@ -0,0 +1,711 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "result.hpp"
+
+namespace result {
+
+template<class Value, class Error, std::size_t N>
+class Validation;
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Number of errors that Validation stores without allocation, unless specified.
+    constexpr std::size_t default_inline_errors = 4;
+}
+#endif
+
+/**
+ * Vector, that stores up to N elements inline and allocates only when more are added.
+ *
+ * Once allocated, elements stay on heap until SmallVec is destroyed or moved from,
+ * so pointers to elements are invalidated only by growth, as with `std::vector`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::SmallVec<std::string_view, 4> names;
+ * names.push_back("id");
+ * assert(names.is_inline());
+ * ~~~~~~~~~~~~~~~
+ */
+template<class T, std::size_t N>
+class SmallVec {
+    static_assert(N > 0, "SmallVec must have inline capacity");
+    static_assert(!std::is_reference<T>::value, "SmallVec cannot store references");
+
+    private:
+        T* elems;
+        std::size_t len;
+        std::size_t cap;
+        alignas(T) unsigned char buffer[N * sizeof(T)];
+
+        T* inline_data() noexcept {
+            return std::launder(reinterpret_cast<T*>(buffer));
+        }
+
+        ///Frees heap storage, elements must be destroyed already.
+        void deallocate() noexcept {
+            if (!is_inline()) {
+                std::allocator<T>().deallocate(elems, cap);
+            }
+        }
+
+        ///Moves elements into `target`, copying if move could throw, so that they stay intact on failure.
+        void relocate_into(T* target) {
+            if constexpr (std::is_nothrow_move_constructible<T>::value || !std::is_copy_constructible<T>::value) {
+                std::uninitialized_move(elems, elems + len, target);
+            } else {
+                std::uninitialized_copy(elems, elems + len, target);
+            }
+            std::destroy(elems, elems + len);
+        }
+
+        ///Takes elements of `right`, stealing its heap storage.
+        void take(SmallVec&& right) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (right.is_inline()) {
+                std::uninitialized_move(right.elems, right.elems + right.len, elems);
+                len = right.len;
+                right.clear();
+            } else {
+                elems = right.elems;
+                len = right.len;
+                cap = right.cap;
+                right.elems = right.inline_data();
+                right.len = 0;
+                right.cap = N;
+            }
+        }
+
+        ///Appends element to full SmallVec, constructing it before relocation as argument may refer to existing element.
+        template<class... A>
+        RESULT_COLD T& emplace_back_slow(A&&... args) {
+            const std::size_t new_cap = cap * 2;
+            T* fresh = std::allocator<T>().allocate(new_cap);
+            T* elem = nullptr;
+#ifdef RESULT_HAS_EXCEPTIONS
+            try {
+                elem = ::new (static_cast<void*>(fresh + len)) T(std::forward<A>(args)...);
+                relocate_into(fresh);
+            } catch (...) {
+                if (elem != nullptr) {
+                    elem->~T();
+                }
+                std::allocator<T>().deallocate(fresh, new_cap);
+                throw;
+            }
+#else
+            elem = ::new (static_cast<void*>(fresh + len)) T(std::forward<A>(args)...);
+            relocate_into(fresh);
+#endif
+
+            deallocate();
+            elems = fresh;
+            cap = new_cap;
+            len++;
+            return *elem;
+        }
+
+    public:
+        ///Number of elements stored without allocation.
+        static constexpr std::size_t inline_capacity = N;
+
+        using value_type = T;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        ///Creates empty SmallVec.
+        SmallVec() noexcept : elems(inline_data()), len(0), cap(N) {}
+
+        SmallVec(const SmallVec& right) : SmallVec() {
+            reserve(right.len);
+            std::uninitialized_copy(right.begin(), right.end(), elems);
+            len = right.len;
+        }
+
+        SmallVec(SmallVec&& right) noexcept(std::is_nothrow_move_constructible<T>::value) : SmallVec() {
+            take(std::move(right));
+        }
+
+        SmallVec& operator=(const SmallVec& right) {
+            if (this != &right) {
+                clear();
+                reserve(right.len);
+                std::uninitialized_copy(right.begin(), right.end(), elems);
+                len = right.len;
+            }
+            return *this;
+        }
+
+        SmallVec& operator=(SmallVec&& right) noexcept(std::is_nothrow_move_constructible<T>::value) {
+            if (this != &right) {
+                clear();
+                deallocate();
+                elems = inline_data();
+                cap = N;
+                take(std::move(right));
+            }
+            return *this;
+        }
+
+        ~SmallVec() {
+            clear();
+            deallocate();
+        }
+
+        ///@returns Number of elements.
+        std::size_t size() const noexcept {
+            return len;
+        }
+
+        ///@returns Number of elements, that can be stored without allocation.
+        std::size_t capacity() const noexcept {
+            return cap;
+        }
+
+        ///@returns true If there are no elements.
+        bool empty() const noexcept {
+            return len == 0;
+        }
+
+        ///@returns true If elements are stored inline.
+        bool is_inline() const noexcept {
+            return cap == N;
+        }
+
+        T* data() noexcept {
+            return elems;
+        }
+
+        const T* data() const noexcept {
+            return elems;
+        }
+
+        iterator begin() noexcept {
+            return elems;
+        }
+
+        iterator end() noexcept {
+            return elems + len;
+        }
+
+        const_iterator begin() const noexcept {
+            return elems;
+        }
+
+        const_iterator end() const noexcept {
+            return elems + len;
+        }
+
+        T& operator[](std::size_t idx) noexcept {
+            return elems[idx];
+        }
+
+        const T& operator[](std::size_t idx) const noexcept {
+            return elems[idx];
+        }
+
+        T& front() noexcept {
+            return elems[0];
+        }
+
+        const T& front() const noexcept {
+            return elems[0];
+        }
+
+        T& back() noexcept {
+            return elems[len - 1];
+        }
+
+        const T& back() const noexcept {
+            return elems[len - 1];
+        }
+
+        ///Ensures that `capacity` elements can be stored without further allocation.
+        void reserve(std::size_t capacity) {
+            if (capacity <= cap) {
+                return;
+            }
+
+            T* fresh = std::allocator<T>().allocate(capacity);
+#ifdef RESULT_HAS_EXCEPTIONS
+            try {
+                relocate_into(fresh);
+            } catch (...) {
+                std::allocator<T>().deallocate(fresh, capacity);
+                throw;
+            }
+#else
+            relocate_into(fresh);
+#endif
+            deallocate();
+            elems = fresh;
+            cap = capacity;
+        }
+
+        ///Constructs element at the end.
+        template<class... A>
+        T& emplace_back(A&&... args) {
+            if (RESULT_UNLIKELY(len == cap)) {
+                return emplace_back_slow(std::forward<A>(args)...);
+            }
+
+            T* elem = ::new (static_cast<void*>(elems + len)) T(std::forward<A>(args)...);
+            len++;
+            return *elem;
+        }
+
+        void push_back(const T& value) {
+            emplace_back(value);
+        }
+
+        void push_back(T&& value) {
+            emplace_back(std::move(value));
+        }
+
+        ///Destroys the last element.
+        void pop_back() noexcept {
+            len--;
+            elems[len].~T();
+        }
+
+        ///Destroys all elements, keeping storage.
+        void clear() noexcept {
+            std::destroy(elems, elems + len);
+            len = 0;
+        }
+
+        friend bool operator==(const SmallVec& left, const SmallVec& right) {
+            return left.len == right.len && std::equal(left.begin(), left.end(), right.begin());
+        }
+
+        friend bool operator!=(const SmallVec& left, const SmallVec& right) {
+            return !(left == right);
+        }
+};
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    ///Value and Error of input to `combine`, which is either Result or Validation.
+    template<class T>
+    struct validation_input;
+
+    template<class Value, class Error>
+    struct validation_input<Result<Value, Error>> {
+        using value = Value;
+        using error = Error;
+        static constexpr std::size_t inline_errors = 0;
+
+        static constexpr const Result<Value, Error>& result(const Result<Value, Error>& input) noexcept {
+            return input;
+        }
+
+        static constexpr Result<Value, Error>& result(Result<Value, Error>& input) noexcept {
+            return input;
+        }
+    };
+
+    template<class Value, class Error, std::size_t N>
+    struct validation_input<Validation<Value, Error, N>> {
+        using value = Value;
+        using error = Error;
+        static constexpr std::size_t inline_errors = N;
+
+        static constexpr const auto& result(const Validation<Value, Error, N>& input) noexcept {
+            return input.inner;
+        }
+
+        static constexpr auto& result(Validation<Value, Error, N>& input) noexcept {
+            return input.inner;
+        }
+    };
+
+    template<class T>
+    using validation_input_t = validation_input<std::decay_t<T>>;
+
+    ///Inline capacity of the first Validation among inputs, that is used for combined errors.
+    template<class... T>
+    constexpr std::size_t validation_inline_errors() noexcept {
+        std::size_t found = 0;
+        static_cast<void>(((found = validation_input_t<T>::inline_errors, found != 0) || ...));
+        return found != 0 ? found : default_inline_errors;
+    }
+
+    ///Ok value of input as tuple of single reference, moved out of rvalue, or empty tuple if it is void.
+    template<class T>
+    constexpr auto validation_value(T&& input) noexcept {
+        using value = typename validation_input_t<T>::value;
+        if constexpr (std::is_void<value>::value) {
+            static_cast<void>(input);
+            return std::tuple<>();
+        } else if constexpr (std::is_lvalue_reference<T>::value) {
+            return std::forward_as_tuple(*validation_input_t<T>::result(input).value());
+        } else {
+            return std::forward_as_tuple(static_cast<value&&>(*validation_input_t<T>::result(input).value()));
+        }
+    }
+
+    ///Appends errors of input to `errors`, moving them out of rvalue.
+    template<class Errors, class T>
+    void append_validation_errors(Errors& errors, T&& input) {
+        auto& result = validation_input_t<T>::result(input);
+        if (result.is_ok()) {
+            return;
+        }
+
+        auto& payload = result_access::error_payload(result);
+        if constexpr (is_result<std::decay_t<T>>::value) {
+            if constexpr (std::is_lvalue_reference<T>::value) {
+                errors.push_back(payload);
+            } else {
+                errors.push_back(std::move(payload));
+            }
+        } else {
+            if constexpr (!std::is_lvalue_reference<T>::value && std::is_same<std::decay_t<decltype(payload)>, Errors>::value) {
+                //Heap storage of errors is taken over rather than copied.
+                if (errors.empty()) {
+                    errors = std::move(payload);
+                    return;
+                }
+            }
+            for (auto& error : payload) {
+                if constexpr (std::is_lvalue_reference<T>::value) {
+                    errors.push_back(error);
+                } else {
+                    errors.push_back(std::move(error));
+                }
+            }
+        }
+    }
+}
+#endif
+
+/**
+ * Outcome of validation, that holds either value or all errors found, unlike Result which holds the first one.
+ *
+ * Independent checks are combined with `combine` or `zip`, or accumulated with `Validator`,
+ * which collect errors of every failed check in order.
+ * Up to N errors are stored inline in `SmallVec`, so that validation allocates only if more checks fail.
+ *
+ * It is a thin wrapper over `Result<Value, SmallVec<Error, N>>`, which it converts to by `into_result`.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Result<std::string, FieldError> parse_name(const Json& json);
+ * result::Result<unsigned, FieldError> parse_age(const Json& json);
+ *
+ * result::Validation<User, FieldError> user = result::combine([](std::string name, unsigned age) {
+ *     return User{std::move(name), age};
+ * }, parse_name(json), parse_age(json));
+ *
+ * if (const auto* errors = user.errors()) {
+ *     for (const FieldError& error : *errors) {
+ *         report(error);
+ *     }
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Value, class Error, std::size_t N = internal::default_inline_errors>
+class Validation {
+    template<class>
+    friend struct internal::validation_input;
+
+    static_assert(!std::is_void<Error>::value, "Validation must have Error to collect");
+
+    public:
+        ///OK type
+        using Ok = Value;
+        ///Error type
+        using Err = Error;
+        ///Collection of errors
+        using Errors = SmallVec<Error, N>;
+
+    private:
+        using inner_type = Result<Value, Errors>;
+
+        inner_type inner;
+
+        ///Panics on Err without errors, before anything is moved out of it.
+        static inner_type&& checked(inner_type&& result) noexcept {
+            if (RESULT_UNLIKELY(result.is_err() && internal::result_access::error_payload(result).empty())) {
+                panic("Validation failed without errors...");
+            }
+            return std::move(result);
+        }
+
+        ///Creates variant with no errors yet, which factory adds right away.
+        explicit Validation(internal::storage_error_t) : inner(internal::result_access::error<inner_type>()) {}
+
+    public:
+        ///Creates Validation out of Result, which has either value or single error.
+        Validation(Result<Value, Error> result) : inner(result.is_ok() ? internal::result_access::ok<inner_type>(std::move(internal::result_access::ok_payload(result))) : internal::result_access::error<inner_type>()) {
+            if (result.is_err()) {
+                internal::result_access::error_payload(inner).push_back(std::move(internal::result_access::error_payload(result)));
+            }
+        }
+
+        ///Creates Validation out of Result, which has either value or errors.
+        ///
+        ///Errors must not be empty, otherwise it panics.
+        explicit Validation(Result<Value, Errors>&& result) noexcept(std::is_nothrow_move_constructible<inner_type>::value) : inner(checked(std::move(result))) {}
+
+        ///Creates Ok variant.
+        template<class... T>
+        static Validation ok(T&&... value) {
+            return Validation(internal::result_access::ok<inner_type>(std::forward<T>(value)...));
+        }
+
+        ///Creates variant with single error.
+        template<class... E>
+        static Validation error(E&&... error) {
+            Validation result(internal::storage_error);
+            internal::result_access::error_payload(result.inner).emplace_back(std::forward<E>(error)...);
+            return result;
+        }
+
+        ///Creates variant with errors, which must not be empty, otherwise it panics.
+        static Validation errors(Errors errors) {
+            return Validation(internal::result_access::error<inner_type>(std::move(errors)));
+        }
+
+        ///@returns true If Ok value.
+        bool is_ok() const noexcept {
+            return inner.is_ok();
+        }
+
+        ///@returns true If errors.
+        bool is_err() const noexcept {
+            return inner.is_err();
+        }
+
+        ///@returns true If Ok value.
+        explicit operator bool() const noexcept {
+            return inner.is_ok();
+        }
+
+        ///Returns pointer to underlying value.
+        ///
+        ///@retval nullptr If not-OK.
+        template<class V = Value, typename = std::enable_if_t<!std::is_void<V>::value>>
+        auto value() noexcept {
+            return inner.value();
+        }
+        ///Returns pointer to underlying value.
+        ///
+        ///@retval nullptr If not-OK.
+        template<class V = Value, typename = std::enable_if_t<!std::is_void<V>::value>>
+        auto value() const noexcept {
+            return inner.value();
+        }
+
+        ///Returns pointer to errors, in order they were found.
+        ///
+        ///@retval nullptr If OK.
+        Errors* errors() noexcept {
+            return inner.error();
+        }
+        ///Returns pointer to errors, in order they were found.
+        ///
+        ///@retval nullptr If OK.
+        const Errors* errors() const noexcept {
+            return inner.error();
+        }
+
+        ///@returns Number of errors, which is zero if OK.
+        std::size_t error_count() const noexcept {
+            return inner.is_err() ? inner.error()->size() : 0;
+        }
+
+        ///Maps value, keeping errors.
+        template<class Fn>
+        auto map(Fn&& fn) const & {
+            using mapped = decltype(inner.map(std::forward<Fn>(fn)));
+            return Validation<typename mapped::Ok, Error, N>(inner.map(std::forward<Fn>(fn)));
+        }
+        ///Maps value, moving out value or errors.
+        template<class Fn>
+        auto map(Fn&& fn) && {
+            using mapped = decltype(std::move(inner).map(std::forward<Fn>(fn)));
+            return Validation<typename mapped::Ok, Error, N>(std::move(inner).map(std::forward<Fn>(fn)));
+        }
+
+        ///@returns Underlying Result.
+        const Result<Value, Errors>& result() const & noexcept {
+            return inner;
+        }
+
+        ///Converts to Result, moving out value or errors.
+        Result<Value, Errors> into_result() && noexcept(std::is_nothrow_move_constructible<inner_type>::value) {
+            return std::move(inner);
+        }
+};
+
+/**
+ * Calls `fn` with values of all inputs if every one of them is OK, otherwise collects errors of all failed ones.
+ *
+ * Inputs are Result or Validation with the same Error, and values of void ones are not passed to `fn`.
+ * Errors are collected in order of inputs, moving out of rvalues,
+ * into Validation with inline capacity of the first Validation input, if any.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Validation<Range, std::string> range = result::combine([](int low, int high) {
+ *     return Range{low, high};
+ * }, parse_int(json["low"]), parse_int(json["high"]));
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Fn, class First, class... Rest>
+auto combine(Fn&& fn, First&& first, Rest&&... rest) {
+    using error = typename internal::validation_input_t<First>::error;
+    using value = decltype(std::apply(std::forward<Fn>(fn), std::tuple_cat(internal::validation_value(std::forward<First>(first)), internal::validation_value(std::forward<Rest>(rest))...)));
+    using output = Validation<std::remove_cv_t<std::remove_reference_t<value>>, error, internal::validation_inline_errors<First, Rest...>()>;
+
+    static_assert((std::is_same<typename internal::validation_input_t<Rest>::error, error>::value && ...), "Inputs must have the same Error");
+
+    if (internal::validation_input_t<First>::result(first).is_ok() && (internal::validation_input_t<Rest>::result(rest).is_ok() && ...)) {
+        auto values = std::tuple_cat(internal::validation_value(std::forward<First>(first)), internal::validation_value(std::forward<Rest>(rest))...);
+        if constexpr (std::is_void<value>::value) {
+            std::apply(std::forward<Fn>(fn), std::move(values));
+            return output::ok();
+        } else {
+            return output::ok(std::apply(std::forward<Fn>(fn), std::move(values)));
+        }
+    }
+
+    typename output::Errors errors;
+    internal::append_validation_errors(errors, std::forward<First>(first));
+    (internal::append_validation_errors(errors, std::forward<Rest>(rest)), ...);
+    return output::errors(std::move(errors));
+}
+
+/**
+ * Collects values of all inputs into tuple if every one of them is OK, otherwise collects errors of all failed ones.
+ *
+ * Same as `combine` with `std::make_tuple`, so values of void inputs are not included.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Validation<std::tuple<std::string, unsigned>, FieldError> fields = result::zip(parse_name(json), parse_age(json));
+ * ~~~~~~~~~~~~~~~
+ */
+template<class First, class... Rest>
+auto zip(First&& first, Rest&&... rest) {
+    return combine([](auto&&... values) {
+        return std::make_tuple(std::forward<decltype(values)>(values)...);
+    }, std::forward<First>(first), std::forward<Rest>(rest)...);
+}
+
+/**
+ * Accumulates errors of checks one by one, for validation of many fields, that is impractical to combine at once.
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::Validator<FieldError, 8> validator;
+ * auto name = parse_name(json);
+ * auto age = parse_age(json);
+ * validator.check(name);
+ * validator.check(age);
+ * validator.check(json.size() <= 16, FieldError{"", "too many fields"});
+ *
+ * result::Validation<User, FieldError, 8> user = std::move(validator).finish([&]() {
+ *     return User{std::move(name).unwrap(), age.unwrap()};
+ * });
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Error, std::size_t N = internal::default_inline_errors>
+class Validator {
+    public:
+        using Errors = SmallVec<Error, N>;
+
+    private:
+        Errors found;
+
+    public:
+        ///Records error of Result, if any.
+        ///
+        ///@returns true If OK.
+        template<class Value>
+        bool check(const Result<Value, Error>& result) {
+            if (result.is_err()) {
+                found.push_back(*result.error());
+            }
+            return result.is_ok();
+        }
+        ///Records error of Result, if any, moving it out.
+        ///
+        ///@returns true If OK.
+        template<class Value>
+        bool check(Result<Value, Error>&& result) {
+            if (result.is_err()) {
+                found.push_back(std::move(*result.error()));
+            }
+            return result.is_ok();
+        }
+        ///Records all errors of Validation, if any.
+        ///
+        ///@returns true If OK.
+        template<class Value, std::size_t M>
+        bool check(const Validation<Value, Error, M>& validation) {
+            if (validation.is_err()) {
+                internal::append_validation_errors(found, validation);
+            }
+            return validation.is_ok();
+        }
+        ///Records all errors of Validation, if any, moving them out.
+        ///
+        ///@returns true If OK.
+        template<class Value, std::size_t M>
+        bool check(Validation<Value, Error, M>&& validation) {
+            if (validation.is_err()) {
+                internal::append_validation_errors(found, std::move(validation));
+            }
+            return validation.is_ok();
+        }
+        ///Records error constructed out of `error` if `passed` is false.
+        ///
+        ///@returns passed
+        template<class... E>
+        bool check(bool passed, E&&... error) {
+            if (!passed) {
+                found.emplace_back(std::forward<E>(error)...);
+            }
+            return passed;
+        }
+
+        ///@returns true If no errors were found yet.
+        bool is_ok() const noexcept {
+            return found.empty();
+        }
+
+        ///@returns Errors found so far.
+        const Errors& errors() const noexcept {
+            return found;
+        }
+
+        ///Finishes validation, creating value with `fn` only if no errors were found.
+        template<class Fn>
+        auto finish(Fn&& fn) && {
+            using value = std::invoke_result_t<Fn>;
+            using output = Validation<std::remove_cv_t<std::remove_reference_t<value>>, Error, N>;
+
+            if (!found.empty()) {
+                return output::errors(std::move(found));
+            } else if constexpr (std::is_void<value>::value) {
+                std::invoke(std::forward<Fn>(fn));
+                return output::ok();
+            } else {
+                return output::ok(std::invoke(std::forward<Fn>(fn)));
+            }
+        }
+        ///Finishes validation without value.
+        Validation<void, Error, N> finish() && {
+            if (!found.empty()) {
+                return Validation<void, Error, N>::errors(std::move(found));
+            }
+            return Validation<void, Error, N>::ok();
+        }
+};
+
+}
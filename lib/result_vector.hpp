@@ -0,0 +1,662 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<bit>)
+#include <bit>
+#endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__cpp_lib_bitops)
+#include <intrin.h>
+#endif
+
+#include "result.hpp"
+
+namespace result {
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+namespace internal {
+    using bit_word = std::uint64_t;
+    constexpr std::size_t bit_word_size = 64;
+
+    ///Number of set bits, compiled to single instruction where available.
+    inline std::size_t popcount(bit_word word) noexcept {
+#if defined(__cpp_lib_bitops)
+        return static_cast<std::size_t>(std::popcount(word));
+#elif defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<std::size_t>(__popcnt64(word));
+#else
+        word = word - ((word >> 1) & 0x5555555555555555ull);
+        word = (word & 0x3333333333333333ull) + ((word >> 2) & 0x3333333333333333ull);
+        word = (word + (word >> 4)) & 0x0f0f0f0f0f0f0f0full;
+        return static_cast<std::size_t>((word * 0x0101010101010101ull) >> 56);
+#endif
+    }
+
+    ///Index of lowest set bit, word must be non-zero.
+    inline std::size_t countr_zero(bit_word word) noexcept {
+#if defined(__cpp_lib_bitops)
+        return static_cast<std::size_t>(std::countr_zero(word));
+#elif defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_ctzll(word));
+#elif defined(_MSC_VER) && defined(_M_X64)
+        unsigned long idx;
+        _BitScanForward64(&idx, word);
+        return static_cast<std::size_t>(idx);
+#else
+        return popcount((word & (0 - word)) - 1);
+#endif
+    }
+
+    ///Mask of bits below `bit`.
+    constexpr bit_word low_bits(std::size_t bit) noexcept {
+        return (bit_word(1) << bit) - 1;
+    }
+}
+#endif
+
+/**
+ * Sequence of Result stored as structure of arrays.
+ *
+ * Ok/Err tags are packed into a bitset, while Ok values and Err errors are kept in two dense arrays,
+ * in order of insertion.
+ * Compared to `std::vector<Result<Value, Error>>` there is no per element padding and
+ * scanning for failures touches only the bitset.
+ *
+ * Each 64 tags are stored together with number of Ok values before them,
+ * so element access costs single popcount.
+ *
+ * Elements are accessed through views which provide the same interface as Result,
+ * and convert to Result by copy.
+ *
+ * ## Usage
+ *
+ * ~~~~~~~~~~~~~~~
+ * result::ResultVector<int, std::string> rows;
+ * rows.push_back(parse(line));
+ *
+ * if (!rows.all_ok()) {
+ *     std::cerr << "Row " << rows.first_err() << ": " << rows[rows.first_err()].unwrap_err() << "\n";
+ * }
+ *
+ * for (auto [idx, value] : rows.oks()) {
+ *     total += value;
+ * }
+ * ~~~~~~~~~~~~~~~
+ */
+template<class Value, class Error>
+class ResultVector {
+    private:
+        using value_type = internal::payload_t<Value>;
+        using error_type = internal::payload_t<Error>;
+
+        ///Tags of 64 elements.
+        struct block {
+            ///Bit is set for Ok element.
+            internal::bit_word tags;
+            ///Number of Ok elements in preceding blocks.
+            std::size_t ok_before;
+        };
+
+        std::vector<block> blocks;
+        std::vector<value_type> values;
+        std::vector<error_type> errors;
+        std::size_t len;
+
+        bool test(std::size_t idx) const noexcept {
+            return (blocks[idx / internal::bit_word_size].tags >> (idx % internal::bit_word_size)) & 1;
+        }
+
+        ///Number of Ok elements before idx.
+        std::size_t rank(std::size_t idx) const noexcept {
+            const block& tags = blocks[idx / internal::bit_word_size];
+            return tags.ok_before + internal::popcount(tags.tags & internal::low_bits(idx % internal::bit_word_size));
+        }
+
+        ///Appends tag, after payload has been successfully stored.
+        void push_tag(bool is_ok) {
+            const std::size_t bit = len % internal::bit_word_size;
+            if (bit == 0) {
+                blocks.push_back(block{0, values.size() - (is_ok ? 1 : 0)});
+            }
+
+            if (is_ok) {
+                blocks.back().tags |= internal::bit_word(1) << bit;
+            }
+            len++;
+        }
+
+        template<class... A>
+        void push_ok(A&&... value) {
+            values.emplace_back(std::forward<A>(value)...);
+#ifdef RESULT_HAS_EXCEPTIONS
+            try {
+                push_tag(true);
+            } catch (...) {
+                values.pop_back();
+                throw;
+            }
+#else
+            push_tag(true);
+#endif
+        }
+
+        template<class... E>
+        void push_err(E&&... error) {
+            errors.emplace_back(std::forward<E>(error)...);
+#ifdef RESULT_HAS_EXCEPTIONS
+            try {
+                push_tag(false);
+            } catch (...) {
+                errors.pop_back();
+                throw;
+            }
+#else
+            push_tag(false);
+#endif
+        }
+
+    public:
+        using size_type = std::size_t;
+        ///Type of stored element.
+        using result_type = Result<Value, Error>;
+
+        ///View on element, that provides Result's interface.
+        template<bool Const>
+        class basic_reference {
+            friend class ResultVector;
+            template<bool>
+            friend class basic_reference;
+
+            private:
+                using owner_type = std::conditional_t<Const, const ResultVector, ResultVector>;
+                using ok_type = std::conditional_t<Const, const value_type, value_type>;
+                using err_type = std::conditional_t<Const, const error_type, error_type>;
+                ///Reference payloads are yielded as referent, like Result does.
+                using value_reference = std::conditional_t<std::is_void<Value>::value, void, internal::payload_arg_t<ok_type&>>;
+                using error_reference = std::conditional_t<std::is_void<Error>::value, void, internal::payload_arg_t<err_type&>>;
+
+                owner_type* owner;
+                size_type idx;
+
+                basic_reference(owner_type* owner, size_type idx) noexcept : owner(owner), idx(idx) {}
+
+                ok_type& ok_ref() const noexcept {
+                    return owner->values[owner->rank(idx)];
+                }
+
+                err_type& error_ref() const noexcept {
+                    return owner->errors[idx - owner->rank(idx)];
+                }
+
+            public:
+                ///Const view from mutable one.
+                template<bool C = Const, typename = std::enable_if_t<C>>
+                basic_reference(const basic_reference<false>& right) noexcept : owner(right.owner), idx(right.idx) {}
+
+                ///@returns Index of element within vector.
+                size_type index() const noexcept {
+                    return idx;
+                }
+
+                ///@returns true If Ok value.
+                bool is_ok() const noexcept {
+                    return owner->test(idx);
+                }
+
+                ///@returns true If Error value.
+                bool is_err() const noexcept {
+                    return !is_ok();
+                }
+
+                ///@returns true If Ok value.
+                explicit operator bool() const noexcept {
+                    return is_ok();
+                }
+
+                ///Returns pointer to underlying value.
+                ///
+                ///@retval nullptr If not-OK.
+                template<class V = Value, typename = std::enable_if_t<!std::is_void<V>::value>>
+                std::add_pointer_t<value_reference> value() const noexcept {
+                    return is_ok() ? std::addressof(static_cast<value_reference>(ok_ref())) : nullptr;
+                }
+
+                ///Returns pointer to underlying error.
+                ///
+                ///@retval nullptr If not-OK.
+                template<class E = Error, typename = std::enable_if_t<!std::is_void<E>::value>>
+                std::add_pointer_t<error_reference> error() const noexcept {
+                    return is_err() ? std::addressof(static_cast<error_reference>(error_ref())) : nullptr;
+                }
+
+                ///Attempts to unwrap result, yielding content of Ok.
+                ///
+                ///@throws Content of Error.
+                value_reference unwrap(RESULT_CALLER_LOCATION) const {
+                    const size_type ok_before = owner->rank(idx);
+                    if (RESULT_UNLIKELY(!is_ok())) {
+                        internal::unwrap_failed(owner->errors[idx - ok_before], location);
+                    }
+
+                    return static_cast<value_reference>(owner->values[ok_before]);
+                }
+
+                ///Attempts to unwrap result, yielding content of Err.
+                ///
+                ///@throws If no error.
+                error_reference unwrap_err() const {
+                    if (RESULT_UNLIKELY(is_ok())) {
+                        internal::unwrap_err_failed();
+                    }
+
+                    return static_cast<error_reference>(error_ref());
+                }
+
+                ///Attempts to unwrap result, yielding content of Ok or, if it is not ok, other.
+                Value unwrap_or(value_type&& other) const {
+                    static_assert(!std::is_void<Value>::value, "Cannot unwrap_or void Value");
+                    return is_ok() ? ok_ref() : std::move(other);
+                }
+
+                ///Copies element into Result.
+                operator result_type() const {
+                    if (is_ok()) {
+                        return result_type::ok(ok_ref());
+                    } else {
+                        return internal::result_access::error<result_type>(error_ref());
+                    }
+                }
+        };
+
+        ///Mutable view on element.
+        using reference = basic_reference<false>;
+        ///Const view on element.
+        using const_reference = basic_reference<true>;
+
+        ///Iterator over all elements, yielding views.
+        template<bool Const>
+        class basic_iterator {
+            friend class ResultVector;
+
+            private:
+                using owner_type = std::conditional_t<Const, const ResultVector, ResultVector>;
+
+                owner_type* owner;
+                size_type idx;
+
+                basic_iterator(owner_type* owner, size_type idx) noexcept : owner(owner), idx(idx) {}
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = result_type;
+                using difference_type = std::ptrdiff_t;
+                using reference = basic_reference<Const>;
+                using pointer = void;
+
+                reference operator*() const noexcept {
+                    return reference(owner, idx);
+                }
+
+                basic_iterator& operator++() noexcept {
+                    idx++;
+                    return *this;
+                }
+
+                basic_iterator operator++(int) noexcept {
+                    basic_iterator prev = *this;
+                    idx++;
+                    return prev;
+                }
+
+                bool operator==(const basic_iterator& right) const noexcept {
+                    return idx == right.idx;
+                }
+
+                bool operator!=(const basic_iterator& right) const noexcept {
+                    return idx != right.idx;
+                }
+        };
+
+        using iterator = basic_iterator<false>;
+        using const_iterator = basic_iterator<true>;
+
+        ///Element yielded when iterating over only Ok or only Err elements.
+        template<class Payload>
+        struct row {
+            ///Index of element within vector.
+            size_type index;
+            ///Ok value or Err error.
+            Payload& value;
+        };
+
+        ///Iterator over elements of single variant, which skips other variant 64 elements at once.
+        template<bool Ok, bool Const>
+        class basic_row_iterator {
+            friend class ResultVector;
+
+            private:
+                using owner_type = std::conditional_t<Const, const ResultVector, ResultVector>;
+                using payload_type = std::conditional_t<Ok, typename ResultVector::value_type, typename ResultVector::error_type>;
+                using element_type = std::conditional_t<Const, const payload_type, payload_type>;
+                ///Referent of reference payload.
+                using element_reference = internal::payload_arg_t<element_type&>;
+
+                const block* blocks;
+                size_type words;
+                size_type len;
+                ///Index of current block.
+                size_type word;
+                ///Remaining elements of current block.
+                internal::bit_word bits;
+                ///Current element in values or errors, which alone identifies position.
+                element_type* dense;
+
+                internal::bit_word block_bits() const noexcept {
+                    internal::bit_word tags = blocks[word].tags;
+                    if constexpr (!Ok) {
+                        tags = ~tags;
+                        const size_type tail = len - word * internal::bit_word_size;
+                        if (tail < internal::bit_word_size) {
+                            tags &= internal::low_bits(tail);
+                        }
+                    }
+
+                    return tags;
+                }
+
+                void skip_empty() noexcept {
+                    while (bits == 0 && ++word < words) {
+                        bits = block_bits();
+                    }
+                }
+
+                basic_row_iterator(owner_type* owner, bool end) noexcept : blocks(owner->blocks.data()), words(owner->blocks.size()), len(owner->len), word(0), bits(0), dense(nullptr) {
+                    if constexpr (Ok) {
+                        dense = owner->values.data() + (end ? owner->values.size() : 0);
+                    } else {
+                        dense = owner->errors.data() + (end ? owner->errors.size() : 0);
+                    }
+
+                    if (end) {
+                        word = words;
+                    } else if (words != 0) {
+                        bits = block_bits();
+                        skip_empty();
+                    }
+                }
+
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = row<std::remove_reference_t<element_reference>>;
+                using difference_type = std::ptrdiff_t;
+                using reference = value_type;
+                using pointer = void;
+
+                reference operator*() const noexcept {
+                    return reference{word * internal::bit_word_size + internal::countr_zero(bits), static_cast<element_reference>(*dense)};
+                }
+
+                basic_row_iterator& operator++() noexcept {
+                    bits &= bits - 1;
+                    dense++;
+                    skip_empty();
+                    return *this;
+                }
+
+                basic_row_iterator operator++(int) noexcept {
+                    basic_row_iterator prev = *this;
+                    ++*this;
+                    return prev;
+                }
+
+                bool operator==(const basic_row_iterator& right) const noexcept {
+                    return dense == right.dense;
+                }
+
+                bool operator!=(const basic_row_iterator& right) const noexcept {
+                    return dense != right.dense;
+                }
+        };
+
+        using ok_iterator = basic_row_iterator<true, false>;
+        using const_ok_iterator = basic_row_iterator<true, true>;
+        using err_iterator = basic_row_iterator<false, false>;
+        using const_err_iterator = basic_row_iterator<false, true>;
+
+        ///Pair of iterators usable in range-based for.
+        template<class It>
+        class range {
+            private:
+                It first;
+                It last;
+
+            public:
+                range(It first, It last) noexcept : first(first), last(last) {}
+
+                It begin() const noexcept {
+                    return first;
+                }
+
+                It end() const noexcept {
+                    return last;
+                }
+        };
+
+        ///Creates empty vector.
+        ResultVector() noexcept : len(0) {}
+
+        ///Creates vector from sequence of Result.
+        template<class It, typename = typename std::iterator_traits<It>::iterator_category>
+        ResultVector(It first, It last) : len(0) {
+            for (; first != last; ++first) {
+                push_back(*first);
+            }
+        }
+
+        ///Creates vector from list of Result.
+        ResultVector(std::initializer_list<result_type> list) : ResultVector(list.begin(), list.end()) {}
+
+        ///@returns Number of elements.
+        size_type size() const noexcept {
+            return len;
+        }
+
+        ///@returns true If there are no elements.
+        bool empty() const noexcept {
+            return len == 0;
+        }
+
+        ///Reserves storage for elements, assuming they are all of the same variant.
+        void reserve(size_type capacity) {
+            blocks.reserve((capacity + internal::bit_word_size - 1) / internal::bit_word_size);
+            values.reserve(capacity);
+            errors.reserve(capacity);
+        }
+
+        ///Removes all elements.
+        void clear() noexcept {
+            blocks.clear();
+            values.clear();
+            errors.clear();
+            len = 0;
+        }
+
+        ///Appends Ok element, constructed from arguments.
+        ///
+        ///If `Value` is `void`, no arguments are accepted.
+        template<class... A>
+        reference emplace_ok(A&&... value) {
+            push_ok(std::forward<A>(value)...);
+            return reference(this, len - 1);
+        }
+
+        ///Appends Err element, constructed from arguments.
+        ///
+        ///If `Error` is `void`, no arguments are accepted.
+        template<class... E>
+        reference emplace_err(E&&... error) {
+            push_err(std::forward<E>(error)...);
+            return reference(this, len - 1);
+        }
+
+        ///Appends copy of Result.
+        void push_back(const result_type& result) {
+            if (result.is_ok()) {
+                if constexpr (std::is_void<Value>::value) {
+                    push_ok();
+                } else {
+                    push_ok(*result.value());
+                }
+            } else {
+                if constexpr (std::is_void<Error>::value) {
+                    push_err();
+                } else {
+                    push_err(*result.error());
+                }
+            }
+        }
+
+        ///Appends Result, moving out its content, while referent of reference payload is kept in place.
+        void push_back(result_type&& result) {
+            if (result.is_ok()) {
+                if constexpr (std::is_void<Value>::value) {
+                    push_ok();
+                } else {
+                    push_ok(std::forward<Value>(*result.value()));
+                }
+            } else {
+                if constexpr (std::is_void<Error>::value) {
+                    push_err();
+                } else {
+                    push_err(std::forward<Error>(*result.error()));
+                }
+            }
+        }
+
+        ///Removes last element.
+        void pop_back() noexcept {
+            len--;
+            const size_type bit = len % internal::bit_word_size;
+            block& last = blocks.back();
+
+            if ((last.tags >> bit) & 1) {
+                values.pop_back();
+            } else {
+                errors.pop_back();
+            }
+
+            if (bit == 0) {
+                blocks.pop_back();
+            } else {
+                last.tags &= internal::low_bits(bit);
+            }
+        }
+
+        ///Accesses element without bounds check.
+        reference operator[](size_type idx) noexcept {
+            return reference(this, idx);
+        }
+
+        ///Accesses element without bounds check.
+        const_reference operator[](size_type idx) const noexcept {
+            return const_reference(this, idx);
+        }
+
+        ///@returns Number of Ok elements.
+        size_type count_ok() const noexcept {
+            return values.size();
+        }
+
+        ///@returns Number of Err elements.
+        size_type count_err() const noexcept {
+            return errors.size();
+        }
+
+        ///@returns true If all elements are Ok, including empty vector.
+        bool all_ok() const noexcept {
+            return errors.empty();
+        }
+
+        ///Searches for first Err element, scanning 64 tags at once.
+        ///
+        ///@returns Index of first Err element or `size()` if there is none.
+        size_type first_err() const noexcept {
+            if (errors.empty()) {
+                return len;
+            }
+
+            const size_type count = blocks.size();
+            for (size_type word = 0; word < count; word++) {
+                const internal::bit_word errs = ~blocks[word].tags;
+                if (errs != 0) {
+                    const size_type idx = word * internal::bit_word_size + internal::countr_zero(errs);
+                    return idx < len ? idx : len;
+                }
+            }
+
+            return len;
+        }
+
+        iterator begin() noexcept {
+            return iterator(this, 0);
+        }
+        const_iterator begin() const noexcept {
+            return const_iterator(this, 0);
+        }
+        iterator end() noexcept {
+            return iterator(this, len);
+        }
+        const_iterator end() const noexcept {
+            return const_iterator(this, len);
+        }
+
+        ///@returns Range of Ok elements, as pairs of index and value.
+        range<ok_iterator> oks() noexcept {
+            return range<ok_iterator>(ok_iterator(this, false), ok_iterator(this, true));
+        }
+        ///@returns Range of Ok elements, as pairs of index and value.
+        range<const_ok_iterator> oks() const noexcept {
+            return range<const_ok_iterator>(const_ok_iterator(this, false), const_ok_iterator(this, true));
+        }
+
+        ///@returns Range of Err elements, as pairs of index and error.
+        range<err_iterator> errs() noexcept {
+            return range<err_iterator>(err_iterator(this, false), err_iterator(this, true));
+        }
+        ///@returns Range of Err elements, as pairs of index and error.
+        range<const_err_iterator> errs() const noexcept {
+            return range<const_err_iterator>(const_err_iterator(this, false), const_err_iterator(this, true));
+        }
+
+        ///@returns Contiguous range of Ok values, in order of elements.
+        range<value_type*> ok_values() noexcept {
+            return range<value_type*>(values.data(), values.data() + values.size());
+        }
+        ///@returns Contiguous range of Ok values, in order of elements.
+        range<const value_type*> ok_values() const noexcept {
+            return range<const value_type*>(values.data(), values.data() + values.size());
+        }
+
+        ///@returns Contiguous range of Err errors, in order of elements.
+        range<error_type*> err_values() noexcept {
+            return range<error_type*>(errors.data(), errors.data() + errors.size());
+        }
+        ///@returns Contiguous range of Err errors, in order of elements.
+        range<const error_type*> err_values() const noexcept {
+            return range<const error_type*>(errors.data(), errors.data() + errors.size());
+        }
+};
+
+} // namespace result
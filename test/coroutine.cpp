@@ -0,0 +1,110 @@
+#include <catch.hpp>
+
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#include <result.hpp>
+
+#ifdef RESULT_HAS_COROUTINE
+
+typedef result::Result<int, std::string> Res;
+
+static Res parse(const char* text) {
+    if (text[0] >= '0' && text[0] <= '9' && text[1] == '\0') {
+        return Res::ok(text[0] - '0');
+    } else {
+        return Res::error(std::string("invalid: ") + text);
+    }
+}
+
+static int steps = 0;
+
+static Res sum(const char* left, const char* right) {
+    steps = 0;
+    const int left_num = co_await parse(left);
+    steps++;
+    const int right_num = co_await parse(right);
+    steps++;
+
+    if (right_num == 0) {
+        co_await result::Err(std::string("zero"));
+    }
+
+    co_return left_num + right_num;
+}
+
+static Res sum_ref(const char* left) {
+    auto res = parse(left);
+    int& value = co_await res;
+    value++;
+    co_return res;
+}
+
+static result::Result<void, std::string> check(const char* text) {
+    co_await parse(text);
+}
+
+static result::Result<long, char> widen(result::Result<int, char> res) {
+    long value = co_await std::move(res);
+    co_return value * 2;
+}
+
+static result::Result<int, std::string> fail_with_throw() {
+    co_await parse("1");
+    throw std::runtime_error("test");
+}
+
+//Trivially copyable Result may be returned in registers through temporary.
+static result::Result<int, int> halve(int value) {
+    if (value % 2 != 0) {
+        co_await result::Err(value);
+    }
+    co_return value / 2;
+}
+
+static result::Result<int, int> quarter(int value) {
+    const int half = co_await halve(value);
+    co_return co_await halve(half);
+}
+
+TEST_CASE("try coroutine result") {
+    auto ok = sum("1", "2");
+    REQUIRE(ok.unwrap() == 3);
+    REQUIRE(steps == 2);
+
+    auto first_error = sum("a", "2");
+    REQUIRE(first_error.unwrap_err() == "invalid: a");
+    REQUIRE(steps == 0);
+
+    auto second_error = sum("1", "b");
+    REQUIRE(second_error.unwrap_err() == "invalid: b");
+    REQUIRE(steps == 1);
+
+    auto explicit_error = sum("1", "0");
+    REQUIRE(explicit_error.unwrap_err() == "zero");
+    REQUIRE(steps == 2);
+
+    REQUIRE(sum_ref("5").unwrap() == 6);
+    REQUIRE(sum_ref("x").unwrap_err() == "invalid: x");
+
+    REQUIRE(check("1").is_ok());
+    REQUIRE(check("x").unwrap_err() == "invalid: x");
+
+    REQUIRE(widen(result::Result<int, char>::ok(2)).unwrap() == 4);
+    REQUIRE(widen(result::Result<int, char>::error('e')).unwrap_err() == 'e');
+
+    REQUIRE_THROWS_AS(fail_with_throw(), std::runtime_error);
+
+    static_assert(std::is_trivially_copyable<result::Result<int, int>>::value);
+    REQUIRE(quarter(8).unwrap() == 2);
+    REQUIRE(quarter(6).unwrap_err() == 3);
+    REQUIRE(quarter(5).unwrap_err() == 5);
+
+    for (int idx = 0; idx < 100; idx++) {
+        REQUIRE(sum("1", "x").is_err());
+        REQUIRE(sum("1", "1").unwrap() == 2);
+    }
+}
+
+#endif
@@ -0,0 +1,30 @@
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "counting.hpp"
+
+//Counted per thread, so that allocations of other threads don't affect measurement.
+static thread_local std::uint64_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    allocation_count++;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+namespace counting {
+    std::uint64_t allocations() noexcept {
+        return allocation_count;
+    }
+}
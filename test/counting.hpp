@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+
+///Instrumentation to test cost of operations: copies and moves of payload and heap allocations.
+///
+///~~~~~~~~~~~~~~~
+///counting::Meter meter;
+///auto moved = std::move(res).map(fn);
+///REQUIRE(meter.value() == counting::none);
+///REQUIRE(meter.error() == counting::moved(1));
+///REQUIRE(meter.allocations() == 0);
+///~~~~~~~~~~~~~~~
+namespace counting {
+    ///Number of global operator new calls made by calling thread, maintained by counting.cpp
+    std::uint64_t allocations() noexcept;
+
+    ///Special member calls of payload, where assignments are counted as copies and moves.
+    struct Counts {
+        int made;
+        int copies;
+        int moves;
+        int destroys;
+
+        bool operator==(const Counts& right) const noexcept {
+            return made == right.made && copies == right.copies && moves == right.moves && destroys == right.destroys;
+        }
+
+        bool operator!=(const Counts& right) const noexcept {
+            return !(*this == right);
+        }
+
+        Counts operator+(const Counts& right) const noexcept {
+            return Counts{made + right.made, copies + right.copies, moves + right.moves, destroys + right.destroys};
+        }
+
+        Counts operator-(const Counts& right) const noexcept {
+            return Counts{made - right.made, copies - right.copies, moves - right.moves, destroys - right.destroys};
+        }
+    };
+
+    inline std::ostream& operator<<(std::ostream& out, const Counts& counts) {
+        return out << "{made=" << counts.made << ", copies=" << counts.copies << ", moves=" << counts.moves << ", destroys=" << counts.destroys << "}";
+    }
+
+    constexpr Counts none{0, 0, 0, 0};
+
+    constexpr Counts made(int count) {
+        return Counts{count, 0, 0, 0};
+    }
+
+    constexpr Counts copied(int count) {
+        return Counts{0, count, 0, 0};
+    }
+
+    constexpr Counts moved(int count) {
+        return Counts{0, 0, count, 0};
+    }
+
+    constexpr Counts destroyed(int count) {
+        return Counts{0, 0, 0, count};
+    }
+
+    ///Payload that counts its special member calls, separately for each Tag.
+    template<class Tag>
+    struct Counted {
+        static Counts counts;
+
+        int value;
+
+        Counted() noexcept : value(0) {
+            counts.made++;
+        }
+        explicit Counted(int value) noexcept : value(value) {
+            counts.made++;
+        }
+        Counted(const Counted& right) noexcept : value(right.value) {
+            counts.copies++;
+        }
+        Counted(Counted&& right) noexcept : value(right.value) {
+            counts.moves++;
+        }
+        Counted& operator=(const Counted& right) noexcept {
+            value = right.value;
+            counts.copies++;
+            return *this;
+        }
+        Counted& operator=(Counted&& right) noexcept {
+            value = right.value;
+            counts.moves++;
+            return *this;
+        }
+        ~Counted() {
+            counts.destroys++;
+        }
+    };
+
+    template<class Tag>
+    Counts Counted<Tag>::counts = none;
+
+    struct ValueTag;
+    struct ErrorTag;
+
+    ///Counted type to use as Value.
+    typedef Counted<ValueTag> Value;
+    ///Counted type to use as Error.
+    typedef Counted<ErrorTag> Error;
+
+    ///Measures what happened to Value and Error payloads and how many allocations were made since its creation.
+    class Meter {
+        private:
+            Counts value_start;
+            Counts error_start;
+            std::uint64_t allocations_start;
+
+        public:
+            Meter() noexcept : value_start(Value::counts), error_start(Error::counts), allocations_start(counting::allocations()) {}
+
+            ///Starts measuring again.
+            void reset() noexcept {
+                *this = Meter();
+            }
+
+            Counts value() const noexcept {
+                return Value::counts - value_start;
+            }
+
+            Counts error() const noexcept {
+                return Error::counts - error_start;
+            }
+
+            std::uint64_t allocations() const noexcept {
+                return counting::allocations() - allocations_start;
+            }
+    };
+}
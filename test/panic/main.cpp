@@ -0,0 +1,104 @@
+//Tests of RESULT_PANIC mode, built with exceptions disabled.
+#include <csetjmp>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+
+#include <result_algorithm.hpp>
+#include <result_cache.hpp>
+#include <result_parallel.hpp>
+#include <result_validation.hpp>
+#include <result_vector.hpp>
+
+#ifndef RESULT_PANIC
+#error "RESULT_PANIC must be defined when exceptions are disabled"
+#endif
+
+namespace {
+    std::jmp_buf panic_jump;
+    const char* panic_message = nullptr;
+    int failures = 0;
+
+    void test_panic(const char* message) noexcept {
+        panic_message = message;
+        std::longjmp(panic_jump, 1);
+    }
+
+    void check(bool cond, const char* what, int line) {
+        if (!cond) {
+            std::fprintf(stderr, "%d: check failed: %s\n", line, what);
+            failures++;
+        }
+    }
+
+#define CHECK(cond) check((cond), #cond, __LINE__)
+
+//Evaluates expression expecting it to panic with given message.
+#define CHECK_PANICS(expr, message) \
+    do { \
+        panic_message = nullptr; \
+        if (setjmp(panic_jump) == 0) { \
+            static_cast<void>(expr); \
+            check(false, #expr " panics", __LINE__); \
+        } else { \
+            check(std::strcmp(panic_message, message) == 0, #expr " panic message", __LINE__); \
+        } \
+    } while (false)
+
+    typedef result::Result<int, int> Res;
+}
+
+int main() {
+    result::set_panic_handler(test_panic);
+
+    const Res ok = Res::ok(1);
+    const Res err = Res::error(2);
+    CHECK(ok.unwrap() == 1);
+    CHECK(err.unwrap_err() == 2);
+    CHECK_PANICS(err.unwrap(), "Surprisingly no value...");
+    CHECK_PANICS(ok.unwrap_err(), "Surprisingly no error...");
+    CHECK_PANICS(Res::error(3).unwrap(), "Surprisingly no value...");
+
+    const result::Result<void, void> void_err = result::Result<void, void>::error();
+    CHECK_PANICS(void_err.unwrap(), "Surprisingly no value...");
+
+    result::ResultVector<int, int> rows;
+    rows.emplace_ok(1);
+    rows.emplace_err(2);
+    CHECK(rows[0].unwrap() == 1);
+    CHECK_PANICS(rows[1].unwrap(), "Surprisingly no value...");
+    CHECK_PANICS(rows[0].unwrap_err(), "Surprisingly no error...");
+
+    const int numbers[] = {1, 2, 3};
+    auto doubled = result::par_try_transform(result::par.with_grain(1), numbers, [](int num) {
+        return Res::ok(num * 2);
+    });
+    CHECK(doubled.unwrap().size() == 3);
+
+    typedef result::Validation<int, int> Validated;
+    Validated::Errors one;
+    one.push_back(1);
+    CHECK(Validated::errors(std::move(one)).error_count() == 1);
+    CHECK_PANICS(Validated::errors(Validated::Errors()), "Validation failed without errors...");
+    CHECK_PANICS(Validated(result::Result<int, Validated::Errors>::error(Validated::Errors())), "Validation failed without errors...");
+
+    //Panic leaves shard locked, so cache is never destroyed.
+    auto& cache = *new result::ResultCache<int, int, int>();
+    CHECK(cache.get_or_load(1, [](int key) {
+        return Res::ok(key);
+    }).unwrap() == 1);
+    CHECK_PANICS(cache.get_or_load(2, [&cache](int key) {
+        return cache.get_or_load(key, [](int same) {
+            return Res::ok(same);
+        });
+    }), "ResultCache: loader looks up key it loads");
+
+    CHECK(result::set_panic_handler(nullptr) == test_panic);
+
+    if (failures != 0) {
+        std::fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    std::printf("All panic checks passed\n");
+    return 0;
+}
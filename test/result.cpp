@@ -4,6 +4,12 @@
 #include <iostream>
 #include <cassert>
 #include <string>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <functional>
+#include <unordered_set>
 
 #include <result.hpp>
 
@@ -292,3 +298,541 @@ TEST_CASE("try unwrap_or_default") {
     REQUIRE(ok_value == 1);
     REQUIRE(err_value == 0);
 }
+
+TEST_CASE("try trivial result") {
+    typedef result::Result<int, int> Pod;
+    typedef result::Result<std::vector<int>, std::string> NonPod;
+
+    static_assert(std::is_trivially_destructible<Pod>::value);
+    static_assert(std::is_trivially_move_constructible<Pod>::value);
+    static_assert(std::is_trivially_move_assignable<Pod>::value);
+    static_assert(std::is_trivially_copyable<Pod>::value);
+    static_assert(sizeof(Pod) <= 2 * sizeof(void*), "Must fit into pair of registers");
+
+    static_assert(!std::is_trivially_destructible<NonPod>::value);
+    static_assert(!std::is_trivially_move_constructible<NonPod>::value);
+    static_assert(!std::is_trivially_move_assignable<NonPod>::value);
+    static_assert(std::is_nothrow_move_constructible<NonPod>::value);
+
+    //Only Value's triviality is different
+    static_assert(!std::is_trivially_destructible<result::Result<std::string, int>>::value);
+    static_assert(!std::is_trivially_move_constructible<result::Result<int, std::string>>::value);
+
+    Pod pod = Pod::error(2);
+    pod = Pod::ok(1);
+    REQUIRE(pod.unwrap() == 1);
+
+    NonPod non_pod = NonPod::error("lolka");
+    non_pod = NonPod::ok(std::vector<int>({1, 2}));
+    REQUIRE(non_pod.unwrap() == std::vector<int>({1, 2}));
+    non_pod = NonPod::error("lolka");
+    REQUIRE(non_pod.unwrap_err() == "lolka");
+
+    NonPod moved(std::move(non_pod));
+    REQUIRE(moved.unwrap_err() == "lolka");
+}
+
+struct NotFound {};
+enum class ErrorCode: unsigned {
+    ok = 0,
+    not_found,
+    timeout
+};
+
+template<>
+struct result::niche_traits<const int*>: result::niche_value<const int*, nullptr> {};
+template<>
+struct result::niche_traits<ErrorCode>: result::niche_value<ErrorCode, ErrorCode::ok> {};
+
+TEST_CASE("try niche result") {
+    typedef result::Result<const int*, NotFound> Lookup;
+    typedef result::Result<NotFound, ErrorCode> Status;
+
+    static_assert(sizeof(Lookup) == sizeof(const int*));
+    static_assert(sizeof(Status) == sizeof(ErrorCode));
+    static_assert(std::is_trivially_copyable<Lookup>::value);
+    static_assert(std::is_trivially_copyable<Status>::value);
+
+    //No niche or non-empty other side, tag is required.
+    static_assert(sizeof(result::Result<int*, NotFound>) == 2 * sizeof(int*));
+    static_assert(sizeof(result::Result<const int*, int>) == 2 * sizeof(int*));
+    static_assert(sizeof(result::Result<uint32_t, uint32_t>) == 2 * sizeof(uint32_t));
+    static_assert(sizeof(result::Result<uint64_t, char>) == 2 * sizeof(uint64_t));
+
+    const int value = 5;
+    auto found = Lookup::ok(&value);
+    auto not_found = Lookup::error(NotFound());
+
+    REQUIRE(found.is_ok());
+    REQUIRE(*found.unwrap() == 5);
+    REQUIRE(found.error() == nullptr);
+    REQUIRE(not_found.is_err());
+    REQUIRE(not_found.value() == nullptr);
+    REQUIRE(not_found.error() != nullptr);
+
+    not_found = std::move(found);
+    REQUIRE(not_found.is_ok());
+    REQUIRE(not_found.unwrap() == &value);
+
+    auto status_ok = Status::ok();
+    auto status_err = Status::error(ErrorCode::timeout);
+
+    REQUIRE(status_ok.is_ok());
+    REQUIRE(status_ok.error() == nullptr);
+    REQUIRE(status_err.is_err());
+    REQUIRE(status_err.unwrap_err() == ErrorCode::timeout);
+
+    auto mapped = status_err.map_err([](ErrorCode code) {
+        return code == ErrorCode::timeout ? ErrorCode::not_found : code;
+    });
+    REQUIRE(mapped.unwrap_err() == ErrorCode::not_found);
+
+    result::Result<const int*, NotFound> from_err = result::Err(NotFound());
+    REQUIRE(from_err.is_err());
+}
+
+struct Tracked {
+    static int copies;
+    static int moves;
+
+    int value;
+
+    explicit Tracked(int value) noexcept : value(value) {}
+    Tracked(const Tracked& right) noexcept : value(right.value) {
+        copies++;
+    }
+    Tracked(Tracked&& right) noexcept : value(right.value) {
+        moves++;
+    }
+    Tracked& operator=(const Tracked& right) noexcept {
+        value = right.value;
+        copies++;
+        return *this;
+    }
+    Tracked& operator=(Tracked&& right) noexcept {
+        value = right.value;
+        moves++;
+        return *this;
+    }
+
+    static void reset() noexcept {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+TEST_CASE("try chain without copies") {
+    typedef result::Result<Tracked, Tracked> Res;
+
+    auto inc = [](Tracked&& value) {
+        return Tracked(value.value + 1);
+    };
+    auto inc_res = [](Tracked&& value) {
+        return Res::ok(value.value + 1);
+    };
+    auto inc_err = [](Tracked&& value) {
+        return Res::error(value.value + 1);
+    };
+
+    Tracked::reset();
+    auto ok = Res::ok(1).map(inc).and_then(inc_res).map_err(inc).or_else(inc_err).map(inc);
+    REQUIRE(ok.unwrap().value == 4);
+    REQUIRE(Tracked::copies == 0);
+    //Each step that passes value through moves it at most once.
+    REQUIRE(Tracked::moves == 2);
+
+    Tracked::reset();
+    auto error = Res::error(1).map_err(inc).or_else(inc_err).map(inc).and_then(inc_res).map_err(inc);
+    REQUIRE(error.unwrap_err().value == 4);
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves == 2);
+
+    Tracked::reset();
+    auto by_ref = ok.map([](Tracked& value) {
+        return value.value;
+    });
+    const auto& const_ok = ok;
+    auto by_const_ref = const_ok.and_then([](const Tracked& value) {
+        return result::Result<int, Tracked>::ok(value.value);
+    });
+    REQUIRE(by_ref.unwrap() == 4);
+    REQUIRE(by_const_ref.unwrap() == 4);
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves == 0);
+
+    //Lvalue receiver keeps its payload, so passing through requires copy.
+    auto copied = error.map([](const Tracked& value) {
+        return Tracked(value.value);
+    });
+    REQUIRE(copied.unwrap_err().value == 4);
+    REQUIRE(error.unwrap_err().value == 4);
+    REQUIRE(Tracked::copies == 1);
+    REQUIRE(Tracked::moves == 0);
+}
+
+TEST_CASE("try copy result") {
+    typedef result::Result<int, int> Pod;
+    typedef result::Result<std::string, int> Text;
+    typedef result::Result<std::unique_ptr<int>, int> Unique;
+
+    static_assert(std::is_trivially_copy_constructible<Pod>::value);
+    static_assert(std::is_trivially_copy_assignable<Pod>::value);
+    static_assert(std::is_copy_constructible<Text>::value);
+    static_assert(std::is_copy_assignable<Text>::value);
+    static_assert(!std::is_trivially_copy_constructible<Text>::value);
+    static_assert(!std::is_copy_constructible<Unique>::value);
+    static_assert(!std::is_copy_assignable<Unique>::value);
+    static_assert(std::is_move_constructible<Unique>::value);
+
+    const Pod pod = Pod::error(2);
+    Pod pod_copy(pod);
+    REQUIRE(pod_copy.unwrap_err() == 2);
+
+    const Text long_text = Text::ok(std::string(100, 'a'));
+    Text text(long_text);
+    REQUIRE(text.unwrap() == long_text.unwrap());
+    REQUIRE(text.value()->data() != long_text.value()->data());
+
+    //The same variant re-uses buffer of destination.
+    const char* buffer = text.value()->data();
+    text = Text::ok(std::string(50, 'b'));
+    text = long_text;
+    REQUIRE(text.unwrap() == std::string(100, 'a'));
+    REQUIRE(text.value()->data() == buffer);
+
+    const Text error = Text::error(1);
+    text = error;
+    REQUIRE(text.unwrap_err() == 1);
+    text = long_text;
+    REQUIRE(text.unwrap() == long_text.unwrap());
+
+    Tracked::reset();
+    typedef result::Result<Tracked, int> Res;
+    const Res tracked = Res::ok(1);
+    Res tracked_copy(tracked);
+    tracked_copy = tracked;
+    REQUIRE(tracked_copy.unwrap().value == 1);
+    REQUIRE(Tracked::copies == 2);
+    REQUIRE(Tracked::moves == 0);
+}
+
+TEST_CASE("try emplace") {
+    typedef result::Result<std::string, std::vector<int>> Res;
+
+    auto res = Res::ok("lolka");
+    std::string& value = res.emplace_ok(3, 'a');
+    REQUIRE(value == "aaa");
+    REQUIRE(&value == res.value());
+
+    std::vector<int>& error = res.emplace_err(2, 7);
+    REQUIRE(res.is_err());
+    REQUIRE(error == std::vector<int>({7, 7}));
+
+    res.emplace_ok("kek");
+    REQUIRE(res.unwrap() == "kek");
+
+    auto no_value = result::Result<void, int>::error(1);
+    no_value.emplace_ok();
+    REQUIRE(no_value.is_ok());
+    static_assert(std::is_same<decltype(no_value.emplace_ok()), void>::value);
+
+    const int number = 5;
+    auto lookup = result::Result<const int*, NotFound>::error(NotFound());
+    REQUIRE(lookup.emplace_ok(&number) == &number);
+    REQUIRE(*lookup.unwrap() == 5);
+    lookup.emplace_err();
+    REQUIRE(lookup.is_err());
+
+    Tracked::reset();
+    auto tracked = result::Result<Tracked, int>::error(1);
+    tracked.emplace_ok(2);
+    REQUIRE(tracked.unwrap().value == 2);
+    REQUIRE(Tracked::copies == 0);
+    REQUIRE(Tracked::moves == 0);
+}
+
+//Construction from int throws when asked to, while moves never throw.
+struct Fragile {
+    std::string text;
+
+    explicit Fragile(int value) : text(std::to_string(value)) {
+        if (value < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+    Fragile(const Fragile& right) : text(right.text) {
+        if (right.text == "0") {
+            throw std::runtime_error("zero");
+        }
+    }
+    Fragile(Fragile&&) noexcept = default;
+    Fragile& operator=(const Fragile&) = default;
+    Fragile& operator=(Fragile&&) noexcept = default;
+};
+
+//Even move may throw.
+struct Brittle {
+    int value;
+
+    explicit Brittle(int value) : value(value) {
+        if (value < 0) {
+            throw std::runtime_error("negative");
+        }
+    }
+    Brittle(const Brittle& right) : value(right.value) {
+        if (right.value == 0) {
+            throw std::runtime_error("zero");
+        }
+    }
+    Brittle(Brittle&& right) noexcept(false) : value(right.value) {}
+    Brittle& operator=(const Brittle&) = default;
+    Brittle& operator=(Brittle&&) noexcept(false) = default;
+
+    bool operator==(const Brittle& right) const noexcept {
+        return value == right.value;
+    }
+};
+
+namespace std {
+    template<>
+    struct hash<Brittle> {
+        std::size_t operator()(const Brittle& brittle) const noexcept {
+            return std::hash<int>()(brittle.value);
+        }
+    };
+}
+
+TEST_CASE("try exception guarantees of assignment") {
+    typedef result::Result<int, Fragile> Res;
+
+    static_assert(std::is_nothrow_move_assignable<Res>::value);
+    static_assert(!std::is_nothrow_copy_assignable<Res>::value);
+
+    //Nothing changes if construction throws.
+    auto res = Res::ok(1);
+    REQUIRE_THROWS(res.emplace_err(-1));
+    REQUIRE(res.unwrap() == 1);
+
+    const auto zero = Res::error(0);
+    REQUIRE_THROWS(res = zero);
+    REQUIRE(res.unwrap() == 1);
+    REQUIRE_THROWS(Res(zero));
+
+    res.emplace_err(2);
+    REQUIRE(res.unwrap_err().text == "2");
+
+    //Without non-throwing move, other variant is kept aside and restored.
+    typedef result::Result<int, Brittle> Fallible;
+    static_assert(!std::is_nothrow_move_assignable<Fallible>::value);
+
+    auto fallible = Fallible::ok(1);
+    REQUIRE_THROWS(fallible.emplace_err(-1));
+    REQUIRE(fallible.unwrap() == 1);
+    fallible = Fallible::error(3);
+    REQUIRE_THROWS(fallible.emplace_err(-1));
+    REQUIRE(fallible.unwrap_err().value == 3);
+    fallible = Fallible::ok(4);
+    REQUIRE(fallible.unwrap() == 4);
+}
+
+TEST_CASE("try valueless result after throwing payload constructor") {
+    typedef result::Result<Brittle, Brittle> Fallible;
+
+    //The same variant is assigned from payload constructed aside.
+    auto fallible = Fallible::ok(1);
+    REQUIRE_THROWS(fallible.emplace_ok(-1));
+    REQUIRE(fallible.unwrap().value == 1);
+    REQUIRE_FALSE(fallible.valueless());
+
+    //Neither variant can be moved without throwing, so nothing is left.
+    REQUIRE_THROWS(fallible.emplace_err(-1));
+    REQUIRE(fallible.valueless());
+    REQUIRE_FALSE(fallible.is_ok());
+    REQUIRE_FALSE(fallible.is_err());
+    REQUIRE(fallible.value() == nullptr);
+    REQUIRE(fallible.error() == nullptr);
+    REQUIRE(fallible != Fallible::ok(1));
+    REQUIRE(fallible != Fallible::error(1));
+
+    //Copy assignment of the other variant throws the same way.
+    auto copied = Fallible::ok(2);
+    const auto zero = Fallible::error(0);
+    REQUIRE_THROWS(copied = zero);
+    REQUIRE(copied.valueless());
+    REQUIRE(copied == fallible);
+    REQUIRE(std::hash<Fallible>()(copied) == std::hash<Fallible>()(fallible));
+
+    fallible = Fallible::error(3);
+    REQUIRE(fallible.unwrap_err().value == 3);
+    copied = fallible;
+    REQUIRE(copied.unwrap_err().value == 3);
+
+    static_assert(!result::internal::traits<int, Brittle>::may_be_valueless);
+    REQUIRE_FALSE(result::Result<int, int>::ok(1).valueless());
+}
+
+TEST_CASE("try reference result") {
+    typedef result::Result<const std::string&, NotFound> Lookup;
+    typedef result::Result<std::string&, int> Mutable;
+
+    static_assert(sizeof(Lookup) == sizeof(void*), "Null pointer encodes empty error");
+    static_assert(sizeof(Mutable) == 2 * sizeof(void*));
+    static_assert(std::is_trivially_copyable<Lookup>::value);
+    static_assert(std::is_trivially_copyable<Mutable>::value);
+
+    const std::vector<std::string> table = {"first", "second"};
+    const auto find = [&table](std::size_t idx) {
+        if (idx < table.size()) {
+            return Lookup::ok(table[idx]);
+        }
+        return Lookup::error(NotFound());
+    };
+
+    const auto found = find(1);
+    REQUIRE(found.is_ok());
+    static_assert(std::is_same<decltype(found.unwrap()), const std::string&>::value);
+    REQUIRE(&found.unwrap() == &table[1]);
+    REQUIRE(found.value() == &table[1]);
+    REQUIRE(&find(0).unwrap() == &table[0]);
+    REQUIRE(find(2).is_err());
+    REQUIRE(find(2).value() == nullptr);
+
+    const std::string fallback("none");
+    REQUIRE(&find(2).unwrap_or(fallback) == &fallback);
+    REQUIRE(&find(0).unwrap_or(fallback) == &table[0]);
+
+    //Callbacks receive referent.
+    auto size = find(1).map([](const std::string& value) {
+        return value.size();
+    });
+    REQUIRE(size.unwrap() == 6);
+    auto first = find(0).and_then([&table](const std::string& value) {
+        return Lookup::ok(table[value.size() == 5 ? 1 : 0]);
+    });
+    REQUIRE(&first.unwrap() == &table[1]);
+
+    //Map can yield reference too.
+    struct Entry {
+        std::string name;
+    };
+    Entry entry{"entry"};
+    auto name = result::Result<Entry&, int>::ok(entry).map([](Entry& value) -> std::string& {
+        return value.name;
+    });
+    static_assert(std::is_same<decltype(name), Mutable>::value);
+
+    //Const Result doesn't change referent's constness, while assignment rebinds.
+    const Mutable& view = name;
+    view.unwrap() += "!";
+    REQUIRE(entry.name == "entry!");
+    std::string other("other");
+    name = Mutable::ok(other);
+    REQUIRE(&name.unwrap() == &other);
+    REQUIRE(entry.name == "entry!");
+    name = Mutable::error(1);
+    REQUIRE(name.unwrap_err() == 1);
+}
+
+TEST_CASE("try void result") {
+    typedef result::Result<void, std::string> Void;
+    typedef result::Result<int, void> NoError;
+
+    static_assert(sizeof(Void) == sizeof(std::string) + alignof(std::string));
+    static_assert(sizeof(result::Result<void, std::error_code>) <= sizeof(std::error_code) + alignof(std::error_code));
+    static_assert(sizeof(result::Result<void, int>) == 2 * sizeof(int));
+    static_assert(sizeof(result::Result<void, ErrorCode>) == sizeof(ErrorCode));
+    static_assert(sizeof(result::Result<int*, void>) == 2 * sizeof(int*));
+    static_assert(sizeof(result::Result<const int*, void>) == sizeof(int*));
+    static_assert(std::is_trivially_copyable<result::Result<void, int>>::value);
+
+    auto ok = Void::ok();
+    auto error = Void::error("lolka");
+    REQUIRE(ok.is_ok());
+    REQUIRE(ok.error() == nullptr);
+    REQUIRE(error.is_err());
+    REQUIRE(*error.error() == "lolka");
+    REQUIRE_NOTHROW(ok.unwrap());
+    REQUIRE_THROWS(error.unwrap());
+    REQUIRE_NOTHROW(std::move(ok).unwrap());
+
+    auto mapped = Void::ok().map([]() {
+        return 1;
+    });
+    REQUIRE(mapped.unwrap() == 1);
+
+    int calls = 0;
+    auto to_void = mapped.map([&calls](int value) {
+        calls += value;
+    });
+    static_assert(std::is_same<decltype(to_void), Void>::value);
+    REQUIRE(to_void.is_ok());
+    REQUIRE(calls == 1);
+
+    auto chained = to_void.and_then([]() {
+        return result::Result<int, std::string>::ok(2);
+    });
+    REQUIRE(chained.unwrap() == 2);
+
+    auto chained_err = error.and_then([]() {
+        return result::Result<int, std::string>::ok(2);
+    });
+    REQUIRE(chained_err.unwrap_err() == "lolka");
+
+    auto no_error = NoError::ok(1);
+    auto no_value = NoError::error();
+    REQUIRE(no_error.unwrap() == 1);
+    REQUIRE(no_error.value() != nullptr);
+    REQUIRE(no_value.is_err());
+    REQUIRE(no_value.value() == nullptr);
+    REQUIRE_THROWS(no_value.unwrap());
+    REQUIRE_NOTHROW(no_value.unwrap_err());
+    REQUIRE_THROWS(no_error.unwrap_err());
+    REQUIRE(no_value.unwrap_or(2) == 2);
+
+    auto described = no_value.map_err([]() {
+        return std::string("lolka");
+    });
+    REQUIRE(described.unwrap_err() == "lolka");
+
+    auto recovered = NoError::error().or_else([]() {
+        return NoError::ok(3);
+    });
+    REQUIRE(recovered.unwrap() == 3);
+
+    auto flag = result::Result<void, void>::ok();
+    REQUIRE(flag.is_ok());
+    flag = result::Result<void, void>::error();
+    REQUIRE(flag.is_err());
+}
+
+TEST_CASE("try equality and hash") {
+    typedef result::Result<int, std::string> Res;
+
+    REQUIRE(Res::ok(1) == Res::ok(1));
+    REQUIRE(Res::ok(1) != Res::ok(2));
+    REQUIRE(Res::error("lolka") == Res::error("lolka"));
+    REQUIRE(Res::error("lolka") != Res::error("kek"));
+    REQUIRE(result::Result<int, int>::ok(1) != result::Result<int, int>::error(1));
+    REQUIRE(Res::ok(1) == result::Result<long, const char*>::ok(1L));
+    REQUIRE(result::Result<void, int>::ok() == result::Result<void, int>::ok());
+    REQUIRE(result::Result<void, void>::error() != result::Result<void, void>::ok());
+
+    int value = 1;
+    int other = 1;
+    REQUIRE(result::Result<int&, int>::ok(value) == result::Result<int&, int>::ok(other));
+
+    static_assert(result::Result<int, int>::ok(1) == result::Result<int, int>::ok(1));
+
+    const std::hash<result::Result<int, int>> hash;
+    REQUIRE(hash(result::Result<int, int>::ok(1)) == hash(result::Result<int, int>::ok(1)));
+    REQUIRE(hash(result::Result<int, int>::ok(1)) != hash(result::Result<int, int>::error(1)));
+    REQUIRE(std::hash<result::Result<void, void>>()(result::Result<void, void>::ok()) != std::hash<result::Result<void, void>>()(result::Result<void, void>::error()));
+
+    std::unordered_set<Res> seen = {Res::ok(1), Res::error("lolka"), Res::ok(1)};
+    REQUIRE(seen.size() == 2);
+    REQUIRE(seen.count(Res::error("lolka")) == 1);
+    REQUIRE(seen.count(Res::ok(2)) == 0);
+}
@@ -0,0 +1,147 @@
+#include <catch.hpp>
+
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <result_algorithm.hpp>
+
+#if defined(__cpp_lib_ranges)
+#include <ranges>
+#include <span>
+#endif
+
+typedef result::Result<int, std::string> Parsed;
+
+static Parsed parse(const std::string& text) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        return Parsed::error("not a number: " + text);
+    }
+    return Parsed::ok(std::stoi(text));
+}
+
+TEST_CASE("try collect") {
+    std::vector<Parsed> all_ok;
+    all_ok.push_back(Parsed::ok(1));
+    all_ok.push_back(Parsed::ok(2));
+    all_ok.push_back(Parsed::ok(3));
+
+    auto collected = result::collect(all_ok);
+    REQUIRE(collected.is_ok());
+    REQUIRE(collected.unwrap() == std::vector<int>{1, 2, 3});
+    REQUIRE(collected.unwrap().capacity() == 3);
+
+    std::vector<Parsed> with_err;
+    with_err.push_back(Parsed::ok(1));
+    with_err.push_back(Parsed::error("first"));
+    with_err.push_back(Parsed::error("second"));
+
+    auto failed = result::collect(with_err);
+    REQUIRE(failed.is_err());
+    REQUIRE(failed.unwrap_err() == "first");
+    REQUIRE(*with_err[1].error() == "first");
+
+    auto moved = result::collect(std::move(with_err));
+    REQUIRE(moved.unwrap_err() == "first");
+    REQUIRE(with_err[1].error()->empty());
+}
+
+TEST_CASE("try collect moves payload") {
+    typedef result::Result<std::string, int> Text;
+    const std::string long_text(64, 'x');
+
+    std::vector<Text> texts;
+    texts.push_back(Text::ok(long_text));
+    texts.push_back(Text::ok(long_text));
+
+    auto copied = result::collect(texts);
+    REQUIRE(copied.unwrap()[0] == long_text);
+    REQUIRE(*texts[0].value() == long_text);
+
+    auto moved = result::collect(std::move(texts));
+    REQUIRE(moved.unwrap()[1] == long_text);
+    REQUIRE(texts[1].value()->empty());
+
+    std::list<Text> listed;
+    listed.push_back(Text::ok(long_text));
+    auto from_list = result::collect(listed);
+    REQUIRE(from_list.unwrap().size() == 1);
+
+#if defined(__cpp_lib_ranges)
+    //Span and view are rvalues, but their elements belong to vector.
+    std::vector<Text> viewed;
+    viewed.push_back(Text::ok(long_text));
+    viewed.push_back(Text::error(1));
+
+    REQUIRE(result::collect(std::span(viewed).first(1)).unwrap()[0] == long_text);
+    REQUIRE(*viewed[0].value() == long_text);
+    REQUIRE(result::collect(viewed | std::views::all).unwrap_err() == 1);
+    REQUIRE(result::collect(viewed | std::views::take(1)).unwrap()[0] == long_text);
+    REQUIRE(*viewed[0].value() == long_text);
+#endif
+}
+
+TEST_CASE("try try_transform") {
+    const std::vector<std::string> lines{"1", "22", "333"};
+
+    auto numbers = result::try_transform(lines, parse);
+    REQUIRE(numbers.unwrap() == std::vector<int>{1, 22, 333});
+
+    const std::vector<std::string> bad_lines{"1", "x", "y"};
+    auto bad = result::try_transform(bad_lines, parse);
+    REQUIRE(bad.unwrap_err() == "not a number: x");
+
+    std::vector<Parsed> parsed;
+    parsed.push_back(Parsed::ok(2));
+    parsed.push_back(Parsed::ok(4));
+
+    auto halves = result::try_transform(parsed, [](int num) {
+        return num / 2;
+    });
+    REQUIRE(halves.unwrap() == std::vector<int>{1, 2});
+
+    auto checked = result::try_transform(parsed, [](int num) {
+        return num > 2 ? Parsed::error("too big") : Parsed::ok(num);
+    });
+    REQUIRE(checked.unwrap_err() == "too big");
+}
+
+TEST_CASE("try try_fold") {
+    const std::vector<std::string> lines{"1", "2", "3"};
+
+    auto total = result::try_fold(lines, 0L, [](long sum, const std::string& line) {
+        return parse(line).map([sum](int num) {
+            return sum + num;
+        });
+    });
+    REQUIRE(total.unwrap() == 6);
+
+    std::vector<Parsed> parsed;
+    parsed.push_back(Parsed::ok(1));
+    parsed.push_back(Parsed::error("bad"));
+
+    int calls = 0;
+    auto failed = result::try_fold(parsed, 0, [&calls](int sum, int num) {
+        calls++;
+        return sum + num;
+    });
+    REQUIRE(failed.unwrap_err() == "bad");
+    REQUIRE(calls == 1);
+}
+
+TEST_CASE("try partition") {
+    std::list<Parsed> parsed;
+    parsed.push_back(Parsed::ok(1));
+    parsed.push_back(Parsed::error("a"));
+    parsed.push_back(Parsed::ok(2));
+    parsed.push_back(Parsed::error("b"));
+    parsed.push_back(Parsed::ok(3));
+
+    auto [numbers, errors] = result::partition(std::move(parsed));
+    REQUIRE(numbers == std::vector<int>{1, 2, 3});
+    REQUIRE(numbers.capacity() == 3);
+    REQUIRE(errors == std::vector<std::string>{"a", "b"});
+    REQUIRE(errors.capacity() == 2);
+}
@@ -0,0 +1,142 @@
+#include <catch.hpp>
+
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include <result_any_error.hpp>
+
+#include "counting.hpp"
+
+namespace {
+    struct Timeout {
+        int millis;
+    };
+
+    struct Large {
+        std::array<char, 64> payload;
+        std::string_view message() const {
+            return std::string_view(payload.data());
+        }
+    };
+
+    struct Counted {
+        static int alive;
+
+        Counted() noexcept {
+            alive++;
+        }
+        Counted(Counted&&) noexcept {
+            alive++;
+        }
+        ~Counted() {
+            alive--;
+        }
+    };
+    int Counted::alive = 0;
+
+    struct Http {
+        int status;
+    };
+}
+
+template<>
+struct result::error_traits<Http> {
+    static std::string_view message(const Http& error) noexcept {
+        return error.status == 404 ? "not found" : "http error";
+    }
+};
+
+TEST_CASE("try any error") {
+    static_assert(sizeof(result::AnyError) == result::AnyError::buffer_size + sizeof(void*));
+    static_assert(result::AnyError::fits_inline<std::string>);
+    static_assert(result::AnyError::fits_inline<std::error_code>);
+    static_assert(!result::AnyError::fits_inline<Large>);
+
+    result::AnyError timeout = Timeout{100};
+    REQUIRE(timeout.is_inline());
+    REQUIRE(timeout.is<Timeout>());
+    REQUIRE(!timeout.is<Http>());
+    REQUIRE(timeout.downcast<Timeout>()->millis == 100);
+    REQUIRE(timeout.downcast<Http>() == nullptr);
+    REQUIRE(timeout.message().empty());
+
+    result::AnyError text = std::string("backend is down");
+    REQUIRE(text.is_inline());
+    REQUIRE(text.message() == "backend is down");
+
+    result::AnyError literal = "literal";
+    REQUIRE(literal.message() == "literal");
+
+    result::AnyError runtime = std::runtime_error("runtime");
+    REQUIRE(runtime.message() == "runtime");
+
+    result::AnyError http = Http{404};
+    REQUIRE(http.message() == "not found");
+
+    Large large_error{};
+    large_error.payload[0] = 'L';
+    result::AnyError large = large_error;
+    REQUIRE(!large.is_inline());
+    REQUIRE(large.message() == "L");
+    REQUIRE(large.downcast<Large>()->payload[0] == 'L');
+
+    result::AnyError moved = std::move(text);
+    REQUIRE(text.empty());
+    REQUIRE(text.message().empty());
+    REQUIRE(moved.message() == "backend is down");
+
+    moved = std::move(large);
+    REQUIRE(large.empty());
+    REQUIRE(moved.downcast<Large>() != nullptr);
+}
+
+TEST_CASE("try any error lifetime") {
+    {
+        result::AnyError error{std::in_place_type<Counted>};
+        REQUIRE(Counted::alive == 1);
+
+        result::AnyError moved = std::move(error);
+        REQUIRE(Counted::alive == 1);
+
+        moved = Timeout{1};
+        REQUIRE(Counted::alive == 0);
+
+        moved = result::AnyError(std::in_place_type<Counted>);
+        REQUIRE(Counted::alive == 1);
+    }
+    REQUIRE(Counted::alive == 0);
+}
+
+TEST_CASE("try erase error") {
+    typedef result::Result<int, std::error_code> IoResult;
+
+    auto io_error = IoResult::error(std::make_error_code(std::errc::timed_out));
+    counting::Meter meter;
+    result::Result<int, result::AnyError> erased = io_error.map_err(result::to_any_error);
+    REQUIRE(meter.allocations() == 0);
+    REQUIRE(erased.is_err());
+    REQUIRE(erased.unwrap_err().is_inline());
+    REQUIRE_THROWS_AS(erased.unwrap(), const char*);
+    REQUIRE(*erased.unwrap_err().downcast<std::error_code>() == std::errc::timed_out);
+    REQUIRE(erased.unwrap_err().message() == std::make_error_code(std::errc::timed_out).message());
+    REQUIRE(!erased.unwrap_err().message().empty());
+
+    //Message is formatted from error code, that is kept while error is moved.
+    result::AnyError moved_code = std::move(erased.unwrap_err());
+    REQUIRE(moved_code.message() == std::make_error_code(std::errc::timed_out).message());
+
+    auto erased_ok = result::erase_error(IoResult::ok(1));
+    REQUIRE(erased_ok.unwrap() == 1);
+
+    auto chained = result::erase_error(result::Result<int, std::string>::error("parse")).and_then([](int value) {
+        return result::Result<int, result::AnyError>::ok(value);
+    });
+    REQUIRE(chained.unwrap_err().message() == "parse");
+
+    auto direct = result::Result<int, result::AnyError>::error(Timeout{5});
+    REQUIRE(direct.unwrap_err().downcast<Timeout>()->millis == 5);
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <result_arena.hpp>
+
+namespace {
+    typedef result::Result<int, result::ArenaError> Res;
+
+    Res lookup(int id) {
+        return Res::error(result::ArenaError::make(404, "user ", id, " not found").with("table", "users"));
+    }
+
+    Res load(int id) {
+        return lookup(id).map_err([](const result::ArenaError& error) {
+            return error.with("attempt", 2);
+        });
+    }
+}
+
+TEST_CASE("ErrorArena reuses memory after reset", "[arena]") {
+    result::ErrorArena arena(128);
+    REQUIRE(arena.capacity() == 0);
+
+    for (int round = 0; round < 3; round++) {
+        for (int idx = 0; idx < 10; idx++) {
+            void* block = arena.allocate(40, 8);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(block) % 8 == 0);
+        }
+        arena.reset();
+    }
+    const std::size_t warm = arena.capacity();
+    REQUIRE(warm >= 400);
+
+    //Allocation larger than chunk gets its own one.
+    REQUIRE(arena.allocate(1000, 1) != nullptr);
+    REQUIRE(arena.capacity() >= warm + 1000);
+    arena.release();
+    REQUIRE(arena.capacity() == 0);
+}
+
+TEST_CASE("ErrorArena::Scope rewinds to its start", "[arena]") {
+    result::ErrorArena arena(64);
+    const result::ArenaString outer = result::ArenaString::copy("outer", arena);
+    char* inner_block = nullptr;
+    {
+        result::ErrorArena::Scope scope(arena);
+        inner_block = static_cast<char*>(arena.allocate(16, 1));
+        {
+            result::ErrorArena::Scope nested(arena);
+            static_cast<void>(arena.allocate(200, 1));
+        }
+        REQUIRE(arena.allocate(16, 1) == inner_block + 16);
+    }
+    REQUIRE(arena.allocate(16, 1) == inner_block);
+    REQUIRE(std::string_view(outer) == "outer");
+}
+
+TEST_CASE("ArenaStringBuilder formats into arena", "[arena]") {
+    result::ErrorArena arena(64);
+    result::ArenaStringBuilder builder(arena);
+    builder << "id=" << 42 << ' ' << -7L << ' ' << true << ' ' << 1.5 << ' ' << std::string("heap") << ' ' << std::string_view("view");
+    REQUIRE(builder.size() == 27);
+
+    //Outgrows the chunk, so string is moved into the next one.
+    builder.append(" and more text").append(" past the end of the first chunk");
+    REQUIRE(arena.capacity() > 64);
+    const result::ArenaString text = builder.str();
+    REQUIRE(std::string_view(text) == "id=42 -7 true 1.5 heap view and more text past the end of the first chunk");
+    REQUIRE(builder.size() == 0);
+
+    //Unused capacity is returned.
+    const result::ArenaString small = (builder << "ab").str();
+    REQUIRE(static_cast<char*>(arena.allocate(1, 1)) == small.data() + 2);
+
+    REQUIRE(builder.str().empty());
+    constexpr result::ArenaString literal = result::ArenaString::from_static("static");
+    REQUIRE(std::string_view(literal) == "static");
+}
+
+TEST_CASE("ArenaError is trivially copyable handle", "[arena]") {
+    static_assert(std::is_trivially_copyable<Res>::value);
+    static_assert(std::is_trivially_destructible<Res>::value);
+    static_assert(sizeof(result::ArenaError) == 24);
+
+    result::ErrorArena::Scope scope;
+    const Res failed = load(7).and_then([](int value) {
+        return Res::ok(value);
+    });
+    const result::ArenaError& error = *failed.error();
+    REQUIRE(error.code() == 404);
+    REQUIRE(error.message() == "user 7 not found");
+    REQUIRE(std::string_view(*error.find("table")) == "users");
+    REQUIRE(std::string_view(*error.find("attempt")) == "2");
+    REQUIRE(error.find("missing") == nullptr);
+
+    std::string keys;
+    for (const result::ArenaField& field : error.context()) {
+        keys.append(field.key.data(), field.key.size());
+    }
+    REQUIRE(keys == "attempttable");
+    REQUIRE(error.to_string() == "user 7 not found (attempt=2, table=users)");
+
+    const result::ArenaError plain(500, result::ArenaString::from_static("internal"));
+    REQUIRE(plain.context().empty());
+    REQUIRE(plain.to_string() == "internal");
+}
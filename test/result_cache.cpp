@@ -0,0 +1,191 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <result_cache.hpp>
+
+namespace {
+    typedef result::Result<int, std::string> Lookup;
+    typedef result::ResultCache<int, int, std::string> Cache;
+
+    //Table, that knows only even keys.
+    Lookup resolve(int key) {
+        if (key % 2 != 0) {
+            return Lookup::error("unknown " + std::to_string(key));
+        }
+        return Lookup::ok(key * 10);
+    }
+
+    const auto hours = std::chrono::hours(1);
+}
+
+TEST_CASE("ResultCache serves errors from cache", "[cache]") {
+    Cache cache(result::cache_defaults.with_shards(4).with_ok(16, hours).with_error(16, hours));
+    int calls = 0;
+    const auto load = [&](int key) {
+        calls++;
+        return resolve(key);
+    };
+
+    for (int round = 0; round < 3; round++) {
+        REQUIRE(cache.get_or_load(2, load) == Lookup::ok(20));
+        REQUIRE(cache.get_or_load(3, load) == Lookup::error("unknown 3"));
+    }
+    REQUIRE(calls == 2);
+    REQUIRE(cache.size() == 2);
+
+    const result::cache_stats stats = cache.stats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.negative_hits == 2);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.loads == 2);
+
+    REQUIRE(*cache.find(3) == Lookup::error("unknown 3"));
+    REQUIRE_FALSE(cache.find(4).has_value());
+    REQUIRE(cache.erase(3));
+    REQUIRE_FALSE(cache.erase(3));
+    cache.insert(5, Lookup::ok(50));
+    REQUIRE(cache.get_or_load(5, load) == Lookup::ok(50));
+    REQUIRE(calls == 2);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("ResultCache limits Ok and Err entries separately", "[cache]") {
+    //Errors expire immediately, so they are never served.
+    Cache no_negative(result::cache_defaults.with_shards(1).with_ok(2, hours).with_error(2, std::chrono::seconds(0)));
+    REQUIRE(no_negative.get_or_load(1, resolve).is_err());
+    REQUIRE(no_negative.get_or_load(1, resolve).is_err());
+    REQUIRE(no_negative.stats().loads == 2);
+
+    Cache cache(result::cache_defaults.with_shards(1).with_ok(2, hours).with_error(1, hours));
+    for (int key : {2, 4, 6}) {
+        REQUIRE(cache.get_or_load(key, resolve).is_ok());
+    }
+    for (int key : {1, 3}) {
+        REQUIRE(cache.get_or_load(key, resolve).is_err());
+    }
+    REQUIRE(cache.size() == 3);
+    REQUIRE(cache.stats().evictions == 2);
+
+    //The oldest entry of each variant is evicted.
+    REQUIRE_FALSE(cache.find(2).has_value());
+    REQUIRE(cache.find(4).has_value());
+    REQUIRE(cache.find(6).has_value());
+    REQUIRE_FALSE(cache.find(1).has_value());
+    REQUIRE(cache.find(3).has_value());
+
+    Cache disabled(result::cache_defaults.with_error(0, hours));
+    REQUIRE(disabled.get_or_load(1, resolve).is_err());
+    REQUIRE(disabled.size() == 0);
+}
+
+TEST_CASE("ResultCache loads key once for concurrent misses", "[cache]") {
+    Cache cache(result::cache_defaults);
+    std::mutex mutex;
+    std::condition_variable released;
+    bool release = false;
+    std::atomic<int> calls{0};
+
+    const auto slow_load = [&](int key) {
+        calls++;
+        std::unique_lock<std::mutex> lock(mutex);
+        released.wait(lock, [&]() {
+            return release;
+        });
+        return resolve(key);
+    };
+
+    std::vector<std::thread> threads;
+    std::vector<Lookup> found(4, Lookup::ok(0));
+    for (std::size_t idx = 0; idx < found.size(); idx++) {
+        threads.emplace_back([&, idx]() {
+            found[idx] = cache.get_or_load(7, slow_load);
+        });
+    }
+
+    //Waits until every thread either loads or waits for the load.
+    while (cache.stats().loads + cache.stats().coalesced < found.size()) {
+        std::this_thread::yield();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    released.notify_all();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(calls == 1);
+    REQUIRE(cache.stats().coalesced == found.size() - 1);
+    for (const Lookup& lookup : found) {
+        REQUIRE(lookup == Lookup::error("unknown 7"));
+    }
+}
+
+TEST_CASE("ResultCache caches nothing when loader throws", "[cache]") {
+    Cache cache(result::cache_defaults);
+    const auto failing = [](int) -> Lookup {
+        throw std::runtime_error("backend is down");
+    };
+
+    REQUIRE_THROWS_AS(cache.get_or_load(2, failing), std::runtime_error);
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.get_or_load(2, resolve) == Lookup::ok(20));
+}
+
+TEST_CASE("ResultCache keeps Result stored during load", "[cache]") {
+    Cache cache(result::cache_defaults);
+
+    //Loaded Result is returned, but the one inserted meanwhile stays cached.
+    const auto overtaken = [&](int key) {
+        cache.insert(key, Lookup::ok(-1));
+        return resolve(key);
+    };
+    REQUIRE(cache.get_or_load(2, overtaken) == Lookup::ok(20));
+    REQUIRE(*cache.find(2) == Lookup::ok(-1));
+
+    const auto invalidated = [&](int key) {
+        cache.erase(key);
+        return resolve(key);
+    };
+    REQUIRE(cache.get_or_load(6, invalidated) == Lookup::ok(60));
+    REQUIRE_FALSE(cache.find(6).has_value());
+
+    const auto cleared = [&](int key) {
+        cache.clear();
+        return resolve(key);
+    };
+    REQUIRE(cache.get_or_load(4, cleared) == Lookup::ok(40));
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("ResultCache detects loader looking up its own key", "[cache]") {
+    Cache cache(result::cache_defaults);
+    const auto reentrant = [&](int key) {
+        return cache.get_or_load(key, resolve);
+    };
+
+    try {
+        cache.get_or_load(2, reentrant);
+        FAIL("reentrant load is not detected");
+    } catch (const std::system_error& error) {
+        REQUIRE(error.code() == std::errc::resource_deadlock_would_occur);
+    }
+
+    //Other key can be looked up by loader.
+    REQUIRE(cache.get_or_load(3, [&](int key) {
+        return cache.get_or_load(key + 1, resolve);
+    }) == Lookup::ok(40));
+    REQUIRE(cache.get_or_load(2, resolve) == Lookup::ok(20));
+}
@@ -0,0 +1,178 @@
+#include <catch.hpp>
+
+#include <cstddef>
+#include <string_view>
+
+#include <result.hpp>
+
+#ifdef RESULT_HAS_CONSTEXPR
+#include <string>
+#endif
+
+namespace {
+    typedef result::Result<int, int> Halved;
+
+    constexpr Halved half(int value) {
+        if (value % 2 != 0) {
+            return Halved::error(value);
+        }
+        return Halved::ok(value / 2);
+    }
+
+    constexpr int twice(int value) {
+        return value * 2;
+    }
+
+    //Trivial types can be used in constant evaluation since C++17.
+    static_assert(half(4).is_ok());
+    static_assert(half(3).is_err());
+    static_assert(half(8).unwrap() == 4);
+    static_assert(half(3).unwrap_err() == 3);
+    static_assert(half(8).and_then(half).and_then(half).map(twice).unwrap() == 2);
+    static_assert(half(6).and_then(half).map(twice).unwrap_err() == 3);
+    static_assert(half(5).map_err(twice).unwrap_err() == 10);
+    static_assert(half(5).unwrap_or(-1) == -1);
+    static_assert(result::Result<void, int>::ok().is_ok());
+    static_assert(result::Result<int*, void>::error().is_err());
+}
+
+#ifdef RESULT_HAS_CONSTEXPR
+namespace {
+    //Error with non-trivial destructor and move, which requires constexpr destructor of Result.
+    class ParseError {
+        std::size_t position;
+        const char* reason;
+        bool* destroyed;
+
+        public:
+            constexpr ParseError(std::size_t position, const char* reason, bool* destroyed = nullptr) noexcept : position(position), reason(reason), destroyed(destroyed) {}
+            constexpr ParseError(ParseError&& right) noexcept : position(right.position), reason(right.reason), destroyed(right.destroyed) {
+                right.destroyed = nullptr;
+            }
+            constexpr ParseError& operator=(ParseError&& right) noexcept {
+                position = right.position;
+                reason = right.reason;
+                destroyed = right.destroyed;
+                right.destroyed = nullptr;
+                return *this;
+            }
+            constexpr ~ParseError() {
+                if (destroyed != nullptr) {
+                    *destroyed = true;
+                }
+            }
+
+            constexpr std::size_t pos() const noexcept {
+                return position;
+            }
+
+            constexpr std::string_view what() const noexcept {
+                return reason;
+            }
+    };
+
+    struct Config {
+        int port;
+        int threads;
+    };
+
+    typedef result::Result<int, ParseError> Number;
+    typedef result::Result<Config, ParseError> Parsed;
+
+    constexpr Number parse_number(std::string_view text, std::size_t offset) {
+        if (text.empty()) {
+            return Number::error(ParseError(offset, "expected number"));
+        }
+
+        int value = 0;
+        for (std::size_t idx = 0; idx < text.size(); idx++) {
+            if (text[idx] < '0' || text[idx] > '9') {
+                return result::Err(ParseError(offset + idx, "expected digit"));
+            }
+            value = value * 10 + (text[idx] - '0');
+        }
+        return result::Ok(value);
+    }
+
+    //Parses `port,threads`.
+    consteval Parsed parse_config(std::string_view text) {
+        const std::size_t comma = text.find(',');
+        if (comma == std::string_view::npos) {
+            return Parsed::error(ParseError(text.size(), "expected comma"));
+        }
+
+        return parse_number(text.substr(0, comma), 0).and_then([text, comma](int port) {
+            return parse_number(text.substr(comma + 1), comma + 1).map([port](int threads) {
+                return Config{port, threads};
+            });
+        });
+    }
+
+    constexpr Parsed good = parse_config("8080,4");
+    static_assert(good.is_ok());
+    static_assert(good.value()->port == 8080);
+    static_assert(good.value()->threads == 4);
+
+    static_assert(parse_config("8080").unwrap_err().what() == "expected comma");
+    static_assert(parse_config("80x0,4").unwrap_err().pos() == 2);
+    static_assert(parse_config("8080,").unwrap_err().pos() == 5);
+
+    //Move construction and assignment switching variants destroy previous payload.
+    constexpr bool assignment_destroys_error() {
+        bool destroyed = false;
+        {
+            Number number = Number::error(ParseError(0, "first", &destroyed));
+            Number moved(std::move(number));
+            moved = Number::ok(1);
+            if (!destroyed || moved.unwrap() != 1) {
+                return false;
+            }
+        }
+
+        destroyed = false;
+        {
+            Number number = Number::error(ParseError(0, "second", &destroyed));
+        }
+        return destroyed;
+    }
+    static_assert(assignment_destroys_error());
+
+    //Emplace replaces payload in place.
+    constexpr bool emplace_replaces() {
+        Number number = Number::ok(1);
+        if (number.emplace_err(3, "emplaced").pos() != 3 || number.is_ok()) {
+            return false;
+        }
+        return number.emplace_ok(2) == 2 && number.unwrap() == 2;
+    }
+    static_assert(emplace_replaces());
+
+#if defined(__cpp_lib_constexpr_string) && __cpp_lib_constexpr_string >= 201907L
+    //Allocating payload is fine as long as it doesn't outlive constant evaluation.
+    constexpr std::size_t message_len(int value) {
+        typedef result::Result<std::string, std::string> Message;
+
+        return result::Result<int, std::string>::ok(value).and_then([](int num) {
+            if (num < 0) {
+                return Message::error("negative");
+            }
+            return Message::ok(std::string(static_cast<std::size_t>(num), 'x'));
+        }).map([](std::string text) {
+            return text.size();
+        }).unwrap_or(0);
+    }
+    static_assert(message_len(40) == 40);
+    static_assert(message_len(-1) == 0);
+#endif
+}
+#endif
+
+TEST_CASE("Result can be used in constant evaluation", "[constexpr]") {
+    constexpr Halved quarter = half(8).and_then(half);
+    REQUIRE(quarter.unwrap() == 2);
+
+#ifdef RESULT_HAS_CONSTEXPR
+    REQUIRE(good.value()->port == 8080);
+    REQUIRE(assignment_destroys_error());
+#endif
+}
@@ -0,0 +1,230 @@
+#include <catch.hpp>
+
+#include <utility>
+
+#include <result.hpp>
+
+#include "counting.hpp"
+
+//Checks cost of statement, with payload of result, that it produces, still alive.
+#define REQUIRE_COST(meter, value_counts, error_counts) \
+    do { \
+        REQUIRE((meter).value() == (value_counts)); \
+        REQUIRE((meter).error() == (error_counts)); \
+        REQUIRE((meter).allocations() == 0); \
+        (meter).reset(); \
+    } while (false)
+
+using counting::copied;
+using counting::destroyed;
+using counting::made;
+using counting::moved;
+using counting::none;
+
+namespace {
+    typedef result::Result<counting::Value, counting::Error> Res;
+    typedef result::Result<int, counting::Error> IntRes;
+    typedef result::Result<counting::Value, int> ValueRes;
+
+    int value_of(const counting::Value& value) {
+        return value.value;
+    }
+
+    int error_of(const counting::Error& error) {
+        return error.value;
+    }
+}
+
+TEST_CASE("Creation constructs payload in place", "[cost]") {
+#ifdef RESULT_TELEMETRY
+    //Telemetry allocates table of thread on the first error.
+    static_cast<void>(Res::error(0));
+#endif
+    counting::Meter meter;
+
+    const Res ok = Res::ok(1);
+    REQUIRE_COST(meter, made(1), none);
+
+    const Res error = Res::error(2);
+    REQUIRE_COST(meter, none, made(1));
+
+    counting::Value value(3);
+    meter.reset();
+    const Res from_lvalue = Res::ok(value);
+    REQUIRE_COST(meter, copied(1), none);
+    const Res from_rvalue = Res::ok(std::move(value));
+    REQUIRE_COST(meter, moved(1), none);
+
+    const Res from_ok = result::Ok<counting::Value>(counting::Value(4));
+    REQUIRE_COST(meter, made(1) + moved(2) + destroyed(2), none);
+    const Res from_err = result::Err<counting::Error>(counting::Error(5));
+    REQUIRE_COST(meter, none, made(1) + moved(2) + destroyed(2));
+
+    REQUIRE(ok.value()->value + error.error()->value + from_ok.value()->value + from_err.error()->value == 12);
+}
+
+TEST_CASE("Move and copy touch only active payload", "[cost]") {
+    Res ok = Res::ok(1);
+    Res error = Res::error(2);
+    counting::Meter meter;
+
+    Res moved_ok(std::move(ok));
+    REQUIRE_COST(meter, moved(1), none);
+    Res moved_error(std::move(error));
+    REQUIRE_COST(meter, none, moved(1));
+
+    Res copy_ok(moved_ok);
+    REQUIRE_COST(meter, copied(1), none);
+    Res copy_error(moved_error);
+    REQUIRE_COST(meter, none, copied(1));
+
+    //The same variant is assigned, the other one is destroyed and constructed.
+    copy_ok = std::move(moved_ok);
+    REQUIRE_COST(meter, moved(1), none);
+    copy_ok = moved_error;
+    REQUIRE_COST(meter, destroyed(1), copied(1));
+    copy_ok = copy_error;
+    REQUIRE_COST(meter, none, copied(1));
+    copy_ok = std::move(moved_ok);
+    REQUIRE_COST(meter, moved(1), destroyed(1));
+    copy_ok = Res::ok(3);
+    REQUIRE_COST(meter, made(1) + moved(1) + destroyed(1), none);
+}
+
+TEST_CASE("Unwrap moves out only from rvalue", "[cost]") {
+    Res ok = Res::ok(1);
+    Res error = Res::error(2);
+    const Res& const_ok = ok;
+    const Res& const_error = error;
+    counting::Meter meter;
+
+    REQUIRE(ok.unwrap().value == 1);
+    REQUIRE(const_ok.unwrap().value == 1);
+    REQUIRE(error.unwrap_err().value == 2);
+    REQUIRE(const_error.unwrap_err().value == 2);
+    REQUIRE_COST(meter, none, none);
+
+    {
+        const counting::Value value = std::move(ok).unwrap();
+        REQUIRE_COST(meter, moved(1), none);
+        const counting::Error err = std::move(error).unwrap_err();
+        REQUIRE_COST(meter, none, moved(1));
+        REQUIRE(value.value + err.value == 3);
+    }
+    meter.reset();
+
+    {
+        const counting::Value value = const_ok.unwrap_or(counting::Value(0));
+        REQUIRE_COST(meter, made(1) + copied(1) + destroyed(1), none);
+        const counting::Value fallback = const_error.unwrap_or(counting::Value(5));
+        REQUIRE_COST(meter, made(1) + moved(1) + destroyed(1), none);
+        const counting::Value moved_out = std::move(ok).unwrap_or(counting::Value(0));
+        REQUIRE_COST(meter, made(1) + moved(1) + destroyed(1), none);
+        REQUIRE(value.value + fallback.value + moved_out.value == 7);
+    }
+    meter.reset();
+
+    {
+        const counting::Value value = const_ok.unwrap_or_default();
+        REQUIRE_COST(meter, copied(1), none);
+        const counting::Value fallback = const_error.unwrap_or_default();
+        REQUIRE_COST(meter, made(1), none);
+        const counting::Value moved_out = std::move(ok).unwrap_or_default();
+        REQUIRE_COST(meter, moved(1), none);
+        REQUIRE(value.value + fallback.value + moved_out.value == 2);
+    }
+}
+
+TEST_CASE("map and map_err pass other payload by receiver category", "[cost]") {
+    Res ok = Res::ok(1);
+    Res error = Res::error(2);
+    const Res& const_ok = ok;
+    const Res& const_error = error;
+    counting::Meter meter;
+
+    //Mapped payload is only borrowed, while passed through one is copied from lvalue and moved from rvalue.
+    const IntRes mapped = ok.map(value_of);
+    const IntRes const_mapped = const_ok.map(value_of);
+    REQUIRE_COST(meter, none, none);
+    const IntRes passed = error.map(value_of);
+    REQUIRE_COST(meter, none, copied(1));
+    const IntRes const_passed = const_error.map(value_of);
+    REQUIRE_COST(meter, none, copied(1));
+
+    const ValueRes mapped_err = error.map_err(error_of);
+    const ValueRes const_mapped_err = const_error.map_err(error_of);
+    REQUIRE_COST(meter, none, none);
+    const ValueRes passed_err = ok.map_err(error_of);
+    REQUIRE_COST(meter, copied(1), none);
+    const ValueRes const_passed_err = const_ok.map_err(error_of);
+    REQUIRE_COST(meter, copied(1), none);
+
+    const auto consume_value = [](counting::Value&& value) {
+        return counting::Value(std::move(value));
+    };
+    const auto consume_error = [](counting::Error&& error) {
+        return counting::Error(std::move(error));
+    };
+    const Res rvalue_mapped = Res(ok).map(consume_value);
+    REQUIRE_COST(meter, copied(1) + moved(1) + destroyed(1), none);
+    const Res rvalue_passed = Res(error).map(consume_value);
+    REQUIRE_COST(meter, none, copied(1) + moved(1) + destroyed(1));
+    const Res rvalue_mapped_err = Res(error).map_err(consume_error);
+    REQUIRE_COST(meter, none, copied(1) + moved(1) + destroyed(1));
+    const Res rvalue_passed_err = Res(ok).map_err(consume_error);
+    REQUIRE_COST(meter, copied(1) + moved(1) + destroyed(1), none);
+
+    REQUIRE(mapped.unwrap() + const_mapped.unwrap() + passed.unwrap_err().value + const_passed.unwrap_err().value == 6);
+    REQUIRE(mapped_err.unwrap_err() + const_mapped_err.unwrap_err() + passed_err.unwrap().value + const_passed_err.unwrap().value == 6);
+    REQUIRE(rvalue_mapped.unwrap().value + rvalue_passed.unwrap_err().value + rvalue_mapped_err.unwrap_err().value + rvalue_passed_err.unwrap().value == 6);
+}
+
+TEST_CASE("and_then and or_else pass other payload by receiver category", "[cost]") {
+    Res ok = Res::ok(1);
+    Res error = Res::error(2);
+    const Res& const_ok = ok;
+    const Res& const_error = error;
+    counting::Meter meter;
+
+    const auto next = [](const counting::Value& value) {
+        return IntRes::ok(value.value);
+    };
+    const auto recover = [](const counting::Error& error) {
+        return ValueRes::ok(error.value);
+    };
+
+    const IntRes chained = ok.and_then(next);
+    const IntRes const_chained = const_ok.and_then(next);
+    REQUIRE_COST(meter, none, none);
+    const IntRes passed = error.and_then(next);
+    REQUIRE_COST(meter, none, copied(1));
+    const IntRes const_passed = const_error.and_then(next);
+    REQUIRE_COST(meter, none, copied(1));
+
+    const ValueRes recovered = error.or_else(recover);
+    const ValueRes const_recovered = const_error.or_else(recover);
+    REQUIRE_COST(meter, made(2), none);
+    const ValueRes kept = ok.or_else(recover);
+    REQUIRE_COST(meter, copied(1), none);
+    const ValueRes const_kept = const_ok.or_else(recover);
+    REQUIRE_COST(meter, copied(1), none);
+
+    const auto consume_value = [](counting::Value&& value) {
+        return Res::ok(std::move(value));
+    };
+    const auto consume_error = [](counting::Error&& error) {
+        return Res::error(std::move(error));
+    };
+    const Res rvalue_chained = Res(ok).and_then(consume_value);
+    REQUIRE_COST(meter, copied(1) + moved(1) + destroyed(1), none);
+    const Res rvalue_passed = Res(error).and_then(consume_value);
+    REQUIRE_COST(meter, none, copied(1) + moved(1) + destroyed(1));
+    const Res rvalue_recovered = Res(error).or_else(consume_error);
+    REQUIRE_COST(meter, none, copied(1) + moved(1) + destroyed(1));
+    const Res rvalue_kept = Res(ok).or_else(consume_error);
+    REQUIRE_COST(meter, copied(1) + moved(1) + destroyed(1), none);
+
+    REQUIRE(chained.unwrap() + const_chained.unwrap() + passed.unwrap_err().value + const_passed.unwrap_err().value == 6);
+    REQUIRE(recovered.unwrap().value + const_recovered.unwrap().value + kept.unwrap().value + const_kept.unwrap().value == 6);
+    REQUIRE(rvalue_chained.unwrap().value + rvalue_passed.unwrap_err().value + rvalue_recovered.unwrap_err().value + rvalue_kept.unwrap().value == 6);
+}
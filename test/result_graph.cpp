@@ -0,0 +1,255 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+    //Idle worker events, observed through RESULT_GRAPH_TRACE.
+    std::atomic<int> parked{0};
+    std::atomic<int> woken{0};
+    //Delay after worker finds run not finished, which widens window for lost wakeup.
+    std::atomic<int> checked_delay_ms{0};
+
+    void graph_trace(std::string_view event) {
+        if (event == "parked") {
+            parked++;
+        } else if (event == "woken") {
+            woken++;
+        } else if (event == "checked" && checked_delay_ms.load() != 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(checked_delay_ms.load()));
+        }
+    }
+}
+
+#define RESULT_GRAPH_TRACE(event) graph_trace(event)
+#include <result_graph.hpp>
+
+namespace {
+    typedef result::Result<std::string, std::string> Text;
+    typedef result::Result<int, std::string> Number;
+
+    Number parse(std::string&& text) {
+        if (text.empty() || text[0] < '0' || text[0] > '9') {
+            return Number::error("not a number: " + text);
+        }
+        return Number::ok(std::stoi(text));
+    }
+}
+
+TEST_CASE("TaskGraph passes payloads along edges", "[graph]") {
+    for (unsigned threads : {1u, 4u}) {
+        result::TaskGraph<std::string> graph;
+
+        auto fetch = graph.add("fetch", [] {
+            return Text::ok("42");
+        });
+        auto number = graph.add("parse", parse, fetch);
+        auto other = graph.add("other", [] {
+            return Number::ok(8);
+        });
+        auto sum = graph.add("sum", [](int left, int right) {
+            return Number::ok(left + right);
+        }, number, other);
+        auto check = graph.add("check", [](int value) {
+            return value > 0 ? result::Result<void, std::string>::ok() : result::Result<void, std::string>::error("negative");
+        }, sum);
+        auto report = graph.add("report", [](std::string&& label) {
+            return Text::ok(label + " checked");
+        }, graph.add("label", [] {
+            return Text::ok("sum");
+        }), check);
+
+        graph.run(result::par.with_threads(threads));
+
+        REQUIRE(graph.size() == 7);
+        REQUIRE(graph.result(sum).unwrap() == 50);
+        REQUIRE(graph.take(report).unwrap() == "sum checked");
+    }
+}
+
+TEST_CASE("TaskGraph moves payload to single dependent and copies it to many", "[graph]") {
+    result::TaskGraph<std::string> graph;
+
+    auto source = graph.add("source", [] {
+        return result::Result<std::unique_ptr<int>, std::string>::ok(std::make_unique<int>(5));
+    });
+    auto owner = graph.add("owner", [](std::unique_ptr<int>&& value) {
+        return Number::ok(*value);
+    }, source);
+
+    auto shared = graph.add("shared", [] {
+        return Text::ok("shared");
+    });
+    auto first = graph.add("first", [](std::string&& text) {
+        return Text::ok(std::move(text) + "/first");
+    }, shared);
+    auto second = graph.add("second", [](std::string&& text) {
+        return Text::ok(std::move(text) + "/second");
+    }, shared);
+
+    //Move only payload cannot be shared.
+    REQUIRE_THROWS_AS(graph.add("again", [](std::unique_ptr<int>&&) {
+        return Number::ok(0);
+    }, source), std::logic_error);
+
+    graph.run(result::par.with_threads(2));
+
+    REQUIRE(graph.result(owner).unwrap() == 5);
+    REQUIRE(graph.result(first).unwrap() == "shared/first");
+    REQUIRE(graph.result(second).unwrap() == "shared/second");
+    REQUIRE(graph.result(shared).unwrap() == "shared");
+}
+
+TEST_CASE("TaskGraph skips subtree of Err", "[graph]") {
+    for (unsigned threads : {1u, 3u}) {
+        result::TaskGraph<std::string> graph;
+        std::atomic<int> started(0);
+
+        auto bad = graph.add("fetch", [&started] {
+            started++;
+            return Text::ok("garbage");
+        });
+        auto parsed = graph.add("parse", parse, bad);
+        auto doubled = graph.add("double", [&started](int value) {
+            started++;
+            return Number::ok(value * 2);
+        }, parsed);
+        auto good = graph.add("good", [&started] {
+            started++;
+            return Number::ok(1);
+        });
+        auto joined = graph.add("join", [&started](int left, int right) {
+            started++;
+            return Number::ok(left + right);
+        }, doubled, good);
+        auto independent = graph.add("independent", [&started](int value) {
+            started++;
+            return Number::ok(value + 1);
+        }, good);
+
+        graph.run(result::par.with_threads(threads));
+
+        REQUIRE(graph.result(joined).unwrap_err() == "not a number: garbage");
+        REQUIRE(graph.result(doubled).is_err());
+        REQUIRE(graph.result(independent).unwrap() == 2);
+        //Neither double nor join were started.
+        REQUIRE(started == 3);
+
+        const std::vector<result::node_timing> timings = graph.timings();
+        REQUIRE(timings.size() == 6);
+        REQUIRE(std::string(timings[1].name) == "parse");
+        REQUIRE(timings[1].status == result::node_status::failed);
+        REQUIRE(timings[2].status == result::node_status::skipped);
+        REQUIRE(timings[2].duration.count() == 0);
+        REQUIRE(timings[4].status == result::node_status::skipped);
+        REQUIRE(timings[5].status == result::node_status::ok);
+        for (const result::node_timing& timing : timings) {
+            REQUIRE(timing.thread < threads);
+        }
+    }
+}
+
+TEST_CASE("TaskGraph reports the first error per sink", "[graph]") {
+    result::TaskGraph<std::string> graph;
+
+    auto slow = graph.add("slow", [] {
+        return Number::ok(1);
+    });
+    auto first = graph.add("first", [] {
+        return Number::error("first");
+    });
+    auto later = graph.add("later", [](int value) {
+        return Number::ok(value);
+    }, slow);
+    auto second = graph.add("second", [](int) {
+        return Number::error("second");
+    }, later);
+    auto sink = graph.add("sink", [](int left, int right) {
+        return Number::ok(left + right);
+    }, first, second);
+    auto other_sink = graph.add("other", [](int value) {
+        return Number::ok(value);
+    }, second);
+
+    graph.run(result::par.with_threads(1));
+
+    //Single worker takes the newest task of its queue, so `first` fails before `slow` even starts.
+    REQUIRE(graph.result(sink).unwrap_err() == "first");
+    REQUIRE(graph.result(other_sink).unwrap_err() == "second");
+}
+
+TEST_CASE("TaskGraph rethrows exception of task", "[graph]") {
+    result::TaskGraph<std::string> graph;
+
+    auto thrower = graph.add("thrower", []() -> Number {
+        throw std::runtime_error("boom");
+    });
+    auto after = graph.add("after", [](int value) {
+        return Number::ok(value);
+    }, thrower);
+
+    REQUIRE_THROWS_AS(graph.run(), std::runtime_error);
+    REQUIRE(graph.timings()[1].status == result::node_status::pending);
+    REQUIRE_THROWS_AS(graph.result(after), std::logic_error);
+    REQUIRE_THROWS_AS(graph.run(), std::logic_error);
+}
+
+TEST_CASE("TaskGraph workers sleep while nothing is ready", "[graph]") {
+    parked = 0;
+    woken = 0;
+
+    //Slow task waits until other seven workers are asleep, which spinning workers never are.
+    bool all_parked = false;
+    result::TaskGraph<std::string> graph;
+    auto slow = graph.add("slow", [&all_parked] {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (parked.load() - woken.load() < 7 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        all_parked = parked.load() - woken.load() == 7;
+        return Number::ok(1);
+    });
+    for (int idx = 0; idx < 7; idx++) {
+        graph.add("dependent", [](int value) {
+            return Number::ok(value);
+        }, slow);
+    }
+
+    graph.run(result::par.with_threads(8));
+    REQUIRE(all_parked);
+    REQUIRE(parked.load() == woken.load());
+    REQUIRE(graph.result(slow).unwrap() == 1);
+}
+
+TEST_CASE("TaskGraph wakes worker when run ends before it parks", "[graph]") {
+    //Worker that found run not finished parks only after the other one completed the last node.
+    checked_delay_ms = 5;
+    for (int round = 0; round < 5; round++) {
+        result::TaskGraph<std::string> graph;
+        auto first = graph.add("first", [] {
+            return Number::ok(1);
+        });
+        auto second = graph.add("second", [] {
+            return Number::ok(2);
+        });
+        graph.run(result::par.with_threads(2));
+        REQUIRE(graph.result(first).unwrap() == 1);
+        REQUIRE(graph.result(second).unwrap() == 2);
+
+        result::TaskGraph<std::string> failing;
+        failing.add("thrower", []() -> Number {
+            throw std::runtime_error("boom");
+        });
+        failing.add("other", [] {
+            return Number::ok(2);
+        });
+        REQUIRE_THROWS_AS(failing.run(result::par.with_threads(2)), std::runtime_error);
+    }
+    checked_delay_ms = 0;
+}
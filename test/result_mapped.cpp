@@ -0,0 +1,151 @@
+#include <catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include <result_mapped.hpp>
+
+namespace {
+    struct Sample {
+        std::uint32_t sensor;
+        double reading;
+    };
+
+    struct Fault {
+        std::uint16_t code;
+    };
+
+    typedef result::Result<Sample, Fault> Res;
+    typedef result::ResultRecord<Sample, Fault> Record;
+}
+
+TEST_CASE("ResultRecord has defined layout", "[mapped]") {
+    static_assert(Record::payload_offset == alignof(double));
+    static_assert(offsetof(Record, payload) == Record::payload_offset);
+    static_assert(sizeof(Record) == 24);
+    static_assert(sizeof(result::ResultRecord<void, std::uint8_t>) == 2);
+
+    Record record;
+    std::memset(&record, 0, sizeof(record));
+    REQUIRE_FALSE(record.is_ok());
+    REQUIRE_FALSE(record.is_err());
+
+    record.assign(Res::ok(Sample{7, 1.5}));
+    REQUIRE(reinterpret_cast<const unsigned char*>(&record)[0] == Record::ok_tag);
+    REQUIRE(record.value()->sensor == 7);
+    REQUIRE(record.error() == nullptr);
+    REQUIRE(record.to_result().unwrap().reading == 1.5);
+
+    record.assign(Res::error(Fault{3}));
+    REQUIRE(record.is_err());
+    REQUIRE(record.value() == nullptr);
+    REQUIRE(record.to_result().unwrap_err().code == 3);
+
+    result::ResultRecord<void, std::uint8_t> unit;
+    unit.assign(result::Result<void, std::uint8_t>::ok());
+    REQUIRE(unit.to_result().is_ok());
+}
+
+#ifdef RESULT_HAS_MAPPED_FILE
+namespace {
+    //File in temporary directory, that is removed at the end of test.
+    struct TempFile {
+        std::string path;
+
+        explicit TempFile(const char* name) : path(std::string(P_tmpdir) + "/result_mapped_" + std::to_string(::getpid()) + "_" + name) {}
+
+        ~TempFile() {
+            std::remove(path.c_str());
+        }
+    };
+}
+
+TEST_CASE("MappedResultArray reads records written by other mapping", "[mapped]") {
+    TempFile file("array");
+    auto array = result::MappedResultArray<Sample, Fault>::create(file.path.c_str(), 4).unwrap();
+    REQUIRE(array.capacity() == 4);
+    REQUIRE(array.empty());
+
+    auto reader = result::MappedResultArray<Sample, Fault>::open(file.path.c_str()).unwrap();
+    REQUIRE(reader.size() == 0);
+    REQUIRE_FALSE(reader.push(Res::ok(Sample{0, 0.0})));
+    REQUIRE(reader.size() == 0);
+
+    REQUIRE(array.push(Res::ok(Sample{1, 0.5})));
+    REQUIRE(array.push(Res::error(Fault{2})));
+    REQUIRE(reader.size() == 2);
+    REQUIRE(reader[0].value()->reading == 0.5);
+    REQUIRE(reader[1].error()->code == 2);
+
+    REQUIRE(array.push(Res::ok(Sample{3, 1.0})));
+    REQUIRE(array.push(Res::ok(Sample{4, 2.0})));
+    REQUIRE_FALSE(array.push(Res::ok(Sample{5, 3.0})));
+    REQUIRE(array.flush().is_ok());
+
+    std::uint32_t sensors = 0;
+    for (const Record& record : reader) {
+        if (const Sample* sample = record.value()) {
+            sensors += sample->sensor;
+        }
+    }
+    REQUIRE(sensors == 8);
+}
+
+TEST_CASE("MappedResultWriter grows and truncates file", "[mapped]") {
+    TempFile file("writer");
+    {
+        auto writer = result::MappedResultWriter<std::uint64_t, Fault>::create(file.path.c_str(), 16).unwrap();
+        auto reader = result::MappedResultArray<std::uint64_t, Fault>::open(file.path.c_str()).unwrap();
+
+        for (std::uint64_t idx = 0; idx < 100; idx++) {
+            if (idx % 10 == 9) {
+                REQUIRE(writer.push(result::Result<std::uint64_t, Fault>::error(Fault{static_cast<std::uint16_t>(idx)})).is_ok());
+            } else {
+                REQUIRE(writer.push(result::Result<std::uint64_t, Fault>::ok(idx)).is_ok());
+            }
+        }
+        REQUIRE(writer.size() == 100);
+        REQUIRE(writer.records().capacity() >= 100);
+
+        //Reader still maps initial length until refreshed.
+        REQUIRE(reader.capacity() == 16);
+        REQUIRE(reader.end() - reader.begin() == 16);
+        REQUIRE(reader.refresh().is_ok());
+        REQUIRE(reader.end() - reader.begin() == 100);
+
+        REQUIRE(writer.finish().is_ok());
+        REQUIRE(writer.records().capacity() == 100);
+    }
+
+    auto appender = result::MappedResultWriter<std::uint64_t, Fault>::append(file.path.c_str(), 16).unwrap();
+    REQUIRE(appender.push(result::Result<std::uint64_t, Fault>::ok(100)).is_ok());
+    REQUIRE(appender.finish().is_ok());
+
+    auto replay = result::MappedResultArray<std::uint64_t, Fault>::open(file.path.c_str()).unwrap();
+    REQUIRE(replay.size() == 101);
+    REQUIRE(*replay[8].value() == 8);
+    REQUIRE(replay[9].error()->code == 9);
+    REQUIRE(replay[100].to_result().unwrap() == 100);
+}
+
+TEST_CASE("MappedResultArray rejects incompatible file", "[mapped]") {
+    TempFile file("incompatible");
+    REQUIRE(result::MappedResultArray<Sample, Fault>::create(file.path.c_str(), 1).is_ok());
+
+    auto other = result::MappedResultArray<std::uint64_t, Fault>::open(file.path.c_str());
+    REQUIRE(other.unwrap_err() == result::mapped_errc::layout_mismatch);
+
+    TempFile text("text");
+    std::FILE* handle = std::fopen(text.path.c_str(), "wb");
+    const char garbage[128] = "definitely not an array of Results";
+    std::fwrite(garbage, 1, sizeof(garbage), handle);
+    std::fclose(handle);
+    REQUIRE(result::MappedResultArray<Sample, Fault>::open(text.path.c_str()).unwrap_err() == result::mapped_errc::bad_magic);
+
+    TempFile missing("missing");
+    REQUIRE(result::MappedResultArray<Sample, Fault>::open(missing.path.c_str()).unwrap_err() == std::errc::no_such_file_or_directory);
+}
+#endif
@@ -0,0 +1,125 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <result_parallel.hpp>
+
+#if defined(__cpp_lib_ranges)
+#include <span>
+#endif
+
+typedef result::Result<int, std::size_t> Checked;
+
+TEST_CASE("try par_try_transform") {
+    std::vector<int> numbers(10000);
+    for (std::size_t idx = 0; idx < numbers.size(); idx++) {
+        numbers[idx] = static_cast<int>(idx);
+    }
+
+    const auto policy = result::par.with_threads(4).with_grain(64);
+
+    auto doubled = result::par_try_transform(policy, numbers, [](int num) {
+        return Checked::ok(num * 2);
+    });
+    REQUIRE(doubled.is_ok());
+    REQUIRE(doubled.unwrap().size() == numbers.size());
+    for (std::size_t idx = 0; idx < numbers.size(); idx++) {
+        REQUIRE(doubled.unwrap()[idx] == static_cast<int>(idx) * 2);
+    }
+
+    auto empty = result::par_try_transform(policy, std::vector<int>(), [](int num) {
+        return Checked::ok(num);
+    });
+    REQUIRE(empty.unwrap().empty());
+}
+
+TEST_CASE("try par_try_transform lowest error") {
+    std::vector<int> numbers(10000, 0);
+    numbers[7000] = 1;
+    numbers[5000] = 1;
+    numbers[9999] = 1;
+
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        std::atomic<std::size_t> calls(0);
+
+        auto failed = result::par_try_transform(result::par.with_threads(threads).with_grain(16), numbers, [&](const int& num) {
+            calls.fetch_add(1);
+            return num == 0 ? Checked::ok(num) : Checked::error(static_cast<std::size_t>(&num - numbers.data()));
+        });
+
+        REQUIRE(failed.is_err());
+        REQUIRE(failed.unwrap_err() == 5000);
+        REQUIRE(calls.load() < numbers.size());
+    }
+}
+
+TEST_CASE("try par_try_transform of results") {
+    std::vector<Checked> checked;
+    for (int idx = 0; idx < 100; idx++) {
+        checked.push_back(Checked::ok(idx));
+    }
+
+    auto strings = result::par_try_transform(result::par.with_grain(8), checked, [](int num) {
+        return std::to_string(num);
+    });
+    REQUIRE(strings.unwrap()[42] == "42");
+
+    checked[50] = Checked::error(50);
+    checked[10] = Checked::error(10);
+    auto failed = result::par_try_transform(result::par.with_grain(8), std::move(checked), [](int num) {
+        return std::to_string(num);
+    });
+    REQUIRE(failed.unwrap_err() == 10);
+}
+
+TEST_CASE("try par_try_transform exception") {
+    const std::vector<int> numbers(1000, 1);
+
+    REQUIRE_THROWS_AS(result::par_try_transform(result::par.with_threads(4).with_grain(8), numbers, [](int num) -> Checked {
+        throw std::runtime_error("fail");
+        return Checked::ok(num);
+    }), std::runtime_error);
+
+    //Err or exception of the lower index wins, as if elements were processed in order.
+    std::vector<int> marked(1000, 0);
+    for (unsigned threads : {1u, 2u, 4u, 8u}) {
+        const auto policy = result::par.with_threads(threads).with_grain(8);
+        const auto check = [&marked](const int& num) {
+            if (num == 2) {
+                throw std::runtime_error("fail");
+            }
+            return num == 0 ? Checked::ok(num) : Checked::error(static_cast<std::size_t>(&num - marked.data()));
+        };
+
+        marked[300] = 1;
+        marked[600] = 2;
+        REQUIRE(result::par_try_transform(policy, marked, check).unwrap_err() == 300);
+
+        marked[300] = 2;
+        marked[600] = 1;
+        REQUIRE_THROWS_AS(result::par_try_transform(policy, marked, check), std::runtime_error);
+
+        marked[300] = 0;
+        marked[600] = 0;
+    }
+}
+
+#if defined(__cpp_lib_ranges)
+TEST_CASE("try par_try_transform of span") {
+    typedef result::Result<std::string, std::size_t> Text;
+    const std::string long_text(64, 'x');
+    std::vector<Text> texts(100, Text::ok(long_text));
+
+    auto copied = result::par_try_transform(result::par.with_grain(8), std::span(texts), [](const std::string& text) {
+        return text.size();
+    });
+    REQUIRE(copied.unwrap().size() == texts.size());
+    for (const Text& text : texts) {
+        REQUIRE(*text.value() == long_text);
+    }
+}
+#endif
@@ -0,0 +1,174 @@
+#include <catch.hpp>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <result_pipe.hpp>
+#include <result_trace.hpp>
+
+using namespace result::pipe;
+
+namespace {
+    typedef result::Result<int, std::string> Res;
+
+    Res parse(std::string&& text) {
+        if (text.empty() || text[0] < '0' || text[0] > '9') {
+            return Res::error("not a number: " + text);
+        }
+        return Res::ok(std::stoi(text));
+    }
+
+    Res positive(int value) {
+        if (value <= 0) {
+            return Res::error("not positive");
+        }
+        return Res::ok(value);
+    }
+
+    constexpr int constexpr_pipe(bool fail) {
+        using Small = result::Result<int, int>;
+        Small source = fail ? Small::error(1) : Small::ok(1);
+        Small out = std::move(source) | map([](int value) {
+            return value + 1;
+        }) | map_err([](int error) {
+            return error * 10;
+        });
+        return out.is_ok() ? *out.value() : -*out.error();
+    }
+}
+
+TEST_CASE("Pipe matches member chain", "[pipe]") {
+    const auto twice = [](int value) {
+        return value * 2;
+    };
+    const auto describe = [](int value) {
+        return std::to_string(value);
+    };
+    const auto wrap = [](std::string&& error) {
+        return "bad input: " + error;
+    };
+
+    for (const char* input : {"21", "-3", "x"}) {
+        const auto eager = result::Result<std::string, std::string>::ok(input).and_then(parse).map(twice).and_then(positive).map(describe).map_err(wrap);
+
+        auto lazy = result::Result<std::string, std::string>::ok(input) | and_then(parse) | map(twice) | and_then(positive) | map(describe) | map_err(wrap);
+        static_assert(std::is_same<decltype(lazy)::result_type, result::Result<std::string, std::string>>::value);
+
+        const result::Result<std::string, std::string> fused = std::move(lazy);
+        REQUIRE(fused.is_ok() == eager.is_ok());
+        if (eager.is_ok()) {
+            REQUIRE(*fused.value() == *eager.value());
+        } else {
+            REQUIRE(*fused.error() == *eager.error());
+        }
+    }
+
+    static_assert(constexpr_pipe(false) == 2);
+    static_assert(constexpr_pipe(true) == -10);
+}
+
+TEST_CASE("Pipe evaluates lazily", "[pipe]") {
+    int calls = 0;
+    auto pipe = Res::ok(1) | map([&calls](int value) {
+        calls++;
+        return value + 1;
+    });
+    auto longer = std::move(pipe) | map([&calls](int value) {
+        calls++;
+        return value * 3;
+    });
+    REQUIRE(calls == 0);
+
+    REQUIRE(std::move(longer).eval().unwrap() == 6);
+    REQUIRE(calls == 2);
+
+    //Nothing but map_err and or_else is called once Err occurs.
+    Res failed = Res::error("lolka") | map([&calls](int value) {
+        calls++;
+        return value;
+    }) | and_then([&calls](int value) {
+        calls++;
+        return Res::ok(value);
+    });
+    REQUIRE(calls == 2);
+    REQUIRE(failed.unwrap_err() == "lolka");
+}
+
+TEST_CASE("Pipe recovers with or_else", "[pipe]") {
+    const auto recover = [](std::string&& error) {
+        return error == "not positive" ? Res::ok(0) : Res::error(std::move(error));
+    };
+
+    Res recovered = Res::ok(-1) | and_then(positive) | or_else(recover) | map([](int value) {
+        return value + 1;
+    });
+    REQUIRE(recovered.unwrap() == 1);
+
+    Res kept = Res::error("other") | or_else(recover) | map([](int value) {
+        return value + 1;
+    });
+    REQUIRE(kept.unwrap_err() == "other");
+
+    result::Result<int, std::size_t> mapped = Res::error("four") | map_err([](std::string&& error) {
+        return error.size();
+    });
+    REQUIRE(mapped.unwrap_err() == 4);
+}
+
+TEST_CASE("Pipeline is reusable and joinable", "[pipe]") {
+    const auto normalize = and_then(positive) | map([](int value) {
+        return value * 10;
+    });
+    const auto report = normalize | map([](int value) {
+        return std::to_string(value);
+    });
+
+    const Res source = Res::ok(4);
+    Res first = source | normalize;
+    Res second = source | normalize;
+    result::Result<std::string, std::string> text = Res::ok(5) | report;
+
+    REQUIRE(first.unwrap() == 40);
+    REQUIRE(second.unwrap() == 40);
+    REQUIRE(source.unwrap() == 4);
+    REQUIRE(text.unwrap() == "50");
+}
+
+TEST_CASE("Pipe moves payload along without copies", "[pipe]") {
+    typedef result::Result<std::unique_ptr<int>, std::string> Owned;
+
+    Owned owned = Owned::ok(std::make_unique<int>(1)) | map([](std::unique_ptr<int>&& value) {
+        (*value)++;
+        return std::move(value);
+    }) | and_then([](std::unique_ptr<int>&& value) {
+        return Owned::ok(std::move(value));
+    });
+    REQUIRE(*owned.unwrap() == 2);
+
+    result::Result<void, std::string> done = Res::ok(1) | map([](int) {});
+    REQUIRE(done.is_ok());
+
+    bool called = false;
+    result::Result<int, std::string> from_void = std::move(done) | map([&called] {
+        called = true;
+        return 3;
+    });
+    REQUIRE(called);
+    REQUIRE(from_void.unwrap() == 3);
+}
+
+TEST_CASE("Pipe traces Err through and_then like member chain", "[pipe]") {
+    typedef result::Result<int, result::Traced<int>> Traced;
+
+    const unsigned line = __LINE__ + 1;
+    Traced failed = Traced::error(1) | map([](int value) {
+        return value;
+    }) | and_then([](int value) {
+        return Traced::ok(value);
+    });
+
+    const auto trail = failed.error()->trail();
+    REQUIRE(trail.size() == 1);
+    REQUIRE(trail[0].location.line() == line + 2);
+}
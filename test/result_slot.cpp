@@ -0,0 +1,206 @@
+#include <catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <result_slot.hpp>
+
+namespace {
+    typedef result::Result<int, std::string> Res;
+    typedef result::ResultSlot<int, std::string> Slot;
+
+    Res parse(int value) {
+        if (value < 0) {
+            return Res::error("negative");
+        }
+        return Res::ok(value);
+    }
+
+    //Callback, which takes its time to be destroyed.
+    struct SlowToDestroy {
+        std::atomic<bool>* destroyed;
+
+        explicit SlowToDestroy(std::atomic<bool>& destroyed) noexcept : destroyed(&destroyed) {}
+        SlowToDestroy(SlowToDestroy&& right) noexcept : destroyed(right.destroyed) {
+            right.destroyed = nullptr;
+        }
+        ~SlowToDestroy() {
+            if (destroyed != nullptr) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                destroyed->store(true);
+            }
+        }
+
+        Res operator()(int value) const {
+            return Res::ok(value);
+        }
+    };
+}
+
+TEST_CASE("ResultSlot occupies whole cache lines", "[slot]") {
+    static_assert(alignof(Slot) == 64);
+    static_assert(sizeof(Slot) % 64 == 0);
+
+    std::vector<Slot> slots(2);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(&slots[1]) - reinterpret_cast<std::uintptr_t>(&slots[0]) >= 64);
+}
+
+TEST_CASE("ResultSlot publishes on the same thread", "[slot]") {
+    Slot slot;
+    REQUIRE_FALSE(slot.is_ready());
+
+    slot.emplace_ok(1);
+    REQUIRE(slot.is_ready());
+    REQUIRE(slot.get().unwrap() == 1);
+    REQUIRE(slot.take().unwrap() == 1);
+
+    slot.reset();
+    REQUIRE_FALSE(slot.is_ready());
+    slot.emplace_err("lolka");
+    REQUIRE(slot.take().unwrap_err() == "lolka");
+
+    slot.reset();
+    slot.set(parse(-1));
+    REQUIRE(slot.get().is_err());
+
+    result::ResultSlot<void, int> no_value;
+    no_value.emplace_ok();
+    REQUIRE(no_value.take().is_ok());
+}
+
+TEST_CASE("ResultSlot hands Result across threads", "[slot]") {
+    result::ResultSlotPool<std::string, int> pool;
+    std::vector<result::ResultSlot<std::string, int>*> slots;
+    std::vector<std::thread> workers;
+
+    for (int idx = 0; idx < 8; idx++) {
+        auto& slot = pool.acquire();
+        slots.push_back(&slot);
+        workers.emplace_back([&slot, idx] {
+            if (idx % 2 == 0) {
+                slot.emplace_ok(std::to_string(idx));
+            } else {
+                slot.emplace_err(idx);
+            }
+        });
+    }
+
+    for (int idx = 0; idx < 8; idx++) {
+        auto res = slots[static_cast<std::size_t>(idx)]->take();
+        if (idx % 2 == 0) {
+            REQUIRE(res.unwrap() == std::to_string(idx));
+        } else {
+            REQUIRE(res.unwrap_err() == idx);
+        }
+    }
+
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    for (auto* slot : slots) {
+        pool.release(*slot);
+    }
+}
+
+TEST_CASE("ResultSlot chains continuation like and_then", "[slot]") {
+    const auto twice = [](int value) {
+        return Res::ok(value * 2);
+    };
+
+    //Registered before publishing, so it runs on producer.
+    Slot first;
+    Slot second;
+    Slot third;
+    first.then(second, twice).then(third, [](int value) {
+        return parse(value - 10);
+    });
+    std::thread producer([&first] {
+        first.emplace_ok(4);
+    });
+    REQUIRE(third.take().unwrap_err() == "negative");
+    producer.join();
+
+    //Registered after publishing, so it runs immediately.
+    Slot ready;
+    Slot chained;
+    ready.emplace_ok(3);
+    ready.then(chained, twice);
+    REQUIRE(chained.is_ready());
+    REQUIRE(chained.take().unwrap() == 6);
+
+    //Error is propagated without calling continuation.
+    Slot failed;
+    Slot skipped;
+    bool called = false;
+    failed.then(skipped, [&called](int value) {
+        called = true;
+        return Res::ok(value);
+    });
+    failed.emplace_err("lolka");
+    REQUIRE(skipped.take().unwrap_err() == "lolka");
+    REQUIRE_FALSE(called);
+}
+
+TEST_CASE("ResultSlot destroys continuation that never ran", "[slot]") {
+    auto counter = std::make_shared<int>(0);
+    {
+        Slot slot;
+        Slot next;
+        slot.then(next, [counter](int value) {
+            return Res::ok(value + *counter);
+        });
+        REQUIRE(counter.use_count() == 2);
+    }
+    REQUIRE(counter.use_count() == 1);
+}
+
+TEST_CASE("ResultSlot destroys continuation before publishing its outcome", "[slot]") {
+    //Consumer of next slot may free the first one as soon as outcome is published.
+    std::atomic<bool> destroyed{false};
+    auto first = std::make_unique<Slot>();
+    Slot next;
+    first->then(next, SlowToDestroy(destroyed));
+    std::thread producer([&first] {
+        first->emplace_ok(5);
+    });
+
+    next.wait();
+    const bool destroyed_before = destroyed.load();
+    producer.join();
+    REQUIRE(destroyed_before);
+    first.reset();
+    REQUIRE(next.take().unwrap() == 5);
+}
+
+TEST_CASE("ResultSlotPool recycles slots", "[slot]") {
+    result::ResultSlotPool<int, std::string> pool(1);
+    REQUIRE(pool.capacity() == result::ResultSlotPool<int, std::string>::chunk_size);
+    const std::size_t available = pool.available();
+
+    auto& slot = pool.acquire();
+    REQUIRE(pool.available() == available - 1);
+    slot.emplace_ok(1);
+    REQUIRE(slot.take().unwrap() == 1);
+    pool.release(slot);
+    REQUIRE(pool.available() == available);
+
+    auto& again = pool.acquire();
+    REQUIRE(&again == &slot);
+    REQUIRE_FALSE(again.is_ready());
+    pool.release(again);
+
+    //Exhausted pool grows by chunk.
+    std::vector<result::ResultSlot<int, std::string>*> taken;
+    for (std::size_t idx = 0; idx <= available; idx++) {
+        taken.push_back(&pool.acquire());
+    }
+    REQUIRE(pool.capacity() == 2 * result::ResultSlotPool<int, std::string>::chunk_size);
+    for (auto* each : taken) {
+        pool.release(*each);
+    }
+}
@@ -0,0 +1,134 @@
+#include <catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+#include <result_trace.hpp>
+
+namespace {
+    struct ParseError {
+        int pos;
+    };
+
+    typedef result::Traced<ParseError, 2> Error;
+    typedef result::Result<int, Error> Parsed;
+
+    const unsigned parse_line = __LINE__ + 3;
+    Parsed parse(int value) {
+        if (value < 0) {
+            return result::Err(ParseError{value});
+        }
+        return result::Ok(value);
+    }
+
+    bool in_this_file(const result::source_location& location) {
+        return std::strstr(location.file(), "result_trace.cpp") != nullptr;
+    }
+
+    //Restores sampling after test.
+    struct Sampling {
+        std::uint32_t previous;
+
+        explicit Sampling(std::uint32_t period) noexcept : previous(result::set_trace_sampling(period)) {}
+        ~Sampling() {
+            result::set_trace_sampling(previous);
+        }
+    };
+}
+
+TEST_CASE("Result of untraced error is not affected by tracing", "[trace]") {
+    static_assert(sizeof(result::Result<int, int>) == 2 * sizeof(int));
+    static_assert(sizeof(result::Result<int*, void>) == 2 * sizeof(int*));
+    static_assert(std::is_trivially_copyable<result::Result<int, int>>::value);
+    static_assert(!result::internal::is_located_error<std::error_code, std::error_code>);
+    static_assert(result::internal::is_located_error<Error, ParseError>);
+}
+
+TEST_CASE("Traced records location of creation", "[trace]") {
+    auto from_err = parse(-1);
+    REQUIRE(from_err.is_err());
+    REQUIRE(from_err.error()->error().pos == -1);
+    REQUIRE(in_this_file(from_err.error()->origin()));
+    REQUIRE(from_err.error()->origin().line() == parse_line);
+    REQUIRE(from_err.error()->trail().empty());
+    REQUIRE(from_err.error()->backtrace() == nullptr);
+
+    const unsigned line = __LINE__ + 1;
+    auto from_factory = Parsed::error(ParseError{2});
+    REQUIRE(from_factory.error()->origin().line() == line);
+    REQUIRE(in_this_file(from_factory.error()->origin()));
+}
+
+TEST_CASE("Traced collects hops of and_then and context", "[trace]") {
+    const unsigned and_then_line = __LINE__ + 2;
+    auto failed = parse(-1)
+        .and_then([](int value) {
+            return parse(value + 1);
+        })
+        .map_err(result::context("parsing header"));
+    REQUIRE(failed.is_err());
+
+    const auto trail = failed.error()->trail();
+    REQUIRE(trail.size() == 2);
+    REQUIRE(trail[0].location.line() == and_then_line);
+    REQUIRE(trail[0].note == nullptr);
+    REQUIRE(std::strcmp(trail[1].note, "parsing header") == 0);
+    REQUIRE(in_this_file(trail[1].location));
+    REQUIRE(failed.error()->dropped_hops() == 0);
+
+    auto overflow = std::move(failed).map_err(result::context("one more")).map_err(result::context("and another"));
+    REQUIRE(overflow.error()->trail().size() == 2);
+    REQUIRE(overflow.error()->dropped_hops() == 2);
+
+    const std::string text = overflow.error()->describe();
+    REQUIRE(text.find("created at") == 0);
+    REQUIRE(text.find("parsing header") != std::string::npos);
+    REQUIRE(text.find("and 2 more") != std::string::npos);
+    REQUIRE(text.find("stack trace") == std::string::npos);
+}
+
+TEST_CASE("Traced ok path doesn't add hops", "[trace]") {
+    auto ok = parse(1).and_then([](int value) {
+        return parse(value + 1);
+    }).map_err(result::context("unused"));
+    REQUIRE(ok.unwrap() == 2);
+}
+
+TEST_CASE("Traced captures stack trace when sampled", "[trace]") {
+    {
+        const Sampling sampling(0);
+        REQUIRE(parse(-1).error()->backtrace() == nullptr);
+    }
+
+    const Sampling sampling(2);
+    unsigned captured = 0;
+    for (int idx = 0; idx < 10; idx++) {
+        auto failed = parse(-1);
+        if (const result::stack_trace* trace = failed.error()->backtrace()) {
+            captured++;
+#ifdef RESULT_HAS_STACK_TRACE
+            REQUIRE(!trace->empty());
+            REQUIRE(failed.error()->describe().find("stack trace") != std::string::npos);
+#else
+            REQUIRE(trace->empty());
+#endif
+        }
+    }
+    REQUIRE(captured == 5);
+}
+
+TEST_CASE("Traced captures stack trace on failed unwrap", "[trace]") {
+    auto failed = parse(-1);
+    REQUIRE(failed.error()->backtrace() == nullptr);
+
+    try {
+        failed.unwrap();
+        FAIL("unwrap must throw");
+    } catch (const Error& error) {
+        REQUIRE(error.error().pos == -1);
+        REQUIRE(error.backtrace() != nullptr);
+    }
+    REQUIRE(failed.error()->backtrace() != nullptr);
+}
@@ -0,0 +1,169 @@
+#include <catch.hpp>
+
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <result_validation.hpp>
+
+#include "counting.hpp"
+
+namespace {
+    struct FieldError {
+        std::string field;
+        int code;
+
+        bool operator==(const FieldError& right) const {
+            return field == right.field && code == right.code;
+        }
+    };
+
+    typedef result::Result<int, FieldError> Field;
+
+    Field parse_field(const char* name, int value) {
+        if (value < 0) {
+            return Field::error(FieldError{name, value});
+        }
+        return Field::ok(value);
+    }
+
+    struct Range {
+        int low;
+        int high;
+    };
+}
+
+TEST_CASE("SmallVec spills to heap only beyond inline capacity", "[validation]") {
+    result::SmallVec<std::string, 2> names;
+    REQUIRE(names.empty());
+    REQUIRE(names.capacity() == 2);
+
+    names.push_back("first");
+    names.emplace_back("second");
+    REQUIRE(names.is_inline());
+
+    //Element of itself stays valid while it grows.
+    names.push_back(names[0]);
+    REQUIRE_FALSE(names.is_inline());
+    REQUIRE(names.size() == 3);
+    REQUIRE(names.capacity() == 4);
+    REQUIRE(names.back() == "first");
+
+    const result::SmallVec<std::string, 2> copy = names;
+    REQUIRE(copy == names);
+
+    const std::string* heap = names.data();
+    result::SmallVec<std::string, 2> moved = std::move(names);
+    REQUIRE(moved.data() == heap);
+    REQUIRE(names.empty());
+    REQUIRE(names.is_inline());
+
+    result::SmallVec<std::string, 2> small;
+    small.push_back("only");
+    moved = std::move(small);
+    REQUIRE(moved.is_inline());
+    REQUIRE(moved.size() == 1);
+    REQUIRE(moved.front() == "only");
+    REQUIRE(moved != copy);
+
+    result::SmallVec<std::unique_ptr<int>, 1> owners;
+    owners.push_back(std::make_unique<int>(1));
+    owners.push_back(std::make_unique<int>(2));
+    owners.pop_back();
+    REQUIRE(*owners.front() == 1);
+}
+
+TEST_CASE("combine collects errors of all failed inputs in order", "[validation]") {
+    const auto make_range = [](int low, int high) {
+        return Range{low, high};
+    };
+
+    const auto valid = result::combine(make_range, parse_field("low", 1), parse_field("high", 5));
+    static_assert(std::is_same<std::decay_t<decltype(valid)>, result::Validation<Range, FieldError>>::value, "Validation of value returned by fn");
+    REQUIRE(valid.is_ok());
+    REQUIRE(valid.value()->high == 5);
+    REQUIRE(valid.errors() == nullptr);
+
+    const auto invalid = result::combine(make_range, parse_field("low", -1), parse_field("high", -2));
+    REQUIRE(invalid.is_err());
+    REQUIRE(invalid.error_count() == 2);
+    REQUIRE((*invalid.errors())[0] == FieldError{"low", -1});
+    REQUIRE((*invalid.errors())[1] == FieldError{"high", -2});
+
+    //Validations are merged with single errors, while void checks contribute only errors.
+    const result::Validation<Range, FieldError> nested = invalid;
+    const result::Result<void, FieldError> passed = result::Result<void, FieldError>::ok();
+    const result::Result<void, FieldError> failed = result::Result<void, FieldError>::error(FieldError{"order", 0});
+    const auto merged = result::zip(nested, passed, parse_field("step", -3), failed);
+    static_assert(std::is_same<std::decay_t<decltype(merged)>, result::Validation<std::tuple<Range, int>, FieldError>>::value, "void values are not zipped");
+    REQUIRE(merged.error_count() == 4);
+    REQUIRE(merged.errors()->back().field == "order");
+
+    const auto zipped = result::zip(parse_field("low", 1), passed, parse_field("high", 2));
+    REQUIRE(*zipped.value() == std::make_tuple(1, 2));
+}
+
+TEST_CASE("Validator accumulates errors of many checks", "[validation]") {
+    result::Validator<FieldError, 2> validator;
+    int sum = 0;
+    for (int idx = 0; idx < 5; idx++) {
+        const Field field = parse_field("field", idx % 2 == 0 ? idx : -idx);
+        if (validator.check(field)) {
+            sum += *field.value();
+        }
+    }
+    REQUIRE(sum == 6);
+    REQUIRE(validator.check(sum > 10, FieldError{"sum", sum}) == false);
+    REQUIRE(validator.check(result::Validation<void, FieldError, 2>::error(FieldError{"nested", 1})) == false);
+    REQUIRE(validator.errors().size() == 4);
+
+    const auto nested = result::Validation<void, FieldError, 2>::error(FieldError{"kept", 2});
+    result::Validator<FieldError, 2> copying;
+    REQUIRE_FALSE(copying.check(nested));
+    REQUIRE(copying.errors()[0] == FieldError{"kept", 2});
+    REQUIRE(nested.errors()->front() == FieldError{"kept", 2});
+
+    result::Validation<int, FieldError, 2> total = std::move(validator).finish([&]() {
+        return sum;
+    });
+    REQUIRE(total.is_err());
+
+    result::Result<int, result::SmallVec<FieldError, 2>> converted = std::move(total).into_result();
+    REQUIRE(converted.error()->size() == 4);
+    REQUIRE((*converted.error())[2] == FieldError{"sum", 6});
+
+    result::Validator<FieldError, 2> clean;
+    REQUIRE(clean.check(parse_field("field", 1)));
+    REQUIRE(std::move(clean).finish().is_ok());
+}
+
+TEST_CASE("Validation allocates only beyond inline errors", "[validation]") {
+    typedef result::Result<int, int> Check;
+    const auto sum = [](int first, int second, int third) {
+        return first + second + third;
+    };
+
+#ifdef RESULT_TELEMETRY
+    //Telemetry allocates table of thread on the first error.
+    static_cast<void>(Check::error(0));
+#endif
+    counting::Meter meter;
+    const auto inline_errors = result::combine(sum, Check::error(1), Check::error(2), Check::ok(3));
+    REQUIRE(inline_errors.error_count() == 2);
+    REQUIRE(meter.allocations() == 0);
+
+    const auto mapped = inline_errors.map([](int value) {
+        return value * 2;
+    });
+    REQUIRE(mapped.error_count() == 2);
+    REQUIRE(meter.allocations() == 0);
+
+    result::Validator<int, 2> validator;
+    for (int idx = 0; idx < 3; idx++) {
+        validator.check(Check::error(idx));
+    }
+    REQUIRE(meter.allocations() == 1);
+    REQUIRE_FALSE(validator.errors().is_inline());
+}
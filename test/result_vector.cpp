@@ -0,0 +1,167 @@
+#include <catch.hpp>
+
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <cstddef>
+
+#include <result_vector.hpp>
+
+typedef result::Result<int, std::string> Row;
+
+TEST_CASE("try result vector") {
+    result::ResultVector<int, std::string> rows;
+
+    REQUIRE(rows.empty());
+    REQUIRE(rows.all_ok());
+    REQUIRE(rows.first_err() == 0);
+
+    for (int idx = 0; idx < 200; idx++) {
+        if (idx % 7 == 3) {
+            rows.push_back(Row::error(std::to_string(idx)));
+        } else {
+            rows.push_back(Row::ok(idx));
+        }
+    }
+
+    REQUIRE(rows.size() == 200);
+    REQUIRE(!rows.all_ok());
+    REQUIRE(rows.count_err() == 29);
+    REQUIRE(rows.count_ok() == 171);
+    REQUIRE(rows.first_err() == 3);
+
+    for (std::size_t idx = 0; idx < rows.size(); idx++) {
+        const auto row = rows[idx];
+        REQUIRE(row.index() == idx);
+        if (idx % 7 == 3) {
+            REQUIRE(row.is_err());
+            REQUIRE(row.value() == nullptr);
+            REQUIRE(row.unwrap_err() == std::to_string(idx));
+            REQUIRE_THROWS_AS(row.unwrap(), std::string);
+            REQUIRE(row.unwrap_or(-1) == -1);
+        } else {
+            REQUIRE(row.is_ok());
+            REQUIRE(row.error() == nullptr);
+            REQUIRE(row.unwrap() == static_cast<int>(idx));
+        }
+    }
+
+    std::size_t oks = 0;
+    for (auto [idx, value] : rows.oks()) {
+        REQUIRE(idx % 7 != 3);
+        REQUIRE(value == static_cast<int>(idx));
+        value += 1;
+        oks++;
+    }
+    REQUIRE(oks == rows.count_ok());
+    REQUIRE(rows[198].unwrap() == 199);
+
+    std::size_t errs = 0;
+    for (auto [idx, error] : rows.errs()) {
+        REQUIRE(idx % 7 == 3);
+        REQUIRE(error == std::to_string(idx));
+        errs++;
+    }
+    REQUIRE(errs == rows.count_err());
+
+    std::size_t values = 0;
+    for (int value : rows.ok_values()) {
+        REQUIRE(value % 7 != 4);
+        values++;
+    }
+    REQUIRE(values == rows.count_ok());
+    REQUIRE(*rows.err_values().begin() == "3");
+
+    std::size_t all = 0;
+    for (auto row : rows) {
+        REQUIRE(row.index() == all++);
+    }
+    REQUIRE(all == rows.size());
+}
+
+TEST_CASE("try result vector conversion") {
+    std::vector<Row> source;
+    source.push_back(Row::ok(1));
+    source.push_back(Row::error("fail"));
+
+    const result::ResultVector<int, std::string> rows(source.begin(), source.end());
+
+    Row ok = rows[0];
+    Row err = rows[1];
+    REQUIRE(ok.unwrap() == 1);
+    REQUIRE(err.unwrap_err() == "fail");
+
+    const auto mapped = static_cast<Row>(rows[0]).map([](int value) {
+        return value * 2;
+    });
+    REQUIRE(mapped.unwrap() == 2);
+}
+
+TEST_CASE("try result vector pop") {
+    result::ResultVector<int, int> rows;
+    for (int idx = 0; idx < 65; idx++) {
+        rows.emplace_ok(idx);
+    }
+    rows.emplace_err(65);
+
+    REQUIRE(rows.first_err() == 65);
+    rows.pop_back();
+    REQUIRE(rows.all_ok());
+    REQUIRE(rows.first_err() == 65);
+    rows.pop_back();
+    REQUIRE(rows.size() == 64);
+    REQUIRE(rows.errs().begin() == rows.errs().end());
+
+    rows.emplace_err(64);
+    REQUIRE(rows.first_err() == 64);
+    REQUIRE(rows[64].unwrap_err() == 64);
+    REQUIRE(rows[63].unwrap() == 63);
+
+    rows.clear();
+    REQUIRE(rows.empty());
+    REQUIRE(rows.oks().begin() == rows.oks().end());
+}
+
+TEST_CASE("try result vector void") {
+    result::ResultVector<void, int> rows{result::Result<void, int>::ok(), result::Result<void, int>::error(2)};
+
+    REQUIRE(rows.count_ok() == 1);
+    REQUIRE(rows.first_err() == 1);
+    rows[0].unwrap();
+    REQUIRE(rows[1].unwrap_err() == 2);
+
+    result::Result<void, int> err = rows[1];
+    REQUIRE(err.is_err());
+}
+
+TEST_CASE("try result vector reference") {
+    std::string first = "first";
+    std::string second = "second";
+
+    result::ResultVector<std::string&, int> rows;
+    rows.push_back(result::Result<std::string&, int>::ok(first));
+    rows.push_back(result::Result<std::string&, int>::error(1));
+    rows.emplace_ok(second);
+
+    static_assert(std::is_same<decltype(rows[0].unwrap()), std::string&>::value, "unwrap yields referent");
+    static_assert(std::is_same<decltype(rows[0].value()), std::string*>::value, "value points to referent");
+
+    const auto& view = rows;
+    static_assert(std::is_same<decltype(view[0].unwrap()), std::string&>::value, "const view yields referent");
+    REQUIRE(view[0].value() == &first);
+    REQUIRE(view[1].value() == nullptr);
+
+    rows[0].unwrap() += "!";
+    REQUIRE(first == "first!");
+    REQUIRE(&rows[2].unwrap() == &second);
+
+    std::vector<std::string*> seen;
+    for (auto [idx, value] : rows.oks()) {
+        static_assert(std::is_same<decltype(value), std::string&>::value, "row yields referent");
+        seen.push_back(&value);
+    }
+    REQUIRE(seen == std::vector<std::string*>{&first, &second});
+
+    result::Result<std::string&, int> copied = rows[2];
+    REQUIRE(&copied.unwrap() == &second);
+}
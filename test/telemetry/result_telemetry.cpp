@@ -0,0 +1,140 @@
+//Tests of error telemetry, built together with all other tests with RESULT_TELEMETRY defined.
+#include <catch.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <result_algorithm.hpp>
+
+#ifndef RESULT_TELEMETRY
+#error "RESULT_TELEMETRY must be defined for telemetry tests"
+#endif
+
+namespace {
+    struct ParseError {
+        int pos;
+    };
+
+    //Sum of counters for type and event, optionally at given line of this file.
+    std::uint64_t count(std::string_view type, result::error_event event, unsigned line = 0) {
+        std::uint64_t total = 0;
+        for (const result::error_site& site : result::error_telemetry_snapshot()) {
+            if (site.event == event && site.type.find(type) != std::string_view::npos && (line == 0 || (site.line == line && std::strstr(site.file, "result_telemetry.cpp") != nullptr))) {
+                total += site.count;
+            }
+        }
+        return total;
+    }
+
+    result::Result<int, ParseError> parse(int value) {
+        if (value < 0) {
+            return result::Err(ParseError{value});
+        }
+        return result::Ok(value);
+    }
+}
+
+TEST_CASE("Telemetry counts created errors per call site", "[telemetry]") {
+    const std::uint64_t before = count("ParseError", result::error_event::created);
+
+    const unsigned line = __LINE__ + 2;
+    for (int idx = 0; idx < 3; idx++) {
+        auto res = result::Result<int, ParseError>::error(ParseError{idx});
+        REQUIRE(res.is_err());
+    }
+
+    REQUIRE(count("ParseError", result::error_event::created, line) == 3);
+    REQUIRE(count("ParseError", result::error_event::created) == before + 3);
+
+    for (const result::error_site& site : result::error_telemetry_snapshot()) {
+        if (site.line == line && site.type.find("ParseError") != std::string_view::npos) {
+            REQUIRE(std::strstr(site.file, "result_telemetry.cpp") != nullptr);
+            REQUIRE(std::strlen(site.function) != 0);
+        }
+    }
+}
+
+TEST_CASE("Telemetry counts conversion from Err and void errors", "[telemetry]") {
+    const std::uint64_t parse_before = count("ParseError", result::error_event::created);
+    const std::uint64_t void_before = count("void", result::error_event::created);
+
+    REQUIRE(parse(-1).is_err());
+    REQUIRE(parse(1).is_ok());
+    auto io = result::Result<int, void>::error();
+    REQUIRE(io.is_err());
+
+    REQUIRE(count("ParseError", result::error_event::created) == parse_before + 1);
+    REQUIRE(count("void", result::error_event::created) == void_before + 1);
+}
+
+TEST_CASE("Telemetry doesn't count propagated errors", "[telemetry]") {
+    auto failed = parse(-5);
+    const std::uint64_t before = count("ParseError", result::error_event::created);
+
+    auto mapped = std::move(failed).map([](int value) {
+        return value * 2;
+    }).and_then([](int value) {
+        return parse(value);
+    });
+    REQUIRE(mapped.is_err());
+
+    std::vector<result::Result<int, ParseError>> rows;
+    rows.push_back(result::Result<int, ParseError>::ok(1));
+    rows.push_back(std::move(mapped));
+    const std::uint64_t collected_before = count("ParseError", result::error_event::created);
+    REQUIRE(result::collect(std::move(rows)).is_err());
+
+    REQUIRE(collected_before == before);
+    REQUIRE(count("ParseError", result::error_event::created) == before);
+}
+
+TEST_CASE("Telemetry counts failed unwraps", "[telemetry]") {
+    const std::uint64_t unwrap_before = count("ParseError", result::error_event::unwrap_failed);
+    const std::uint64_t unwrap_err_before = count("ParseError", result::error_event::unwrap_err_failed);
+
+    auto failed = parse(-1);
+    const auto& view = failed;
+    REQUIRE_THROWS(failed.unwrap());
+    REQUIRE_THROWS(view.unwrap());
+    REQUIRE_THROWS(std::move(failed).unwrap());
+    REQUIRE(failed.unwrap_err().pos == -1);
+
+    auto ok = parse(1);
+    REQUIRE(ok.unwrap() == 1);
+    REQUIRE_THROWS(ok.unwrap_err());
+
+    REQUIRE(count("ParseError", result::error_event::unwrap_failed) == unwrap_before + 3);
+    REQUIRE(count("ParseError", result::error_event::unwrap_err_failed) == unwrap_err_before + 1);
+}
+
+TEST_CASE("Telemetry merges counters of threads", "[telemetry]") {
+    const unsigned line = __LINE__ + 4;
+    const auto fail_many = [] {
+        for (int idx = 0; idx < 1000; idx++) {
+            //Each thread records the same site.
+            auto res = result::Result<int, ParseError>::error(ParseError{idx});
+            static_cast<void>(res);
+        }
+    };
+
+    std::thread first(fail_many);
+    std::thread second(fail_many);
+    first.join();
+    second.join();
+    //Tables of exited threads are reused.
+    std::thread third(fail_many);
+    third.join();
+
+    unsigned sites = 0;
+    for (const result::error_site& site : result::error_telemetry_snapshot()) {
+        if (site.line == line && std::strstr(site.file, "result_telemetry.cpp") != nullptr) {
+            sites++;
+            REQUIRE(site.count == 3000);
+        }
+    }
+    REQUIRE(sites == 1);
+    REQUIRE(result::error_telemetry_dropped() == 0);
+}